@@ -208,6 +208,12 @@ extern struct _LogParser *last_parser;
 %token KW_THROTTLE                    10170
 %token KW_THREADED                    10171
 
+/* disk buffer options */
+%token KW_DISK_BUFFER                 10180
+%token KW_DISK_BUF_SIZE               10181
+%token KW_RELIABLE                    10182
+%token KW_DISK_BUF_DIR                10183
+
 /* log statement options */
 %token KW_FLAGS                       10190
 
@@ -260,6 +266,7 @@ extern struct _LogParser *last_parser;
 %token KW_MESSAGE                     10354
 %token KW_NETMASK                     10355
 %token KW_TAGS                        10356
+%token KW_NETMASK_SET                 10357
 
 /* parser items */
 
@@ -973,6 +980,7 @@ dest_driver_option
 
 	: KW_LOG_FIFO_SIZE '(' LL_NUMBER ')'	{ ((LogDestDriver *) last_driver)->log_fifo_size = $3; }
 	| KW_THROTTLE '(' LL_NUMBER ')'         { ((LogDestDriver *) last_driver)->throttle = $3; }
+	| KW_DISK_BUFFER '(' dest_disk_buffer_options ')'
         | LL_IDENTIFIER
           {
             Plugin *p;
@@ -993,6 +1001,17 @@ dest_driver_option
           }
         ;
 
+dest_disk_buffer_options
+	: dest_disk_buffer_option dest_disk_buffer_options
+	|
+	;
+
+dest_disk_buffer_option
+	: KW_DISK_BUF_SIZE '(' LL_NUMBER ')'	{ ((LogDestDriver *) last_driver)->disk_options.disk_buf_size = $3; }
+	| KW_RELIABLE '(' yesno ')'		{ ((LogDestDriver *) last_driver)->disk_options.reliable = $3; }
+	| KW_DISK_BUF_DIR '(' string ')'	{ log_queue_disk_options_set_dir(&((LogDestDriver *) last_driver)->disk_options, $3); free($3); }
+	;
+
 dest_writer_options
 	: dest_writer_option dest_writer_options
 	|
@@ -119,6 +119,10 @@ static CfgLexerKeyword main_keywords[] = {
   { "program_override",   KW_PROGRAM_OVERRIDE, 0x0300 },
   { "host_override",      KW_HOST_OVERRIDE, 0x0300 },
   { "throttle",           KW_THROTTLE },
+  { "disk_buffer",        KW_DISK_BUFFER, 0x0304 },
+  { "disk_buf_size",      KW_DISK_BUF_SIZE, 0x0304 },
+  { "reliable",           KW_RELIABLE, 0x0304 },
+  { "disk_buf_dir",       KW_DISK_BUF_DIR, 0x0304 },
 
   { "create_dirs",        KW_CREATE_DIRS },
   { "optional",           KW_OPTIONAL },
@@ -1018,6 +1018,31 @@ cfg_tree_check_inline_template(CfgTree *self, const gchar *template_or_name, GEr
   return template;
 }
 
+/*
+ * Returns the matcher set collecting the literals of filters matching
+ * value_handle.  Patterns can be added to it until cfg_tree_start()
+ * has initialized all pipes, at which point it is compiled.
+ */
+LogMatcherSet *
+cfg_tree_get_matcher_set(CfgTree *self, NVHandle value_handle)
+{
+  LogMatcherSet *set;
+
+  set = g_hash_table_lookup(self->matcher_sets, GUINT_TO_POINTER(value_handle));
+  if (!set)
+    {
+      set = log_matcher_set_new();
+      g_hash_table_insert(self->matcher_sets, GUINT_TO_POINTER(value_handle), set);
+    }
+  return log_matcher_set_ref(set);
+}
+
+static void
+cfg_tree_compile_matcher_set(gpointer key, gpointer value, gpointer user_data)
+{
+  log_matcher_set_compile((LogMatcherSet *) value);
+}
+
 gboolean
 cfg_tree_compile(CfgTree *self)
 {
@@ -1068,6 +1093,9 @@ cfg_tree_start(CfgTree *self)
           return FALSE;
         }
     }
+
+  /* filters have registered their patterns during init */
+  g_hash_table_foreach(self->matcher_sets, cfg_tree_compile_matcher_set, NULL);
   return TRUE;
 }
 
@@ -1092,6 +1120,7 @@ cfg_tree_init_instance(CfgTree *self, GlobalConfig *cfg)
   self->initialized_pipes = g_ptr_array_new();
   self->objects = g_hash_table_new_full(cfg_tree_objects_hash, cfg_tree_objects_equal, NULL, (GDestroyNotify) log_expr_node_free);
   self->templates = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, (GDestroyNotify) log_template_unref);
+  self->matcher_sets = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) log_matcher_set_unref);
   self->rules = g_ptr_array_new();
   self->cfg = cfg;
 }
@@ -1107,5 +1136,6 @@ cfg_tree_free_instance(CfgTree *self)
 
   g_hash_table_destroy(self->objects);
   g_hash_table_destroy(self->templates);
+  g_hash_table_destroy(self->matcher_sets);
   self->cfg = NULL;
 }
@@ -27,6 +27,8 @@
 
 #include "syslog-ng.h"
 #include "templates.h"
+#include "logmatcher-set.h"
+#include "nvtable.h"
 #include "cfg-lexer.h"
 
 const gchar *log_expr_node_get_content_name(gint content);
@@ -155,6 +157,8 @@ typedef struct _CfgTree
   /* list of top-level rules */
   GPtrArray *rules;
   GHashTable *templates;
+  /* LogMatcherSet instances shared by filters, indexed by value handle */
+  GHashTable *matcher_sets;
 } CfgTree;
 
 gboolean cfg_tree_add_object(CfgTree *self, LogExprNode *rule);
@@ -164,6 +168,8 @@ gboolean cfg_tree_add_template(CfgTree *self, LogTemplate *template);
 LogTemplate *cfg_tree_lookup_template(CfgTree *self, const gchar *name);
 LogTemplate *cfg_tree_check_inline_template(CfgTree *self, const gchar *template_or_name, GError **error);
 
+LogMatcherSet *cfg_tree_get_matcher_set(CfgTree *self, NVHandle value_handle);
+
 gchar *cfg_tree_get_rule_name(CfgTree *self, gint content, LogExprNode *node);
 gchar *cfg_tree_get_child_id(CfgTree *self, gint content, LogExprNode *node);
 
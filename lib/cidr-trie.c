@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2002-2013 BalaBit IT Ltd, Budapest, Hungary
+ * Copyright (c) 1998-2013 Balázs Scheidler
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * As an additional exemption you are allowed to compile & link against the
+ * OpenSSL libraries as published by the OpenSSL project. See the file
+ * COPYING for details.
+ *
+ */
+
+#include "cidr-trie.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#define CIDR_TRIE_MAX_BYTES 16
+
+typedef struct _CIDRTrieNode CIDRTrieNode;
+struct _CIDRTrieNode
+{
+  CIDRTrieNode *child[2];
+  /* the first prefix_len bits of key are significant, the rest are zero */
+  guint8 key[CIDR_TRIE_MAX_BYTES];
+  guint8 prefix_len;
+  /* a network of the set ends here, internal nodes only branch */
+  gboolean terminal;
+};
+
+struct _CIDRTrie
+{
+  CIDRTrieNode *ipv4;
+  CIDRTrieNode *ipv6;
+};
+
+static inline gint
+cidr_trie_bit(const guint8 *key, gint bit)
+{
+  return (key[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+/* returns the number of leading bits a and b have in common, at most max_len */
+static gint
+cidr_trie_common_prefix(const guint8 *a, const guint8 *b, gint max_len)
+{
+  gint i, len = 0;
+
+  for (i = 0; len < max_len; i++, len += 8)
+    {
+      guint8 diff = a[i] ^ b[i];
+
+      if (diff)
+        {
+          while (!(diff & 0x80))
+            {
+              diff <<= 1;
+              len++;
+            }
+          break;
+        }
+    }
+  return MIN(len, max_len);
+}
+
+static gboolean
+cidr_trie_prefix_matches(const guint8 *key, const guint8 *address, gint prefix_len)
+{
+  gint bytes = prefix_len >> 3;
+  gint bits = prefix_len & 7;
+
+  if (memcmp(key, address, bytes) != 0)
+    return FALSE;
+  if (bits && ((key[bytes] ^ address[bytes]) & (0xFF << (8 - bits))))
+    return FALSE;
+  return TRUE;
+}
+
+static CIDRTrieNode *
+cidr_trie_node_new(const guint8 *key, gint prefix_len, gboolean terminal)
+{
+  CIDRTrieNode *node = g_new0(CIDRTrieNode, 1);
+  gint bytes = (prefix_len + 7) >> 3;
+
+  memcpy(node->key, key, bytes);
+  if (prefix_len & 7)
+    node->key[bytes - 1] &= 0xFF << (8 - (prefix_len & 7));
+  node->prefix_len = prefix_len;
+  node->terminal = terminal;
+  return node;
+}
+
+static void
+cidr_trie_node_free(CIDRTrieNode *node)
+{
+  if (!node)
+    return;
+  cidr_trie_node_free(node->child[0]);
+  cidr_trie_node_free(node->child[1]);
+  g_free(node);
+}
+
+static void
+cidr_trie_insert(CIDRTrieNode **slot, const guint8 *key, gint prefix_len)
+{
+  while (*slot)
+    {
+      CIDRTrieNode *node = *slot;
+      CIDRTrieNode *branch;
+      gint common;
+
+      common = cidr_trie_common_prefix(node->key, key, MIN(node->prefix_len, prefix_len));
+      if (common == node->prefix_len)
+        {
+          /* node is a prefix of the new network */
+          if (node->prefix_len == prefix_len || node->terminal)
+            {
+              /* already covered, membership doesn't need the more specific network */
+              node->terminal = TRUE;
+              return;
+            }
+          slot = &node->child[cidr_trie_bit(key, node->prefix_len)];
+        }
+      else if (common == prefix_len)
+        {
+          /* the new network covers node and everything below it */
+          *slot = cidr_trie_node_new(key, prefix_len, TRUE);
+          cidr_trie_node_free(node);
+          return;
+        }
+      else
+        {
+          /* the two diverge, branch at the first differing bit */
+          branch = cidr_trie_node_new(key, common, FALSE);
+          branch->child[cidr_trie_bit(node->key, common)] = node;
+          branch->child[cidr_trie_bit(key, common)] = cidr_trie_node_new(key, prefix_len, TRUE);
+          *slot = branch;
+          return;
+        }
+    }
+  *slot = cidr_trie_node_new(key, prefix_len, TRUE);
+}
+
+static gboolean
+cidr_trie_find(CIDRTrieNode *node, const guint8 *address, gint address_len)
+{
+  while (node)
+    {
+      if (!cidr_trie_prefix_matches(node->key, address, node->prefix_len))
+        return FALSE;
+      if (node->terminal)
+        return TRUE;
+      if (node->prefix_len >= address_len)
+        return FALSE;
+      node = node->child[cidr_trie_bit(address, node->prefix_len)];
+    }
+  return FALSE;
+}
+
+gboolean
+cidr_trie_add_address(CIDRTrie *self, gint family, const guint8 *address, gint prefix_len)
+{
+  if (family == AF_INET && prefix_len >= 0 && prefix_len <= 32)
+    cidr_trie_insert(&self->ipv4, address, prefix_len);
+  else if (family == AF_INET6 && prefix_len >= 0 && prefix_len <= 128)
+    cidr_trie_insert(&self->ipv6, address, prefix_len);
+  else
+    return FALSE;
+  return TRUE;
+}
+
+/* converts a dotted IPv4 netmask to a prefix length, -1 if the mask is not contiguous */
+static gint
+cidr_trie_mask_to_prefix_len(const gchar *mask)
+{
+  struct in_addr addr;
+  guint32 bits;
+  gint prefix_len = 0;
+
+  if (inet_pton(AF_INET, mask, &addr) != 1)
+    return -1;
+  bits = ntohl(addr.s_addr);
+  while (bits & 0x80000000)
+    {
+      bits <<= 1;
+      prefix_len++;
+    }
+  return bits ? -1 : prefix_len;
+}
+
+/*
+ * Adds a network specified as "address", "address/prefix_len" or, for
+ * IPv4, "address/netmask".  Returns FALSE if the network can't be parsed.
+ */
+gboolean
+cidr_trie_add(CIDRTrie *self, const gchar *cidr)
+{
+  guint8 address[CIDR_TRIE_MAX_BYTES];
+  gchar buf[64];
+  const gchar *slash;
+  gint family, prefix_len;
+  gchar *end;
+
+  slash = strchr(cidr, '/');
+  if (slash)
+    {
+      if (slash - cidr >= sizeof(buf))
+        return FALSE;
+      memcpy(buf, cidr, slash - cidr);
+      buf[slash - cidr] = 0;
+    }
+  else
+    {
+      if (strlen(cidr) >= sizeof(buf))
+        return FALSE;
+      strcpy(buf, cidr);
+    }
+
+  if (inet_pton(AF_INET, buf, address) == 1)
+    {
+      family = AF_INET;
+      prefix_len = 32;
+    }
+  else if (inet_pton(AF_INET6, buf, address) == 1)
+    {
+      family = AF_INET6;
+      prefix_len = 128;
+    }
+  else
+    return FALSE;
+
+  if (slash)
+    {
+      if (family == AF_INET && strchr(slash + 1, '.'))
+        prefix_len = cidr_trie_mask_to_prefix_len(slash + 1);
+      else
+        {
+          prefix_len = strtol(slash + 1, &end, 10);
+          if (*end || end == slash + 1)
+            return FALSE;
+        }
+    }
+  return cidr_trie_add_address(self, family, address, prefix_len);
+}
+
+/* address is in network byte order, 4 or 16 bytes depending on family */
+gboolean
+cidr_trie_lookup(CIDRTrie *self, gint family, const guint8 *address)
+{
+  static const guint8 ipv4_mapped_prefix[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF };
+
+  if (family == AF_INET)
+    return cidr_trie_find(self->ipv4, address, 32);
+  if (family == AF_INET6)
+    {
+      if (self->ipv4 && memcmp(address, ipv4_mapped_prefix, sizeof(ipv4_mapped_prefix)) == 0)
+        return cidr_trie_find(self->ipv4, address + 12, 32);
+      return cidr_trie_find(self->ipv6, address, 128);
+    }
+  return FALSE;
+}
+
+gboolean
+cidr_trie_is_empty(CIDRTrie *self)
+{
+  return !self->ipv4 && !self->ipv6;
+}
+
+CIDRTrie *
+cidr_trie_new(void)
+{
+  return g_new0(CIDRTrie, 1);
+}
+
+void
+cidr_trie_free(CIDRTrie *self)
+{
+  cidr_trie_node_free(self->ipv4);
+  cidr_trie_node_free(self->ipv6);
+  g_free(self);
+}
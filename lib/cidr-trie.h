@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2002-2013 BalaBit IT Ltd, Budapest, Hungary
+ * Copyright (c) 1998-2013 Balázs Scheidler
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * As an additional exemption you are allowed to compile & link against the
+ * OpenSSL libraries as published by the OpenSSL project. See the file
+ * COPYING for details.
+ *
+ */
+
+#ifndef CIDR_TRIE_H_INCLUDED
+#define CIDR_TRIE_H_INCLUDED
+
+#include "syslog-ng.h"
+
+/*
+ * A set of IPv4 and IPv6 networks stored in a path compressed binary
+ * trie (one for each address family).  Membership of an address is
+ * decided by walking at most as many nodes as the length of the
+ * longest prefix in the set, independently of the number of networks.
+ *
+ * IPv4-mapped IPv6 addresses are looked up among the IPv4 networks.
+ */
+typedef struct _CIDRTrie CIDRTrie;
+
+gboolean cidr_trie_add(CIDRTrie *self, const gchar *cidr);
+gboolean cidr_trie_add_address(CIDRTrie *self, gint family, const guint8 *address, gint prefix_len);
+gboolean cidr_trie_lookup(CIDRTrie *self, gint family, const guint8 *address);
+gboolean cidr_trie_is_empty(CIDRTrie *self);
+
+CIDRTrie *cidr_trie_new(void);
+void cidr_trie_free(CIDRTrie *self);
+
+#endif
@@ -24,6 +24,8 @@
   
 #include "driver.h"
 #include "logqueue-fifo.h"
+#include "logqueue-disk.h"
+#include "messages.h"
 #include "afinter.h"
 #include "cfg-tree.h"
 
@@ -198,7 +200,18 @@ log_dest_driver_acquire_queue_method(LogDestDriver *self, gchar *persist_name, g
 
   if (!queue)
     {
-      queue = log_queue_fifo_new(self->log_fifo_size < 0 ? cfg->log_fifo_size : self->log_fifo_size, persist_name);
+      /* disk buffers need a persist name, as that identifies the queue file across restarts */
+      if (self->disk_options.disk_buf_size > 0)
+        {
+          if (persist_name)
+            queue = log_queue_disk_new(&self->disk_options, persist_name, cfg->state);
+          else
+            msg_warning("WARNING: this destination doesn't support disk buffering, using an in-memory queue instead",
+                        evt_tag_str("group", self->super.group),
+                        NULL);
+        }
+      if (!queue)
+        queue = log_queue_fifo_new(self->log_fifo_size < 0 ? cfg->log_fifo_size : self->log_fifo_size, persist_name);
       log_queue_set_throttle(queue, self->throttle);
     }
   return queue;
@@ -290,6 +303,7 @@ log_dest_driver_init_instance(LogDestDriver *self)
   self->release_queue = log_dest_driver_release_queue_method;
   self->log_fifo_size = -1;
   self->throttle = 0;
+  log_queue_disk_options_defaults(&self->disk_options);
 }
 
 void
@@ -303,5 +317,6 @@ log_dest_driver_free(LogPipe *s)
       log_queue_unref((LogQueue *) l->data);
     }
   g_list_free(self->queues);
+  log_queue_disk_options_destroy(&self->disk_options);
   log_driver_free(s);
 }
@@ -28,6 +28,7 @@
 #include "syslog-ng.h"
 #include "logpipe.h"
 #include "logqueue.h"
+#include "logqueue-disk.h"
 #include "cfg.h"
 
 /*
@@ -160,6 +161,7 @@ struct _LogDestDriver
 
   gint log_fifo_size;
   gint throttle;
+  LogQueueDiskOptions disk_options;
   StatsCounterItem *queued_global_messages;
 };
 
@@ -54,6 +54,8 @@ static CfgLexerKeyword filter_expr_keywords[] = {
   { "message",            KW_MESSAGE },
   { "match",		  KW_MATCH },
   { "netmask",		  KW_NETMASK },
+  { "netmask_set",        KW_NETMASK_SET, 0x0304 },
+  { "file",               KW_FILE, 0x0304 },
   { "tags",		  KW_TAGS, 0x0301 },
 
   { "type",               KW_TYPE, 0x0300 },
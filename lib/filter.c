@@ -30,11 +30,14 @@
 #include "misc.h"
 #include "tags.h"
 #include "cfg-tree.h"
+#include "cidr-trie.h"
 #include "filter-expr-grammar.h"
 
 #include <regex.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
 
 /****************************************************************
  * Filter expression nodes
@@ -58,6 +61,13 @@ filter_expr_eval_with_context(FilterExprNode *self, LogMessage **msg, gint num_m
   gboolean res;
 
   res = self->eval(self, msg, num_msg);
+  if (G_UNLIKELY(debug_flag))
+    {
+      /* counters to validate the cost estimates of filter_expr_optimize() */
+      g_atomic_int_inc(&self->eval_count);
+      if (res)
+        g_atomic_int_inc(&self->match_count);
+    }
   msg_debug("Filter node evaluation result",
             evt_tag_str("result", res ? "match" : "not-match"),
             evt_tag_str("type", self->type),
@@ -372,6 +382,12 @@ filter_re_eval_string(FilterExprNode *s, LogMessage *msg, gint value_handle, con
   if (str_len < 0)
     str_len = strlen(str);
 
+  /* the matcher can't match if its required literal is missing, the scan
+   * is shared among all filters of the same value */
+  if (self->matcher_set && value_handle == self->value_handle && log_matcher_set_is_compiled(self->matcher_set) &&
+      !log_matcher_set_has_match(log_matcher_set_scan(self->matcher_set, str, str_len), self->pattern_id))
+    return FALSE ^ self->super.comp;
+
   return log_matcher_match(self->matcher, msg, value_handle, str, str_len) ^ self->super.comp;
 }
 
@@ -390,12 +406,54 @@ filter_re_eval(FilterExprNode *s, LogMessage **msgs, gint num_msg)
 }
 
 
+static gboolean
+filter_re_is_ascii(const gchar *str)
+{
+  for (; *str; str++)
+    {
+      if (*str & 0x80)
+        return FALSE;
+    }
+  return TRUE;
+}
+
+static void
+filter_re_init(FilterExprNode *s, GlobalConfig *cfg)
+{
+  FilterRE *self = (FilterRE *) s;
+  gboolean icase;
+  gchar *literal;
+
+  /* an expression may be initialized once for every filter() reference */
+  if (self->matcher_set || !self->value_handle || !self->matcher)
+    return;
+
+  literal = log_matcher_get_required_literal(self->matcher);
+  if (!literal)
+    return;
+
+  icase = !!(self->matcher->flags & LMF_ICASE);
+  if (!icase || filter_re_is_ascii(literal))
+    {
+      self->matcher_set = cfg_tree_get_matcher_set(&cfg->tree, self->value_handle);
+      self->pattern_id = log_matcher_set_add_pattern(self->matcher_set, literal, icase);
+      if (self->pattern_id < 0)
+        {
+          log_matcher_set_unref(self->matcher_set);
+          self->matcher_set = NULL;
+        }
+    }
+  g_free(literal);
+}
+
 static void
 filter_re_free(FilterExprNode *s)
 {
   FilterRE *self = (FilterRE *) s;
   
   log_matcher_unref(self->matcher);
+  if (self->matcher_set)
+    log_matcher_set_unref(self->matcher_set);
 }
 
 void
@@ -440,8 +498,10 @@ filter_re_new(NVHandle value_handle)
 
   filter_expr_node_init(&self->super);
   self->value_handle = value_handle;
+  self->super.init = filter_re_init;
   self->super.eval = filter_re_eval;
   self->super.free_fn = filter_re_free;
+  self->super.type = "regexp";
   return &self->super;
 }
 
@@ -483,8 +543,10 @@ filter_match_new()
   FilterRE *self = g_new0(FilterRE, 1);
 
   filter_expr_node_init(&self->super);
+  self->super.init = filter_re_init;
   self->super.free_fn = filter_re_free;
   self->super.eval = filter_match_eval;
+  self->super.type = "match";
   return &self->super;
 }
 
@@ -525,10 +587,15 @@ filter_call_init(FilterExprNode *s, GlobalConfig *cfg)
       /* this is quite fragile and would break whenever the parsing code in
        * cfg-grammar.y changes to parse a filter rule.  We assume that a
        * filter rule has a single child, which contains a LogFilterPipe
-       * instance as its object. */
-
-
-      self->filter_expr = ((LogFilterPipe *) rule->children->object)->expr;
+       * instance as its object.
+       *
+       * The expression is referenced as the rule's own init may replace
+       * (and unref) its root while optimizing it, and negated calls are
+       * never inlined, so they keep using the original tree. */
+
+      if (self->filter_expr)
+        filter_expr_unref(self->filter_expr);
+      self->filter_expr = filter_expr_ref(((LogFilterPipe *) rule->children->object)->expr);
       self->super.modify = self->filter_expr->modify;
     }
   else
@@ -544,6 +611,8 @@ filter_call_free(FilterExprNode *s)
 {
   FilterCall *self = (FilterCall *) s;
   
+  if (self->filter_expr)
+    filter_expr_unref(self->filter_expr);
   g_free((gchar *) self->super.type);
   g_free(self->rule);
 }
@@ -597,10 +666,20 @@ filter_netmask_eval(FilterExprNode *s, LogMessage **msgs, gint num_msg)
 FilterExprNode *
 filter_netmask_new(gchar *cidr)
 {
-  FilterNetmask *self = g_new0(FilterNetmask, 1);
+  FilterNetmask *self;
   gchar buf[32];
   gchar *slash;
-  
+
+  if (strchr(cidr, ':'))
+    {
+      /* IPv6 networks are only supported by the trie based implementation */
+      FilterExprNode *set = filter_netmask_set_new();
+
+      filter_netmask_set_add(set, cidr);
+      return set;
+    }
+
+  self = g_new0(FilterNetmask, 1);
   filter_expr_node_init(&self->super);
   slash = strchr(cidr, '/');
   if (strlen(cidr) >= sizeof(buf) || !slash)
@@ -628,6 +707,122 @@ filter_netmask_new(gchar *cidr)
     }
   self->address.s_addr &= self->netmask.s_addr;
   self->super.eval = filter_netmask_eval;
+  self->super.type = "netmask";
+  return &self->super;
+}
+
+typedef struct _FilterNetmaskSet
+{
+  FilterExprNode super;
+  CIDRTrie *networks;
+} FilterNetmaskSet;
+
+static gboolean
+filter_netmask_set_eval(FilterExprNode *s, LogMessage **msgs, gint num_msg)
+{
+  FilterNetmaskSet *self = (FilterNetmaskSet *) s;
+  LogMessage *msg = msgs[0];
+  struct in_addr addr;
+
+  if (msg->saddr && g_sockaddr_inet_check(msg->saddr))
+    {
+      addr = ((struct sockaddr_in *) &msg->saddr->sa)->sin_addr;
+    }
+#if ENABLE_IPV6
+  else if (msg->saddr && g_sockaddr_inet6_check(msg->saddr))
+    {
+      return cidr_trie_lookup(self->networks, AF_INET6, (guint8 *) g_sockaddr_inet6_get_address(msg->saddr)) ^ s->comp;
+    }
+#endif
+  else if (!msg->saddr || msg->saddr->sa.sa_family == AF_UNIX)
+    {
+      addr.s_addr = htonl(INADDR_LOOPBACK);
+    }
+  else
+    {
+      /* no address information, return FALSE */
+      return s->comp;
+    }
+  return cidr_trie_lookup(self->networks, AF_INET, (guint8 *) &addr) ^ s->comp;
+}
+
+gboolean
+filter_netmask_set_add(FilterExprNode *s, const gchar *cidr)
+{
+  FilterNetmaskSet *self = (FilterNetmaskSet *) s;
+
+  if (!cidr_trie_add(self->networks, cidr))
+    {
+      msg_error("Error parsing network in netmask-set() filter",
+                evt_tag_str("network", cidr),
+                NULL);
+      return FALSE;
+    }
+  return TRUE;
+}
+
+/*
+ * Adds the networks listed in a file, one per line.  Empty lines and
+ * lines starting with '#' are ignored.  The file is read again whenever
+ * the configuration is reloaded.
+ */
+gboolean
+filter_netmask_set_load(FilterExprNode *s, const gchar *filename)
+{
+  FilterNetmaskSet *self = (FilterNetmaskSet *) s;
+  gchar line[256];
+  gint lineno = 0;
+  FILE *f;
+
+  f = fopen(filename, "r");
+  if (!f)
+    {
+      msg_error("Error opening network list of netmask-set() filter",
+                evt_tag_str("filename", filename),
+                evt_tag_errno(EVT_TAG_OSERROR, errno),
+                NULL);
+      return FALSE;
+    }
+  while (fgets(line, sizeof(line), f))
+    {
+      gchar *network = g_strstrip(line);
+
+      lineno++;
+      if (network[0] == 0 || network[0] == '#')
+        continue;
+      if (!cidr_trie_add(self->networks, network))
+        {
+          msg_error("Error parsing network in netmask-set() network list",
+                    evt_tag_str("filename", filename),
+                    evt_tag_int("line", lineno),
+                    evt_tag_str("network", network),
+                    NULL);
+          fclose(f);
+          return FALSE;
+        }
+    }
+  fclose(f);
+  return TRUE;
+}
+
+static void
+filter_netmask_set_free(FilterExprNode *s)
+{
+  FilterNetmaskSet *self = (FilterNetmaskSet *) s;
+
+  cidr_trie_free(self->networks);
+}
+
+FilterExprNode *
+filter_netmask_set_new(void)
+{
+  FilterNetmaskSet *self = g_new0(FilterNetmaskSet, 1);
+
+  filter_expr_node_init(&self->super);
+  self->networks = cidr_trie_new();
+  self->super.eval = filter_netmask_set_eval;
+  self->super.free_fn = filter_netmask_set_free;
+  self->super.type = "netmask-set";
   return &self->super;
 }
 
@@ -688,9 +883,289 @@ filter_tags_new(GList *tags)
 
   self->super.eval = filter_tags_eval;
   self->super.free_fn = filter_tags_free;
+  self->super.type = "tags";
+  return &self->super;
+}
+
+typedef struct _FilterConst
+{
+  FilterExprNode super;
+  gboolean value;
+} FilterConst;
+
+static gboolean
+filter_const_eval(FilterExprNode *s, LogMessage **msgs, gint num_msg)
+{
+  FilterConst *self = (FilterConst *) s;
+
+  return self->value ^ s->comp;
+}
+
+static FilterExprNode *
+filter_const_new(gboolean value)
+{
+  FilterConst *self = g_new0(FilterConst, 1);
+
+  filter_expr_node_init(&self->super);
+  self->super.eval = filter_const_eval;
+  self->super.type = value ? "true" : "false";
+  self->value = value;
   return &self->super;
 }
 
+/*******************************************************************
+ * Filter expression optimizer
+ *
+ * Filter expressions are evaluated as written, so an expensive regexp
+ * may run before a cheap level() check that rejects the message anyway.
+ * Once references were resolved by init(), the optimizer inlines
+ * filter() calls, folds constant subexpressions and orders the operands
+ * of and/or chains by their estimated cost, cheapest first.
+ *
+ * Subexpressions can be shared (filter() references, cloned pipes), so
+ * they are only rearranged in ways that keep their meaning.
+ *******************************************************************/
+
+static inline gboolean
+filter_expr_is_op(FilterExprNode *self)
+{
+  return self->eval == fop_and_eval || self->eval == fop_or_eval;
+}
+
+/* relative cost of evaluating a node, a facility check is 1 */
+static gint
+filter_expr_estimate_cost(FilterExprNode *self)
+{
+  if (filter_expr_is_op(self))
+    {
+      FilterOp *op = (FilterOp *) self;
+
+      return filter_expr_estimate_cost(op->left) + filter_expr_estimate_cost(op->right);
+    }
+  else if (self->eval == filter_facility_eval || self->eval == filter_level_eval)
+    return 1;
+  else if (self->eval == filter_const_eval)
+    return 0;
+  else if (self->eval == filter_netmask_eval || self->eval == filter_netmask_set_eval)
+    return 2;
+  else if (self->eval == filter_tags_eval)
+    return 1 + ((FilterTags *) self)->tags->len;
+  else if (self->eval == filter_call_eval)
+    {
+      FilterCall *call = (FilterCall *) self;
+
+      return call->filter_expr ? filter_expr_estimate_cost(call->filter_expr) + 1 : 0;
+    }
+  else if (self->eval == filter_re_eval || self->eval == filter_match_eval)
+    {
+      FilterRE *re = (FilterRE *) self;
+      gint cost;
+
+      switch (re->matcher ? re->matcher->type : LMR_POSIX_REGEXP)
+        {
+        case LMR_STRING:
+          cost = 4;
+          break;
+        case LMR_GLOB:
+          cost = 8;
+          break;
+        case LMR_PCRE_REGEXP:
+          cost = 16;
+          break;
+        default:
+          cost = 32;
+          break;
+        }
+      /* the compatibility mode of match() formats a string first */
+      if (self->eval == filter_match_eval && !re->value_handle)
+        cost += 16;
+      return cost;
+    }
+  else if (self->eval == fop_cmp_eval)
+    return 24;
+  return 16;
+}
+
+/* returns TRUE if @self evaluates to the same value for every message */
+static gboolean
+filter_expr_is_const(FilterExprNode *self, gboolean *value)
+{
+  gboolean v;
+
+  if (self->eval == filter_const_eval)
+    v = ((FilterConst *) self)->value;
+  else if (self->eval == filter_level_eval && (((FilterPri *) self)->valid & 0xFF) == 0xFF)
+    v = TRUE;
+  else if (self->eval == filter_level_eval && (((FilterPri *) self)->valid & 0xFF) == 0)
+    v = FALSE;
+  else if (self->eval == filter_facility_eval && ((FilterPri *) self)->valid == 0)
+    v = FALSE;
+  else if (self->eval == filter_tags_eval && ((FilterTags *) self)->tags->len == 0)
+    v = FALSE;
+  else
+    return FALSE;
+
+  *value = v ^ self->comp;
+  return TRUE;
+}
+
+/* collects the operands of a chain of the same operator, going through
+ * the nodes that are not shared */
+static void
+fop_collect_chain(FilterOp *self, GPtrArray *ops, GPtrArray *operands)
+{
+  FilterExprNode *children[2] = { self->left, self->right };
+  gint i;
+
+  g_ptr_array_add(ops, self);
+  for (i = 0; i < 2; i++)
+    {
+      FilterExprNode *child = children[i];
+
+      if (child->eval == self->super.eval && !child->comp && child->ref_cnt == 1)
+        fop_collect_chain((FilterOp *) child, ops, operands);
+      else
+        g_ptr_array_add(operands, child);
+    }
+}
+
+static void
+fop_reorder(FilterOp *self)
+{
+  GPtrArray *ops = g_ptr_array_new();
+  GPtrArray *operands = g_ptr_array_new();
+  gint costs[256];
+  gint i, j;
+
+  fop_collect_chain(self, ops, operands);
+  if (operands->len > G_N_ELEMENTS(costs))
+    goto exit;
+
+  for (i = 0; i < operands->len; i++)
+    {
+      FilterExprNode *operand = g_ptr_array_index(operands, i);
+
+      /* matches stored by a regexp may be used by the operands
+       * following it, keep the original order */
+      if (operand->modify)
+        goto exit;
+      costs[i] = filter_expr_estimate_cost(operand);
+    }
+
+  /* stable insertion sort, operands of the same cost keep their order */
+  for (i = 1; i < operands->len; i++)
+    {
+      FilterExprNode *operand = g_ptr_array_index(operands, i);
+      gint cost = costs[i];
+
+      for (j = i; j > 0 && costs[j - 1] > cost; j--)
+        {
+          operands->pdata[j] = operands->pdata[j - 1];
+          costs[j] = costs[j - 1];
+        }
+      operands->pdata[j] = operand;
+      costs[j] = cost;
+    }
+
+  /* rebuild the chain right-deep, so operands are evaluated in order */
+  for (i = 0; i < ops->len; i++)
+    {
+      FilterOp *op = g_ptr_array_index(ops, i);
+
+      op->left = g_ptr_array_index(operands, i);
+      if (i == ops->len - 1)
+        op->right = g_ptr_array_index(operands, i + 1);
+      else
+        op->right = g_ptr_array_index(ops, i + 1);
+      op->super.modify = FALSE;
+    }
+
+ exit:
+  g_ptr_array_free(ops, TRUE);
+  g_ptr_array_free(operands, TRUE);
+}
+
+static FilterExprNode *
+fop_optimize(FilterOp *self)
+{
+  /* for AND a FALSE operand determines the result, TRUE can be dropped, OR is the opposite */
+  gboolean absorbing = self->super.eval == fop_or_eval;
+  FilterExprNode *result = NULL;
+  gboolean value;
+
+  self->left = filter_expr_optimize(self->left);
+  self->right = filter_expr_optimize(self->right);
+
+  if ((filter_expr_is_const(self->left, &value) && value == absorbing) ||
+      (filter_expr_is_const(self->right, &value) && value == absorbing && !self->left->modify))
+    {
+      result = filter_const_new(absorbing ^ self->super.comp);
+    }
+  else if (!self->super.comp && filter_expr_is_const(self->left, &value))
+    {
+      result = filter_expr_ref(self->right);
+    }
+  else if (!self->super.comp && filter_expr_is_const(self->right, &value) && value != absorbing)
+    {
+      result = filter_expr_ref(self->left);
+    }
+
+  if (result)
+    {
+      filter_expr_unref(&self->super);
+      return result;
+    }
+
+  self->super.modify = self->left->modify || self->right->modify;
+  fop_reorder(self);
+  return &self->super;
+}
+
+/*
+ * Optimizes the filter expression @self, which must have been initialized
+ * already.  It consumes the reference to @self and returns a reference to
+ * the expression that should be evaluated instead.
+ */
+FilterExprNode *
+filter_expr_optimize(FilterExprNode *self)
+{
+  if (filter_expr_is_op(self))
+    return fop_optimize((FilterOp *) self);
+
+  if (self->eval == filter_call_eval)
+    {
+      FilterCall *call = (FilterCall *) self;
+      FilterExprNode *result;
+
+      if (!call->filter_expr || self->comp)
+        return self;
+
+      /* inline the referenced expression */
+      result = filter_expr_optimize(filter_expr_ref(call->filter_expr));
+      filter_expr_unref(self);
+      return result;
+    }
+  return self;
+}
+
+static void
+filter_expr_dump_statistics(FilterExprNode *self, const gchar *rule, gint depth)
+{
+  msg_debug("Filter node statistics",
+            evt_tag_str("rule", rule),
+            evt_tag_int("depth", depth),
+            evt_tag_str("type", self->type ? self->type : "unknown"),
+            evt_tag_int("estimated_cost", filter_expr_estimate_cost(self)),
+            evt_tag_int("evaluations", self->eval_count),
+            evt_tag_int("matches", self->match_count),
+            NULL);
+  if (filter_expr_is_op(self))
+    {
+      filter_expr_dump_statistics(((FilterOp *) self)->left, rule, depth + 1);
+      filter_expr_dump_statistics(((FilterOp *) self)->right, rule, depth + 1);
+    }
+}
+
 
 /*******************************************************************
  * LogFilterPipe
@@ -704,11 +1179,22 @@ log_filter_pipe_init(LogPipe *s)
 
   if (self->expr->init)
     self->expr->init(self->expr, log_pipe_get_config(s));
+  self->expr = filter_expr_optimize(self->expr);
   if (!self->name)
     self->name = cfg_tree_get_rule_name(&cfg->tree, ENC_FILTER, s->expr_node);
   return TRUE;
 }
 
+static gboolean
+log_filter_pipe_deinit(LogPipe *s)
+{
+  LogFilterPipe *self = (LogFilterPipe *) s;
+
+  if (debug_flag)
+    filter_expr_dump_statistics(self->expr, self->name, 0);
+  return TRUE;
+}
+
 static void
 log_filter_pipe_queue(LogPipe *s, LogMessage *msg, const LogPathOptions *path_options, gpointer user_data)
 {
@@ -764,6 +1250,7 @@ log_filter_pipe_new(FilterExprNode *expr)
 
   log_pipe_init_instance(&self->super);
   self->super.init = log_filter_pipe_init;
+  self->super.deinit = log_filter_pipe_deinit;
   self->super.queue = log_filter_pipe_queue;
   self->super.free_fn = log_filter_pipe_free;
   self->super.clone = log_filter_pipe_clone;
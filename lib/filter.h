@@ -30,6 +30,7 @@
 #include "logpipe.h"
 #include "messages.h"
 #include "logmatcher.h"
+#include "logmatcher-set.h"
 #include "cfg-parser.h"
 
 struct _GlobalConfig;
@@ -41,6 +42,8 @@ struct _FilterExprNode
   guint32 comp:1,   /* this not is negated */
           modify:1; /* this filter changes the log message */
   const gchar *type;
+  /* number of evaluations and matches, only counted when debugging */
+  gint eval_count, match_count;
   void (*init)(FilterExprNode *self, GlobalConfig *cfg);
   gboolean (*eval)(FilterExprNode *self, LogMessage **msg, gint num_msg);
   void (*free_fn)(FilterExprNode *self);
@@ -50,13 +53,18 @@ gboolean filter_expr_eval(FilterExprNode *self, LogMessage *msg);
 gboolean filter_expr_eval_with_context(FilterExprNode *self, LogMessage **msgs, gint num_msg);
 gboolean filter_expr_eval_root(FilterExprNode *self, LogMessage **msg, const LogPathOptions *path_options);
 gboolean filter_expr_eval_root_with_context(FilterExprNode *self, LogMessage **msgs, gint num_msg, const LogPathOptions *path_options);
+FilterExprNode *filter_expr_ref(FilterExprNode *self);
 void filter_expr_unref(FilterExprNode *self);
+FilterExprNode *filter_expr_optimize(FilterExprNode *self);
 
 typedef struct _FilterRE
 {
   FilterExprNode super;
   NVHandle value_handle;
   LogMatcher *matcher;
+  /* literal prefilter shared with the other filters on the same value */
+  LogMatcherSet *matcher_set;
+  gint pattern_id;
 } FilterRE;
 
 typedef struct _FilterMatch FilterMatch;
@@ -76,6 +84,9 @@ FilterExprNode *filter_facility_new(guint32 facilities);
 FilterExprNode *filter_level_new(guint32 levels);
 FilterExprNode *filter_call_new(gchar *rule, struct _GlobalConfig *cfg);
 FilterExprNode *filter_netmask_new(gchar *cidr);
+FilterExprNode *filter_netmask_set_new(void);
+gboolean filter_netmask_set_add(FilterExprNode *s, const gchar *cidr);
+gboolean filter_netmask_set_load(FilterExprNode *s, const gchar *filename);
 FilterExprNode *filter_re_new(NVHandle value_handle);
 FilterExprNode *filter_match_new(void);
 FilterExprNode *filter_tags_new(GList *tags);
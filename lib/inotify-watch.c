@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2002-2013 BalaBit IT Ltd, Budapest, Hungary
+ * Copyright (c) 1998-2013 Balázs Scheidler
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * As an additional exemption you are allowed to compile & link against the
+ * OpenSSL libraries as published by the OpenSSL project. See the file
+ * COPYING for details.
+ *
+ */
+
+#include "inotify-watch.h"
+#include "messages.h"
+#include "misc.h"
+
+#include <unistd.h>
+#include <errno.h>
+#include <iv.h>
+
+#if HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+
+/* the inotify instance shared by all watches, open while there's at least one watch */
+static struct iv_fd inotify_watch_fd;
+/* wd -> GList of InotifyWatch instances, watches of the same file share the wd */
+static GHashTable *inotify_watches;
+/* incremented whenever the inotify instance is reopened, as the pending
+ * events of the old one would refer to a different set of wds */
+static guint inotify_watch_generation;
+
+static void
+inotify_watch_close(void)
+{
+  iv_fd_unregister(&inotify_watch_fd);
+  close(inotify_watch_fd.fd);
+  inotify_watch_fd.fd = -1;
+  g_hash_table_destroy(inotify_watches);
+  inotify_watches = NULL;
+}
+
+static void
+inotify_watch_dispatch(gint wd, guint32 mask, const gchar *name)
+{
+  GList *watches, *l;
+
+  /* the handlers may stop any of these watches, so we iterate over a copy
+   * and check that each watch is still there before calling it */
+  watches = g_list_copy(g_hash_table_lookup(inotify_watches, GINT_TO_POINTER(wd)));
+  for (l = watches; l && inotify_watches; l = l->next)
+    {
+      InotifyWatch *watch = (InotifyWatch *) l->data;
+
+      if (!g_list_find(g_hash_table_lookup(inotify_watches, GINT_TO_POINTER(wd)), watch))
+        continue;
+
+      if (mask & (watch->mask | IN_IGNORED | IN_UNMOUNT | IN_Q_OVERFLOW))
+        watch->handler(watch->cookie, mask, name);
+    }
+  g_list_free(watches);
+}
+
+static void
+inotify_watch_collect_wd(gpointer key, gpointer value, gpointer user_data)
+{
+  GList **wds = (GList **) user_data;
+
+  *wds = g_list_prepend(*wds, key);
+}
+
+/* events were dropped by the kernel, let everyone recheck their files */
+static void
+inotify_watch_dispatch_overflow(void)
+{
+  GList *wds = NULL, *l;
+
+  msg_verbose("inotify event queue overflowed, rechecking all watched files",
+              NULL);
+  g_hash_table_foreach(inotify_watches, inotify_watch_collect_wd, &wds);
+  for (l = wds; l && inotify_watches; l = l->next)
+    inotify_watch_dispatch(GPOINTER_TO_INT(l->data), IN_Q_OVERFLOW, NULL);
+  g_list_free(wds);
+}
+
+static void
+inotify_watch_io_input(gpointer s)
+{
+  gchar buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+  guint generation = inotify_watch_generation;
+  gssize len = 0;
+
+  /* NOTE: the instance is closed once the last watch is stopped, which
+   * may happen in any of the handlers */
+  while (inotify_watches && generation == inotify_watch_generation &&
+         (len = read(inotify_watch_fd.fd, buf, sizeof(buf))) > 0)
+    {
+      gchar *p = buf;
+
+      while (p < buf + len && inotify_watches && generation == inotify_watch_generation)
+        {
+          struct inotify_event *event = (struct inotify_event *) p;
+
+          p += sizeof(struct inotify_event) + event->len;
+          if (event->mask & IN_Q_OVERFLOW)
+            inotify_watch_dispatch_overflow();
+          else
+            inotify_watch_dispatch(event->wd, event->mask, event->len > 0 ? event->name : NULL);
+        }
+    }
+  if (len < 0 && errno != EAGAIN && errno != EINTR)
+    {
+      msg_error("Error reading inotify events",
+                evt_tag_errno("error", errno),
+                NULL);
+    }
+}
+
+gboolean
+inotify_watch_start(InotifyWatch *self, const gchar *path, guint32 mask)
+{
+  GList *watches;
+  gint wd;
+
+  g_assert(self->wd < 0);
+
+  if (!inotify_watches)
+    {
+      gint fd;
+
+      fd = inotify_init();
+      if (fd < 0)
+        {
+          msg_warning("WARNING: unable to initialize inotify, polling files instead",
+                      evt_tag_str("filename", path),
+                      evt_tag_errno("error", errno),
+                      NULL);
+          return FALSE;
+        }
+      g_fd_set_nonblock(fd, TRUE);
+      g_fd_set_cloexec(fd, TRUE);
+
+      IV_FD_INIT(&inotify_watch_fd);
+      inotify_watch_fd.fd = fd;
+      inotify_watch_fd.handler_in = inotify_watch_io_input;
+      iv_fd_register(&inotify_watch_fd);
+      inotify_watches = g_hash_table_new(g_direct_hash, g_direct_equal);
+      inotify_watch_generation++;
+    }
+
+  /* IN_MASK_ADD: other watches of the same file keep receiving their events */
+  wd = inotify_add_watch(inotify_watch_fd.fd, path, mask | IN_MASK_ADD);
+  if (wd < 0)
+    {
+      if (errno == ENOSPC)
+        msg_warning("WARNING: the number of inotify watches reached its limit, polling the file instead. Increase the fs.inotify.max_user_watches sysctl to avoid this",
+                    evt_tag_str("filename", path),
+                    NULL);
+      else
+        msg_verbose("Unable to add inotify watch, polling the file instead",
+                    evt_tag_str("filename", path),
+                    evt_tag_errno("error", errno),
+                    NULL);
+      if (g_hash_table_size(inotify_watches) == 0)
+        inotify_watch_close();
+      return FALSE;
+    }
+
+  watches = g_hash_table_lookup(inotify_watches, GINT_TO_POINTER(wd));
+  g_hash_table_insert(inotify_watches, GINT_TO_POINTER(wd), g_list_prepend(watches, self));
+  self->wd = wd;
+  self->mask = mask;
+  return TRUE;
+}
+
+void
+inotify_watch_stop(InotifyWatch *self)
+{
+  GList *watches;
+
+  if (self->wd < 0)
+    return;
+
+  watches = g_list_remove(g_hash_table_lookup(inotify_watches, GINT_TO_POINTER(self->wd)), self);
+  if (watches)
+    {
+      g_hash_table_insert(inotify_watches, GINT_TO_POINTER(self->wd), watches);
+    }
+  else
+    {
+      /* fails if the kernel has already dropped the watch (e.g. the file
+       * was deleted), which is fine */
+      inotify_rm_watch(inotify_watch_fd.fd, self->wd);
+      g_hash_table_remove(inotify_watches, GINT_TO_POINTER(self->wd));
+    }
+  self->wd = -1;
+
+  if (g_hash_table_size(inotify_watches) == 0)
+    inotify_watch_close();
+}
+
+#else
+
+gboolean
+inotify_watch_start(InotifyWatch *self, const gchar *path, guint32 mask)
+{
+  return FALSE;
+}
+
+void
+inotify_watch_stop(InotifyWatch *self)
+{
+}
+
+#endif
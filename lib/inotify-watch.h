@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2002-2013 BalaBit IT Ltd, Budapest, Hungary
+ * Copyright (c) 1998-2013 Balázs Scheidler
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * As an additional exemption you are allowed to compile & link against the
+ * OpenSSL libraries as published by the OpenSSL project. See the file
+ * COPYING for details.
+ *
+ */
+
+#ifndef INOTIFY_WATCH_H_INCLUDED
+#define INOTIFY_WATCH_H_INCLUDED
+
+#include "syslog-ng.h"
+
+/*
+ * All inotify watches of the process share a single inotify instance
+ * registered in the main loop, events are dispatched to the InotifyWatch
+ * owning the watch descriptor. This way following a large number of files
+ * only costs a watch each, instead of an inotify instance (and an fd).
+ *
+ * Both functions must be called from the main thread. The handler is
+ * called from the main loop, it may start or stop watches (including the
+ * one the event was delivered to).
+ */
+
+/* @mask: the IN_XXX event bits, @name: the file name for events reported for directory entries, NULL otherwise */
+typedef void (*InotifyWatchHandler)(gpointer cookie, guint32 mask, const gchar *name);
+
+typedef struct _InotifyWatch
+{
+  gint wd;
+  guint32 mask;
+  gpointer cookie;
+  InotifyWatchHandler handler;
+} InotifyWatch;
+
+static inline void
+inotify_watch_init(InotifyWatch *self, gpointer cookie, InotifyWatchHandler handler)
+{
+  self->wd = -1;
+  self->mask = 0;
+  self->cookie = cookie;
+  self->handler = handler;
+}
+
+static inline gboolean
+inotify_watch_started(InotifyWatch *self)
+{
+  return self->wd >= 0;
+}
+
+gboolean inotify_watch_start(InotifyWatch *self, const gchar *path, guint32 mask);
+void inotify_watch_stop(InotifyWatch *self);
+
+#endif
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2002-2013 BalaBit IT Ltd, Budapest, Hungary
+ * Copyright (c) 1998-2013 Balázs Scheidler
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * As an additional exemption you are allowed to compile & link against the
+ * OpenSSL libraries as published by the OpenSSL project. See the file
+ * COPYING for details.
+ *
+ */
+
+#include "logmatcher-set.h"
+#include "tls-support.h"
+
+#include <string.h>
+
+/* marks a missing edge in the trie while building the automaton */
+#define LMS_NO_STATE G_MAXUINT32
+
+/* values longer than this are scanned again for every filter */
+#define LMS_MEMO_VALUE_MAX 1024
+/* number of sets a thread remembers the last scan results for */
+#define LMS_MEMO_SLOTS 4
+
+typedef struct _LogMatcherAutomaton
+{
+  gboolean icase;
+  GPtrArray *patterns;
+  GArray *pattern_ids;
+
+  /* input bytes are mapped to character classes, class 0 contains the
+   * bytes not occurring in any of the patterns */
+  guint16 byte_class[256];
+  gint num_classes;
+
+  /* the state transition table, num_states * num_classes entries */
+  guint32 *delta;
+  gint num_states;
+
+  /* outputs[output_start[state]] is the -1 terminated list of patterns
+   * ending in that state, output_start is -1 if there are none */
+  gint *output_start;
+  GArray *outputs;
+} LogMatcherAutomaton;
+
+struct _LogMatcherSet
+{
+  gint ref_cnt;
+  guint32 serial;
+  gint num_patterns;
+  gboolean compiled;
+  LogMatcherAutomaton exact;
+  LogMatcherAutomaton icase;
+};
+
+typedef struct _LogMatcherSetMemo
+{
+  guint32 serial;
+  gsize value_len;
+  gchar value[LMS_MEMO_VALUE_MAX];
+  guint32 matches[LOG_MATCHER_SET_MAX_PATTERNS / 32];
+} LogMatcherSetMemo;
+
+TLS_BLOCK_START
+{
+  LogMatcherSetMemo log_matcher_set_memo[LMS_MEMO_SLOTS];
+}
+TLS_BLOCK_END;
+
+#define log_matcher_set_memo  __tls_deref(log_matcher_set_memo)
+
+/* sets are created from the main thread while parsing the configuration */
+static guint32 log_matcher_set_serial;
+
+static inline guchar
+log_matcher_automaton_fold(LogMatcherAutomaton *self, guchar c)
+{
+  return self->icase ? g_ascii_tolower(c) : c;
+}
+
+static void
+log_matcher_automaton_init(LogMatcherAutomaton *self, gboolean icase)
+{
+  self->icase = icase;
+  self->patterns = g_ptr_array_new();
+  self->pattern_ids = g_array_new(FALSE, FALSE, sizeof(gint));
+}
+
+static void
+log_matcher_automaton_add_pattern(LogMatcherAutomaton *self, const gchar *pattern, gint pattern_id)
+{
+  g_ptr_array_add(self->patterns, g_strdup(pattern));
+  g_array_append_val(self->pattern_ids, pattern_id);
+}
+
+static void
+log_matcher_automaton_compute_classes(LogMatcherAutomaton *self)
+{
+  gint i, c;
+
+  memset(self->byte_class, 0, sizeof(self->byte_class));
+  self->num_classes = 1;
+  for (i = 0; i < self->patterns->len; i++)
+    {
+      const guchar *p;
+
+      for (p = g_ptr_array_index(self->patterns, i); *p; p++)
+        {
+          guchar folded = log_matcher_automaton_fold(self, *p);
+
+          if (!self->byte_class[folded])
+            self->byte_class[folded] = self->num_classes++;
+        }
+    }
+  if (self->icase)
+    {
+      for (c = 'A'; c <= 'Z'; c++)
+        self->byte_class[c] = self->byte_class[g_ascii_tolower(c)];
+    }
+}
+
+static void
+log_matcher_automaton_compile(LogMatcherAutomaton *self)
+{
+  GPtrArray *state_outputs;
+  guint32 *fail, *queue;
+  gint alloc_states;
+  gint head, tail;
+  gint i, c;
+
+  if (self->patterns->len == 0)
+    return;
+
+  log_matcher_automaton_compute_classes(self);
+
+  /* build the trie */
+  alloc_states = 64;
+  self->delta = g_new(guint32, alloc_states * self->num_classes);
+  memset(self->delta, 0xFF, sizeof(guint32) * self->num_classes);
+  self->num_states = 1;
+  state_outputs = g_ptr_array_new();
+  g_ptr_array_add(state_outputs, NULL);
+
+  for (i = 0; i < self->patterns->len; i++)
+    {
+      const guchar *p;
+      guint32 state = 0;
+
+      for (p = g_ptr_array_index(self->patterns, i); *p; p++)
+        {
+          guint32 *edge = &self->delta[state * self->num_classes + self->byte_class[*p]];
+
+          if (*edge == LMS_NO_STATE)
+            {
+              if (self->num_states == alloc_states)
+                {
+                  alloc_states *= 2;
+                  self->delta = g_renew(guint32, self->delta, alloc_states * self->num_classes);
+                  /* the reallocation may have moved the edge */
+                  edge = &self->delta[state * self->num_classes + self->byte_class[*p]];
+                }
+              memset(&self->delta[self->num_states * self->num_classes], 0xFF, sizeof(guint32) * self->num_classes);
+              g_ptr_array_add(state_outputs, NULL);
+              *edge = self->num_states++;
+            }
+          state = *edge;
+        }
+      if (!g_ptr_array_index(state_outputs, state))
+        g_ptr_array_index(state_outputs, state) = g_array_new(FALSE, FALSE, sizeof(gint));
+      g_array_append_val((GArray *) g_ptr_array_index(state_outputs, state), g_array_index(self->pattern_ids, gint, i));
+    }
+
+  /* turn the trie into a DFA by following the failure links in breadth-first order */
+  fail = g_new0(guint32, self->num_states);
+  queue = g_new(guint32, self->num_states);
+  head = tail = 0;
+  for (c = 0; c < self->num_classes; c++)
+    {
+      guint32 *edge = &self->delta[c];
+
+      if (*edge == LMS_NO_STATE)
+        *edge = 0;
+      else
+        queue[tail++] = *edge;
+    }
+  while (head < tail)
+    {
+      guint32 state = queue[head++];
+      GArray *fail_outputs;
+
+      fail_outputs = g_ptr_array_index(state_outputs, fail[state]);
+      if (fail_outputs)
+        {
+          if (!g_ptr_array_index(state_outputs, state))
+            g_ptr_array_index(state_outputs, state) = g_array_new(FALSE, FALSE, sizeof(gint));
+          g_array_append_vals(g_ptr_array_index(state_outputs, state), fail_outputs->data, fail_outputs->len);
+        }
+
+      for (c = 0; c < self->num_classes; c++)
+        {
+          guint32 *edge = &self->delta[state * self->num_classes + c];
+          guint32 fail_target = self->delta[fail[state] * self->num_classes + c];
+
+          if (*edge == LMS_NO_STATE)
+            {
+              *edge = fail_target;
+            }
+          else
+            {
+              fail[*edge] = fail_target;
+              queue[tail++] = *edge;
+            }
+        }
+    }
+  g_free(queue);
+  g_free(fail);
+
+  /* flatten the output lists */
+  self->output_start = g_new(gint, self->num_states);
+  self->outputs = g_array_new(FALSE, FALSE, sizeof(gint));
+  for (i = 0; i < self->num_states; i++)
+    {
+      GArray *outputs = g_ptr_array_index(state_outputs, i);
+      gint terminator = -1;
+
+      if (!outputs)
+        {
+          self->output_start[i] = -1;
+          continue;
+        }
+      self->output_start[i] = self->outputs->len;
+      g_array_append_vals(self->outputs, outputs->data, outputs->len);
+      g_array_append_val(self->outputs, terminator);
+      g_array_free(outputs, TRUE);
+    }
+  g_ptr_array_free(state_outputs, TRUE);
+}
+
+static void
+log_matcher_automaton_scan(LogMatcherAutomaton *self, const gchar *value, gsize value_len, guint32 *matches)
+{
+  const guchar *p = (const guchar *) value;
+  const guchar *end = p + value_len;
+  guint32 state = 0;
+
+  if (!self->delta)
+    return;
+
+  for (; p < end; p++)
+    {
+      state = self->delta[state * self->num_classes + self->byte_class[*p]];
+      if (G_UNLIKELY(self->output_start[state] >= 0))
+        {
+          gint *id;
+
+          for (id = &g_array_index(self->outputs, gint, self->output_start[state]); *id >= 0; id++)
+            matches[*id >> 5] |= 1 << (*id & 31);
+        }
+    }
+}
+
+static void
+log_matcher_automaton_free(LogMatcherAutomaton *self)
+{
+  gint i;
+
+  for (i = 0; i < self->patterns->len; i++)
+    g_free(g_ptr_array_index(self->patterns, i));
+  g_ptr_array_free(self->patterns, TRUE);
+  g_array_free(self->pattern_ids, TRUE);
+  g_free(self->delta);
+  g_free(self->output_start);
+  if (self->outputs)
+    g_array_free(self->outputs, TRUE);
+}
+
+/*
+ * Adds @pattern to the set, returns the identifier of the pattern to be
+ * used with log_matcher_set_has_match() or -1 if the pattern can't be
+ * added.
+ */
+gint
+log_matcher_set_add_pattern(LogMatcherSet *self, const gchar *pattern, gboolean icase)
+{
+  gint pattern_id;
+
+  if (self->compiled || self->num_patterns >= LOG_MATCHER_SET_MAX_PATTERNS || !pattern[0])
+    return -1;
+
+  pattern_id = self->num_patterns++;
+  log_matcher_automaton_add_pattern(icase ? &self->icase : &self->exact, pattern, pattern_id);
+  return pattern_id;
+}
+
+void
+log_matcher_set_compile(LogMatcherSet *self)
+{
+  if (self->compiled)
+    return;
+
+  log_matcher_automaton_compile(&self->exact);
+  log_matcher_automaton_compile(&self->icase);
+  self->compiled = TRUE;
+}
+
+gboolean
+log_matcher_set_is_compiled(LogMatcherSet *self)
+{
+  return self->compiled;
+}
+
+/*
+ * Returns a bitmap of the patterns occurring in @value.  The result of
+ * the last scan is remembered by each thread, so filters evaluating the
+ * same value of a message only scan it once.  The returned bitmap is
+ * valid until the next call in the same thread.
+ */
+const guint32 *
+log_matcher_set_scan(LogMatcherSet *self, const gchar *value, gsize value_len)
+{
+  LogMatcherSetMemo *memo = &log_matcher_set_memo[self->serial % LMS_MEMO_SLOTS];
+  gint words = (self->num_patterns + 31) / 32;
+
+  if (memo->serial == self->serial &&
+      memo->value_len == value_len &&
+      memcmp(memo->value, value, value_len) == 0)
+    return memo->matches;
+
+  memset(memo->matches, 0, words * sizeof(guint32));
+  log_matcher_automaton_scan(&self->exact, value, value_len, memo->matches);
+  log_matcher_automaton_scan(&self->icase, value, value_len, memo->matches);
+
+  if (value_len <= LMS_MEMO_VALUE_MAX)
+    {
+      memo->serial = self->serial;
+      memo->value_len = value_len;
+      memcpy(memo->value, value, value_len);
+    }
+  else
+    {
+      memo->serial = 0;
+    }
+  return memo->matches;
+}
+
+LogMatcherSet *
+log_matcher_set_new(void)
+{
+  LogMatcherSet *self = g_new0(LogMatcherSet, 1);
+
+  self->ref_cnt = 1;
+  self->serial = ++log_matcher_set_serial;
+  log_matcher_automaton_init(&self->exact, FALSE);
+  log_matcher_automaton_init(&self->icase, TRUE);
+  return self;
+}
+
+LogMatcherSet *
+log_matcher_set_ref(LogMatcherSet *self)
+{
+  self->ref_cnt++;
+  return self;
+}
+
+void
+log_matcher_set_unref(LogMatcherSet *self)
+{
+  if (--self->ref_cnt == 0)
+    {
+      log_matcher_automaton_free(&self->exact);
+      log_matcher_automaton_free(&self->icase);
+      g_free(self);
+    }
+}
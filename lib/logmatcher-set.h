@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2002-2013 BalaBit IT Ltd, Budapest, Hungary
+ * Copyright (c) 1998-2013 Balázs Scheidler
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * As an additional exemption you are allowed to compile & link against the
+ * OpenSSL libraries as published by the OpenSSL project. See the file
+ * COPYING for details.
+ *
+ */
+
+#ifndef LOGMATCHER_SET_H_INCLUDED
+#define LOGMATCHER_SET_H_INCLUDED
+
+#include "syslog-ng.h"
+
+/* maximum number of patterns in a single set */
+#define LOG_MATCHER_SET_MAX_PATTERNS 1024
+
+/*
+ * A set of literal patterns that are searched for in a single pass over
+ * the input (using an Aho-Corasick automaton).  Filters matching the same
+ * value register the literals their matches depend on, and the set tells
+ * them which of the literals occur in a message, so that all filters
+ * share a single scan of the value.
+ *
+ * Patterns can be added until the set is compiled, the compiled set is
+ * read-only and can be used from multiple threads.
+ */
+typedef struct _LogMatcherSet LogMatcherSet;
+
+gint log_matcher_set_add_pattern(LogMatcherSet *self, const gchar *pattern, gboolean icase);
+void log_matcher_set_compile(LogMatcherSet *self);
+gboolean log_matcher_set_is_compiled(LogMatcherSet *self);
+const guint32 *log_matcher_set_scan(LogMatcherSet *self, const gchar *value, gsize value_len);
+
+static inline gboolean
+log_matcher_set_has_match(const guint32 *matches, gint pattern_id)
+{
+  return !!(matches[pattern_id >> 5] & (1 << (pattern_id & 31)));
+}
+
+LogMatcherSet *log_matcher_set_new(void);
+LogMatcherSet *log_matcher_set_ref(LogMatcherSet *self);
+void log_matcher_set_unref(LogMatcherSet *self);
+
+#endif
@@ -60,6 +60,183 @@ log_matcher_lookup_flag(const gchar* flag)
     return 0x0;
 }
 
+/* literals shorter than this are not worth prefiltering */
+#define LM_MIN_REQUIRED_LITERAL 3
+
+/* returns the longest literal that is part of every string matched by a
+ * regular expression, the analysis is conservative and gives up on
+ * anything complex */
+static gchar *
+log_matcher_regexp_required_literal(const gchar *re)
+{
+  GString *run = g_string_sized_new(32);
+  gchar *longest = NULL;
+  gint depth = 0;
+  const gchar *p;
+
+  /* inline options and alternatives make literals optional */
+  if (strstr(re, "(?") || strchr(re, '|'))
+    goto exit;
+
+  for (p = re; *p; p++)
+    {
+      switch (*p)
+        {
+        case '\\':
+          if (!p[1])
+            goto exit;
+          p++;
+          if (!g_ascii_isalnum(*p))
+            {
+              /* escaped punctuation is a literal */
+              if (depth == 0)
+                g_string_append_c(run, *p);
+              continue;
+            }
+          /* character classes without arguments, anything else (backrefs,
+           * hex/octal escapes, properties) is not analyzed */
+          if (!strchr("dDwWsSbBAZzGhHvVRtnrfe", *p))
+            goto exit;
+          break;
+        case '[':
+          /* skip the bracket expression, a ']' right after the opening is part of it */
+          p++;
+          if (*p == '^')
+            p++;
+          if (*p == ']')
+            p++;
+          while (*p && *p != ']')
+            {
+              if (*p == '[' && (p[1] == ':' || p[1] == '.' || p[1] == '='))
+                {
+                  gchar term = p[1];
+
+                  for (p += 2; *p && !(*p == term && p[1] == ']'); p++)
+                    ;
+                  if (!*p)
+                    goto exit;
+                  p++;
+                }
+              else if (*p == '\\' && p[1])
+                {
+                  p++;
+                }
+              p++;
+            }
+          if (!*p)
+            goto exit;
+          break;
+        case '(':
+          depth++;
+          break;
+        case ')':
+          depth--;
+          break;
+        case '*':
+        case '?':
+        case '{':
+          /* the previous atom is optional, it may be a multibyte character */
+          while (run->len > 0 && (run->str[run->len - 1] & 0xC0) == 0x80)
+            g_string_truncate(run, run->len - 1);
+          if (run->len > 0)
+            g_string_truncate(run, run->len - 1);
+          if (*p == '{')
+            {
+              while (*p && *p != '}')
+                p++;
+              if (!*p)
+                goto exit;
+            }
+          break;
+        case '+':
+        case '.':
+        case '^':
+        case '$':
+          break;
+        default:
+          if (depth == 0)
+            {
+              g_string_append_c(run, *p);
+              continue;
+            }
+          break;
+        }
+
+      /* the run of literals ends here */
+      if (!longest || run->len > strlen(longest))
+        {
+          g_free(longest);
+          longest = g_strndup(run->str, run->len);
+        }
+      g_string_truncate(run, 0);
+    }
+  if (!longest || run->len > strlen(longest))
+    {
+      g_free(longest);
+      longest = g_strndup(run->str, run->len);
+    }
+
+ exit:
+  g_string_free(run, TRUE);
+  if (longest && strlen(longest) < LM_MIN_REQUIRED_LITERAL)
+    {
+      g_free(longest);
+      return NULL;
+    }
+  return longest;
+}
+
+/* returns the longest literal between the wildcards of a glob pattern */
+static gchar *
+log_matcher_glob_required_literal(const gchar *pattern)
+{
+  const gchar *start, *p;
+  const gchar *longest = NULL;
+  gint longest_len = 0;
+
+  for (start = p = pattern; ; p++)
+    {
+      if (*p == '*' || *p == '?' || *p == 0)
+        {
+          if (p - start > longest_len)
+            {
+              longest = start;
+              longest_len = p - start;
+            }
+          if (*p == 0)
+            break;
+          start = p + 1;
+        }
+    }
+  if (longest_len < LM_MIN_REQUIRED_LITERAL)
+    return NULL;
+  return g_strndup(longest, longest_len);
+}
+
+/*
+ * Returns a literal string that occurs in every value this matcher
+ * matches, or NULL if there's no such literal (or it can't be
+ * determined).  Used to prefilter values with a LogMatcherSet.
+ */
+gchar *
+log_matcher_get_required_literal(LogMatcher *s)
+{
+  if (!s->pattern)
+    return NULL;
+
+  switch (s->type)
+    {
+    case LMR_STRING:
+      return s->pattern[0] ? g_strdup(s->pattern) : NULL;
+    case LMR_GLOB:
+      return log_matcher_glob_required_literal(s->pattern);
+    case LMR_POSIX_REGEXP:
+    case LMR_PCRE_REGEXP:
+      return log_matcher_regexp_required_literal(s->pattern);
+    }
+  return NULL;
+}
+
 typedef struct _LogMatcherPosixRe
 {
   LogMatcher super;
@@ -500,12 +677,73 @@ log_matcher_glob_new(void)
 
 /* libpcre support */
 
+#ifdef PCRE_STUDY_JIT_COMPILE
+
+/* JIT compiled patterns run on a separate stack, the default one on the
+ * machine stack is too small for complex patterns.  Stacks are allocated
+ * per thread, as a single stack can't be used by concurrent matches. */
+#define PCRE_JIT_STACK_MIN (32 * 1024)
+#define PCRE_JIT_STACK_MAX (512 * 1024)
+
+static GStaticPrivate pcre_jit_stack_private = G_STATIC_PRIVATE_INIT;
+
+static pcre_jit_stack *
+log_matcher_pcre_get_jit_stack(gpointer user_data)
+{
+  pcre_jit_stack *jit_stack;
+
+  jit_stack = g_static_private_get(&pcre_jit_stack_private);
+  if (!jit_stack)
+    {
+      jit_stack = pcre_jit_stack_alloc(PCRE_JIT_STACK_MIN, PCRE_JIT_STACK_MAX);
+      g_static_private_set(&pcre_jit_stack_private, jit_stack, (GDestroyNotify) pcre_jit_stack_free);
+    }
+  return jit_stack;
+}
+
+#endif
+
+/*
+ * Studies a compiled pattern and JIT compiles it if libpcre supports
+ * it.  The result must be freed with log_matcher_pcre_free_study().
+ */
+pcre_extra *
+log_matcher_pcre_study(pcre *pattern, const gchar **errptr)
+{
+  pcre_extra *extra;
+
+#ifdef PCRE_STUDY_JIT_COMPILE
+  extra = pcre_study(pattern, PCRE_STUDY_JIT_COMPILE, errptr);
+  if (extra)
+    pcre_assign_jit_stack(extra, log_matcher_pcre_get_jit_stack, NULL);
+#else
+  extra = pcre_study(pattern, 0, errptr);
+#endif
+  return extra;
+}
+
+void
+log_matcher_pcre_free_study(pcre_extra *extra)
+{
+  if (!extra)
+    return;
+#ifdef PCRE_STUDY_JIT_COMPILE
+  pcre_free_study(extra);
+#else
+  pcre_free(extra);
+#endif
+}
+
 typedef struct _LogMatcherPcreRe
 {
   LogMatcher super;
   pcre *pattern;
   pcre_extra *extra;
   gint match_options;
+  /* cached pattern information, to avoid querying it for each match */
+  gint capture_count;
+  gint name_count;
+  gint backref_max;
 } LogMatcherPcreRe;
 
 static gboolean
@@ -563,7 +801,7 @@ log_matcher_pcre_re_compile(LogMatcher *s, const gchar *re)
     }
     
   /* optimize regexp */
-  self->extra = pcre_study(self->pattern, 0, &errptr);
+  self->extra = log_matcher_pcre_study(self->pattern, &errptr);
   if (errptr != NULL)
     {
       msg_error("Error while optimizing regular expression",
@@ -573,6 +811,13 @@ log_matcher_pcre_re_compile(LogMatcher *s, const gchar *re)
       return FALSE;
     }
 
+  if (pcre_fullinfo(self->pattern, self->extra, PCRE_INFO_CAPTURECOUNT, &self->capture_count) < 0)
+    g_assert_not_reached();
+  if (self->capture_count > RE_MAX_MATCHES)
+    self->capture_count = RE_MAX_MATCHES;
+  pcre_fullinfo(self->pattern, self->extra, PCRE_INFO_NAMECOUNT, &self->name_count);
+  pcre_fullinfo(self->pattern, self->extra, PCRE_INFO_BACKREFMAX, &self->backref_max);
+
   return TRUE;
 }
 
@@ -603,7 +848,7 @@ log_matcher_pcre_re_feed_named_substrings(LogMatcher *s, LogMessage *msg, int *m
    gint name_entry_size = 0;
    LogMatcherPcreRe *self = (LogMatcherPcreRe *) s;
 
-   pcre_fullinfo(self->pattern, self->extra, PCRE_INFO_NAMECOUNT, &namecount);  
+   namecount = self->name_count;
    if (namecount > 0) 
      { 
        gchar *tabptr;
@@ -631,19 +876,25 @@ log_matcher_pcre_re_match(LogMatcher *s, LogMessage *msg, gint value_handle, con
   LogMatcherPcreRe *self = (LogMatcherPcreRe *) s; 
   gint *matches;
   gsize matches_size;
-  gint num_matches;
   gint rc;
 
   if (value_len == -1)
     value_len = strlen(value);
 
-  if (pcre_fullinfo(self->pattern, self->extra, PCRE_INFO_CAPTURECOUNT, &num_matches) < 0)
-    g_assert_not_reached();
-  if (num_matches > RE_MAX_MATCHES)
-    num_matches = RE_MAX_MATCHES;
-
-  matches_size = 3 * (num_matches + 1);
-  matches = g_alloca(matches_size * sizeof(gint));
+  if (G_LIKELY((s->flags & LMF_STORE_MATCHES) == 0 && self->backref_max == 0))
+    {
+      /* only the fact of the match is needed, let pcre skip the captures
+       * (back references would need a temporary ovector allocated by pcre) */
+      matches = NULL;
+      matches_size = 0;
+    }
+  else
+    {
+      /* patterns with back references need the ovector to match even if
+       * the matches are not stored */
+      matches_size = 3 * (self->capture_count + 1);
+      matches = g_alloca(matches_size * sizeof(gint));
+    }
 
   rc = pcre_exec(self->pattern, self->extra,
                  value, value_len, 0, self->match_options, matches, matches_size);
@@ -663,17 +914,17 @@ log_matcher_pcre_re_match(LogMatcher *s, LogMessage *msg, gint value_handle, con
         }
       return FALSE;
     }
+  if ((s->flags & LMF_STORE_MATCHES) == 0)
+    return TRUE;
+
   if (rc == 0)
     {
       msg_error("Error while storing matching substrings", NULL);
     }
   else
     {
-      if ((s->flags & LMF_STORE_MATCHES))
-        {
-          log_matcher_pcre_re_feed_backrefs(s, msg, value_handle, matches, rc, value);
-          log_matcher_pcre_re_feed_named_substrings(s, msg, matches, value);
-        }
+      log_matcher_pcre_re_feed_backrefs(s, msg, value_handle, matches, rc, value);
+      log_matcher_pcre_re_feed_named_substrings(s, msg, matches, value);
     }
   return TRUE;
 }
@@ -685,18 +936,12 @@ log_matcher_pcre_re_replace(LogMatcher *s, LogMessage *msg, gint value_handle, c
   GString *new_value = NULL;
   gint *matches;
   gsize matches_size;
-  gint num_matches;
   gint rc;
   gint start_offset, last_offset;
   gint options;
   gboolean last_match_was_empty;
 
-  if (pcre_fullinfo(self->pattern, self->extra, PCRE_INFO_CAPTURECOUNT, &num_matches) < 0)
-    g_assert_not_reached();
-  if (num_matches > RE_MAX_MATCHES)
-    num_matches = RE_MAX_MATCHES;
-
-  matches_size = 3 * (num_matches + 1);
+  matches_size = 3 * (self->capture_count + 1);
   matches = g_alloca(matches_size * sizeof(gint));
 
   /* we need zero initialized offsets for the last match as the
@@ -813,7 +1058,7 @@ static void
 log_matcher_pcre_re_free(LogMatcher *s)
 {
   LogMatcherPcreRe *self = (LogMatcherPcreRe *) s;
-  pcre_free(self->extra);
+  log_matcher_pcre_free_study(self->extra);
   pcre_free(self->pattern);
 }
 
@@ -877,6 +1122,7 @@ log_matcher_unref(LogMatcher *s)
     {
       if (s->free_fn)
         s->free_fn(s);
+      g_free(s->pattern);
       g_free(s);
     }
 }
@@ -63,6 +63,8 @@ struct _LogMatcher
   gint ref_cnt;
   gint type;
   gint flags;
+  /* the pattern as specified by the user */
+  gchar *pattern;
   gboolean (*compile)(LogMatcher *s, const gchar *re);
   /* value_len can be -1 to indicate unknown length */
   gboolean (*match)(LogMatcher *s, LogMessage *msg, gint value_handle, const gchar *value, gssize value_len);
@@ -74,6 +76,8 @@ struct _LogMatcher
 static inline gboolean 
 log_matcher_compile(LogMatcher *s, const gchar *re)
 {
+  g_free(s->pattern);
+  s->pattern = g_strdup(re);
   return s->compile(s, re);
 }
 
@@ -98,7 +102,15 @@ log_matcher_set_flags(LogMatcher *s, gint flags)
   s->flags = flags;
 }
 
+#if ENABLE_PCRE
+#include <pcre.h>
+
+pcre_extra *log_matcher_pcre_study(pcre *pattern, const gchar **errptr);
+void log_matcher_pcre_free_study(pcre_extra *extra);
+#endif
+
 gint log_matcher_lookup_flag(const gchar* flag);
+gchar *log_matcher_get_required_literal(LogMatcher *s);
 
 LogMatcher *log_matcher_posix_re_new(void);
 LogMatcher *log_matcher_pcre_re_new(void);
@@ -121,6 +121,8 @@ TLS_BLOCK_START
   gint logmsg_cached_refs;
   /* number of cached acks by the current thread */
   gint logmsg_cached_acks;
+  /* free LogMessage blocks owned by the current thread, see log_msg_pool_alloc() */
+  struct _LogMessagePoolCache *logmsg_pool_cache;
 }
 TLS_BLOCK_END;
 
@@ -128,6 +130,7 @@ TLS_BLOCK_END;
 #define logmsg_cached_refs          __tls_deref(logmsg_cached_refs)
 #define logmsg_cached_acks          __tls_deref(logmsg_cached_acks)
 #define logmsg_cached_ack_needed    __tls_deref(logmsg_cached_ack_needed)
+#define logmsg_pool_cache           __tls_deref(logmsg_pool_cache)
 
 #define LOGMSG_REFCACHE_BIAS                  0x00004000 /* the BIAS we add to the ref counter in refcache_start */
 #define LOGMSG_REFCACHE_ACK_SHIFT                     16 /* number of bits to shift to get the ACK counter */
@@ -188,6 +191,8 @@ gint logmsg_queue_node_max = 1;
 static StatsCounterItem *count_msg_clones;
 static StatsCounterItem *count_payload_reallocs;
 static StatsCounterItem *count_sdata_updates;
+static StatsCounterItem *count_pool_hits;
+static StatsCounterItem *count_pool_misses;
 static GStaticPrivate priv_macro_value = G_STATIC_PRIVATE_INIT;
 
 static inline gboolean
@@ -956,6 +961,161 @@ log_msg_print_tags(LogMessage *self, GString *result)
   log_msg_tags_foreach(self, log_msg_append_tags_callback, args);
 }
 
+/*
+ * LogMessage serialization
+ *
+ * The serialized format is independent of the NVHandle and LogTagId
+ * values allocated by the current process, as names are stored instead
+ * of numeric identifiers.  This makes it possible to read back messages
+ * written by a previous syslog-ng instance (e.g. from a disk based queue).
+ *
+ * Layout:
+ *   - version (uint8)
+ *   - flags & pri
+ *   - timestamps (LM_TS_MAX entries)
+ *   - sender address (length + raw struct sockaddr, zero length if none)
+ *   - number of matches
+ *   - tags (list of cstrings, terminated by an empty string)
+ *   - name-value pairs (list of cstring pairs, terminated by an empty name)
+ */
+#define LOGMSG_SERIALIZE_VERSION 0
+
+static gboolean
+log_msg_write_tag_callback(LogMessage *self, LogTagId tag_id, const gchar *name, gpointer user_data)
+{
+  SerializeArchive *sa = (SerializeArchive *) user_data;
+
+  serialize_write_cstring(sa, name, -1);
+  return TRUE;
+}
+
+static gboolean
+log_msg_write_value_callback(NVHandle handle, const gchar *name, const gchar *value, gssize value_len, gpointer user_data)
+{
+  SerializeArchive *sa = (SerializeArchive *) user_data;
+
+  /* returning TRUE would stop the iteration */
+  return !(serialize_write_cstring(sa, name, -1) &&
+           serialize_write_cstring(sa, value, value_len));
+}
+
+gboolean
+log_msg_write(LogMessage *self, SerializeArchive *sa)
+{
+  gint i;
+
+  serialize_write_uint8(sa, LOGMSG_SERIALIZE_VERSION);
+  serialize_write_uint32(sa, self->flags & ~LF_STATE_MASK);
+  serialize_write_uint16(sa, self->pri);
+  for (i = 0; i < LM_TS_MAX; i++)
+    {
+      serialize_write_uint64(sa, (guint64) self->timestamps[i].tv_sec);
+      serialize_write_uint32(sa, self->timestamps[i].tv_usec);
+      serialize_write_uint32(sa, (guint32) self->timestamps[i].zone_offset);
+    }
+  if (self->saddr)
+    {
+      serialize_write_uint16(sa, self->saddr->salen);
+      serialize_write_blob(sa, g_sockaddr_get_sa(self->saddr), self->saddr->salen);
+    }
+  else
+    {
+      serialize_write_uint16(sa, 0);
+    }
+  serialize_write_uint8(sa, self->num_matches);
+
+  log_msg_tags_foreach(self, log_msg_write_tag_callback, sa);
+  serialize_write_cstring(sa, "", 0);
+
+  if (nv_table_foreach(self->payload, logmsg_registry, log_msg_write_value_callback, sa))
+    return FALSE;
+  return serialize_write_cstring(sa, "", 0);
+}
+
+gboolean
+log_msg_read(LogMessage *self, SerializeArchive *sa)
+{
+  guint8 version, num_matches;
+  guint32 flags;
+  guint16 salen;
+  gchar *name = NULL, *value = NULL;
+  gsize name_len, value_len;
+  gint i;
+
+  if (!serialize_read_uint8(sa, &version) || version != LOGMSG_SERIALIZE_VERSION)
+    return FALSE;
+
+  if (!serialize_read_uint32(sa, &flags) ||
+      !serialize_read_uint16(sa, &self->pri))
+    return FALSE;
+  self->flags = (self->flags & LF_STATE_MASK) | (flags & ~LF_STATE_MASK);
+
+  for (i = 0; i < LM_TS_MAX; i++)
+    {
+      guint64 tv_sec;
+      guint32 tv_usec, zone_offset;
+
+      if (!serialize_read_uint64(sa, &tv_sec) ||
+          !serialize_read_uint32(sa, &tv_usec) ||
+          !serialize_read_uint32(sa, &zone_offset))
+        return FALSE;
+      self->timestamps[i].tv_sec = (time_t) tv_sec;
+      self->timestamps[i].tv_usec = tv_usec;
+      self->timestamps[i].zone_offset = (gint32) zone_offset;
+    }
+
+  if (!serialize_read_uint16(sa, &salen))
+    return FALSE;
+  if (salen > 0)
+    {
+      struct sockaddr_storage ss;
+
+      if (salen > sizeof(ss) || !serialize_read_blob(sa, &ss, salen))
+        return FALSE;
+      if (log_msg_chk_flag(self, LF_STATE_OWN_SADDR))
+        g_sockaddr_unref(self->saddr);
+      self->saddr = g_sockaddr_new((struct sockaddr *) &ss, salen);
+      log_msg_set_flag(self, LF_STATE_OWN_SADDR);
+    }
+
+  if (!serialize_read_uint8(sa, &num_matches))
+    return FALSE;
+
+  while (TRUE)
+    {
+      name = NULL;
+      if (!serialize_read_cstring(sa, &name, &name_len))
+        goto error;
+      if (name_len == 0)
+        break;
+      log_msg_set_tag_by_name(self, name);
+      g_free(name);
+    }
+  g_free(name);
+
+  while (TRUE)
+    {
+      name = value = NULL;
+      if (!serialize_read_cstring(sa, &name, &name_len))
+        goto error;
+      if (name_len == 0)
+        break;
+      if (!serialize_read_cstring(sa, &value, &value_len))
+        goto error;
+      log_msg_set_value(self, log_msg_get_value_handle(name), value, value_len);
+      g_free(name);
+      g_free(value);
+    }
+  g_free(name);
+  self->num_matches = num_matches;
+  return TRUE;
+
+ error:
+  g_free(name);
+  g_free(value);
+  return FALSE;
+}
+
 
 
 /**
@@ -1020,12 +1180,252 @@ log_msg_clear(LogMessage *self)
   self->flags |= LF_STATE_OWN_MASK;
 }
 
+/**********************************************************************
+ * LogMessage allocation pool
+ *
+ * LogMessage instances (along with their queue nodes and initial payload)
+ * are allocated in a few power-of-two size classes and are recycled
+ * instead of being returned to malloc.  Each thread has a cache of free
+ * blocks per size class, without any locking.  As messages are usually
+ * allocated by the source and freed by the destination threads, blocks
+ * flow from one thread cache to the other through a global depot, in
+ * batches of LOGMSG_POOL_BATCH blocks to amortize the locking.
+ **********************************************************************/
+
+/* the smallest size class is 512 bytes, the largest is 16kB, larger messages bypass the pool */
+#define LOGMSG_POOL_MIN_SHIFT   9
+#define LOGMSG_POOL_CLASSES     6
+#define LOGMSG_POOL_NONE        0xFF
+/* number of blocks moved between a thread cache and the depot at once */
+#define LOGMSG_POOL_BATCH       32
+/* maximum number of free blocks in a thread cache, per size class */
+#define LOGMSG_POOL_CACHE_MAX   (4 * LOGMSG_POOL_BATCH)
+/* maximum number of batches in the global depot, per size class */
+#define LOGMSG_POOL_DEPOT_MAX   64
+
+typedef struct _LogMessagePoolBlock LogMessagePoolBlock;
+struct _LogMessagePoolBlock
+{
+  LogMessagePoolBlock *next;
+  /* only used in the depot, links the first blocks of the batches */
+  LogMessagePoolBlock *next_batch;
+};
+
+typedef struct _LogMessagePoolCache
+{
+  LogMessagePoolBlock *free_blocks[LOGMSG_POOL_CLASSES];
+  gint num_free[LOGMSG_POOL_CLASSES];
+} LogMessagePoolCache;
+
+static GStaticMutex logmsg_pool_depot_lock = G_STATIC_MUTEX_INIT;
+static LogMessagePoolBlock *logmsg_pool_depot[LOGMSG_POOL_CLASSES];
+static gint logmsg_pool_depot_len[LOGMSG_POOL_CLASSES];
+/* used to return the cache of exiting threads to the depot */
+static GStaticPrivate priv_pool_cache = G_STATIC_PRIVATE_INIT;
+
+static inline gsize
+log_msg_pool_class_size(gint alloc_class)
+{
+  return 1 << (LOGMSG_POOL_MIN_SHIFT + alloc_class);
+}
+
+static inline gint
+log_msg_pool_get_class(gsize size)
+{
+  gint alloc_class;
+
+  for (alloc_class = 0; alloc_class < LOGMSG_POOL_CLASSES; alloc_class++)
+    {
+      if (size <= log_msg_pool_class_size(alloc_class))
+        return alloc_class;
+    }
+  return LOGMSG_POOL_NONE;
+}
+
+/* takes the first @count blocks off @list, returns the rest */
+static LogMessagePoolBlock *
+log_msg_pool_cut_batch(LogMessagePoolBlock *list, gint count)
+{
+  LogMessagePoolBlock *last = list;
+  LogMessagePoolBlock *rest;
+
+  while (--count > 0)
+    last = last->next;
+  rest = last->next;
+  last->next = NULL;
+  return rest;
+}
+
+/* NOTE: @batch is a NULL terminated list of LOGMSG_POOL_BATCH blocks */
+static void
+log_msg_pool_depot_push(gint alloc_class, LogMessagePoolBlock *batch)
+{
+  LogMessagePoolBlock *next;
+
+  g_static_mutex_lock(&logmsg_pool_depot_lock);
+  if (logmsg_pool_depot_len[alloc_class] < LOGMSG_POOL_DEPOT_MAX)
+    {
+      batch->next_batch = logmsg_pool_depot[alloc_class];
+      logmsg_pool_depot[alloc_class] = batch;
+      logmsg_pool_depot_len[alloc_class]++;
+      batch = NULL;
+    }
+  g_static_mutex_unlock(&logmsg_pool_depot_lock);
+
+  /* the depot is full, give the memory back */
+  for (; batch; batch = next)
+    {
+      next = batch->next;
+      g_free(batch);
+    }
+}
+
+static LogMessagePoolBlock *
+log_msg_pool_depot_pop(gint alloc_class)
+{
+  LogMessagePoolBlock *batch;
+
+  g_static_mutex_lock(&logmsg_pool_depot_lock);
+  batch = logmsg_pool_depot[alloc_class];
+  if (batch)
+    {
+      logmsg_pool_depot[alloc_class] = batch->next_batch;
+      logmsg_pool_depot_len[alloc_class]--;
+    }
+  g_static_mutex_unlock(&logmsg_pool_depot_lock);
+  return batch;
+}
+
+static void
+log_msg_pool_cache_free(LogMessagePoolCache *cache)
+{
+  LogMessagePoolBlock *rest;
+  gint alloc_class;
+
+  for (alloc_class = 0; alloc_class < LOGMSG_POOL_CLASSES; alloc_class++)
+    {
+      while (cache->num_free[alloc_class] >= LOGMSG_POOL_BATCH)
+        {
+          rest = log_msg_pool_cut_batch(cache->free_blocks[alloc_class], LOGMSG_POOL_BATCH);
+          log_msg_pool_depot_push(alloc_class, cache->free_blocks[alloc_class]);
+          cache->free_blocks[alloc_class] = rest;
+          cache->num_free[alloc_class] -= LOGMSG_POOL_BATCH;
+        }
+      while ((rest = cache->free_blocks[alloc_class]))
+        {
+          cache->free_blocks[alloc_class] = rest->next;
+          g_free(rest);
+        }
+    }
+  g_free(cache);
+}
+
+static inline LogMessagePoolCache *
+log_msg_pool_get_cache(void)
+{
+  LogMessagePoolCache *cache = logmsg_pool_cache;
+
+  if (G_UNLIKELY(!cache))
+    {
+      cache = g_new0(LogMessagePoolCache, 1);
+      logmsg_pool_cache = cache;
+      g_static_private_set(&priv_pool_cache, cache, (GDestroyNotify) log_msg_pool_cache_free);
+    }
+  return cache;
+}
+
+/*
+ * Returns the blocks cached by the current thread to the depot, should be
+ * called by threads not started through GLib before they exit.
+ */
+void
+log_msg_pool_release_thread_cache(void)
+{
+  if (logmsg_pool_cache)
+    {
+      logmsg_pool_cache = NULL;
+      /* calls log_msg_pool_cache_free() for the previous value */
+      g_static_private_set(&priv_pool_cache, NULL, NULL);
+    }
+}
+
+static gpointer
+log_msg_pool_alloc(gint alloc_class)
+{
+  LogMessagePoolCache *cache = log_msg_pool_get_cache();
+  LogMessagePoolBlock *block;
+
+  if (cache->num_free[alloc_class] == 0)
+    {
+      block = log_msg_pool_depot_pop(alloc_class);
+      if (block)
+        {
+          cache->free_blocks[alloc_class] = block;
+          cache->num_free[alloc_class] = LOGMSG_POOL_BATCH;
+        }
+    }
+
+  block = cache->free_blocks[alloc_class];
+  if (!block)
+    {
+      stats_counter_inc(count_pool_misses);
+      return g_malloc(log_msg_pool_class_size(alloc_class));
+    }
+
+  cache->free_blocks[alloc_class] = block->next;
+  cache->num_free[alloc_class]--;
+  stats_counter_inc(count_pool_hits);
+  return block;
+}
+
+static void
+log_msg_pool_free(gpointer p, gint alloc_class)
+{
+  LogMessagePoolCache *cache = log_msg_pool_get_cache();
+  LogMessagePoolBlock *block = (LogMessagePoolBlock *) p;
+  LogMessagePoolBlock *rest;
+
+  if (cache->num_free[alloc_class] >= LOGMSG_POOL_CACHE_MAX)
+    {
+      /* hand over a batch to the threads allocating messages */
+      rest = log_msg_pool_cut_batch(cache->free_blocks[alloc_class], LOGMSG_POOL_BATCH);
+      log_msg_pool_depot_push(alloc_class, cache->free_blocks[alloc_class]);
+      cache->free_blocks[alloc_class] = rest;
+      cache->num_free[alloc_class] -= LOGMSG_POOL_BATCH;
+    }
+
+  block->next = cache->free_blocks[alloc_class];
+  cache->free_blocks[alloc_class] = block;
+  cache->num_free[alloc_class]++;
+}
+
+static void
+log_msg_pool_deinit(void)
+{
+  LogMessagePoolBlock *batch, *block, *next;
+  gint alloc_class;
+
+  log_msg_pool_release_thread_cache();
+  for (alloc_class = 0; alloc_class < LOGMSG_POOL_CLASSES; alloc_class++)
+    {
+      while ((batch = log_msg_pool_depot_pop(alloc_class)))
+        {
+          for (block = batch; block; block = next)
+            {
+              next = block->next;
+              g_free(block);
+            }
+        }
+    }
+}
+
 static inline LogMessage *
 log_msg_alloc(gsize payload_size)
 {
   LogMessage *msg;
   gsize payload_space = payload_size ? nv_table_get_alloc_size(LM_V_MAX, 16, payload_size) : 0;
   gsize alloc_size, payload_ofs = 0;
+  gint alloc_class;
 
   /* NOTE: logmsg_node_max is updated from parallel threads without locking. */
   gint nodes = (volatile gint) logmsg_queue_node_max;
@@ -1038,9 +1438,22 @@ log_msg_alloc(gsize payload_size)
       payload_ofs = alloc_size;
       alloc_size += payload_space;
     }
-  msg = g_malloc(alloc_size);
+
+  alloc_class = log_msg_pool_get_class(alloc_size);
+  if (alloc_class != LOGMSG_POOL_NONE)
+    {
+      msg = log_msg_pool_alloc(alloc_class);
+      /* use the rest of the block for the payload */
+      if (payload_size)
+        payload_space = log_msg_pool_class_size(alloc_class) - payload_ofs;
+    }
+  else
+    {
+      msg = g_malloc(alloc_size);
+    }
 
   memset(msg, 0, sizeof(LogMessage));
+  msg->alloc_class = alloc_class;
 
   if (payload_size)
     msg->payload = nv_table_init_borrowed(((gchar *) msg) + payload_ofs, payload_space, LM_V_MAX);
@@ -1106,6 +1519,7 @@ LogMessage *
 log_msg_clone_cow(LogMessage *msg, const LogPathOptions *path_options)
 {
   LogMessage *self = log_msg_alloc(0);
+  guint8 alloc_class = self->alloc_class;
 
   stats_counter_inc(count_msg_clones);
   if ((msg->flags & LF_STATE_OWN_MASK) == 0 || ((msg->flags & LF_STATE_OWN_MASK) == LF_STATE_OWN_TAGS && msg->num_tags == 0))
@@ -1119,6 +1533,7 @@ log_msg_clone_cow(LogMessage *msg, const LogPathOptions *path_options)
   log_msg_write_protect(msg);
 
   memcpy(self, msg, sizeof(*msg));
+  self->alloc_class = alloc_class;
 
   /* every field _must_ be initialized explicitly if its direct
    * copying would cause problems (like copying a pointer by value) */
@@ -1213,7 +1628,10 @@ log_msg_free(LogMessage *self)
   if (self->original)
     log_msg_unref(self->original);
 
-  g_free(self);
+  if (self->alloc_class != LOGMSG_POOL_NONE)
+    log_msg_pool_free(self, self->alloc_class);
+  else
+    g_free(self);
 }
 
 /**
@@ -1566,6 +1984,8 @@ log_msg_global_init(void)
   stats_register_counter(0, SCS_GLOBAL, "msg_clones", NULL, SC_TYPE_PROCESSED, &count_msg_clones);
   stats_register_counter(0, SCS_GLOBAL, "payload_reallocs", NULL, SC_TYPE_PROCESSED, &count_payload_reallocs);
   stats_register_counter(0, SCS_GLOBAL, "sdata_updates", NULL, SC_TYPE_PROCESSED, &count_sdata_updates);
+  stats_register_counter(0, SCS_GLOBAL, "msg_pool_hits", NULL, SC_TYPE_PROCESSED, &count_pool_hits);
+  stats_register_counter(0, SCS_GLOBAL, "msg_pool_misses", NULL, SC_TYPE_PROCESSED, &count_pool_misses);
   stats_unlock();
 }
 
@@ -1584,5 +2004,6 @@ log_msg_nv_table_foreach(NVTable *self, NVTableForeachFunc func, gpointer user_d
 void
 log_msg_global_deinit(void)
 {
+  log_msg_pool_deinit();
   log_msg_registry_deinit();
 }
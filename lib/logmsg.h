@@ -172,6 +172,8 @@ struct _LogMessage
   guint8 num_nodes;
   guint8 cur_node;
   guint8 protect_cnt;
+  /* size class of the allocation pool this message came from */
+  guint8 alloc_class;
 
   /* preallocated LogQueueNodes used to insert this message into a LogQueue */
   LogMessageQueueNode nodes[0];
@@ -269,6 +271,7 @@ void log_msg_registry_init();
 void log_msg_registry_deinit();
 void log_msg_global_init();
 void log_msg_global_deinit(void);
+void log_msg_pool_release_thread_cache(void);
 
 gboolean log_msg_nv_table_foreach(NVTable *self, NVTableForeachFunc func, gpointer user_data);
 
@@ -548,7 +548,9 @@ log_proto_buffered_server_prepare(LogProtoServer *s, gint *fd, GIOCondition *con
   if (*cond == 0)
     *cond = G_IO_IN;
 
-  return FALSE;
+  /* the transport may have received more input than we have consumed,
+   * which would not be indicated by the fd becoming readable */
+  return log_transport_has_pending_input(self->super.transport);
 }
 
 
@@ -60,6 +60,7 @@ log_proto_client_options_validate(const LogProtoClientOptions *options)
 void
 log_proto_client_options_defaults(LogProtoClientOptions *options)
 {
+  options->flush_lines = 0;
 }
 
 void
@@ -34,6 +34,9 @@ typedef struct _LogProtoClient LogProtoClient;
 
 typedef struct _LogProtoClientOptions
 {
+  /* the number of messages that may be collected and submitted to the
+   * transport in a single write operation */
+  gint flush_lines;
 } LogProtoClientOptions;
 
 typedef union _LogProtoClientOptionsStorage
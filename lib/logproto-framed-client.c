@@ -56,7 +56,12 @@ log_proto_framed_client_post(LogProtoClient *s, guchar *msg, gsize msg_len, gboo
     }
 
   rc = LPS_SUCCESS;
-  while (rc == LPS_SUCCESS && !(*consumed) && self->super.partial == NULL)
+  if (log_proto_text_client_is_full(&self->super))
+    rc = log_proto_client_flush(s);
+
+  /* NOTE: the frame header and the payload may end up in different
+   * batches, but they are never reordered, so the framing stays intact. */
+  while (rc == LPS_SUCCESS && !(*consumed) && !log_proto_text_client_is_full(&self->super))
     {
       switch (self->super.state)
         {
@@ -83,6 +88,8 @@ log_proto_framed_client_new(LogTransport *transport, const LogProtoClientOptions
 
   log_proto_text_client_init(&self->super, transport, options);
   self->super.super.post = log_proto_framed_client_post;
+  /* each message is sent as a frame header and a payload chunk */
+  log_proto_text_client_set_max_chunks(&self->super, 2 * MAX(options->flush_lines, 1));
   self->super.state = LPFCS_FRAME_SEND;
   return &self->super.super;
 }
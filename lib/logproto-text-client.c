@@ -24,6 +24,13 @@
 #include "logproto-text-client.h"
 #include "messages.h"
 
+#include <string.h>
+#include <limits.h>
+
+#ifndef IOV_MAX
+#define IOV_MAX 16
+#endif
+
 static gboolean
 log_proto_text_client_prepare(LogProtoClient *s, gint *fd, GIOCondition *cond)
 {
@@ -35,67 +42,123 @@ log_proto_text_client_prepare(LogProtoClient *s, gint *fd, GIOCondition *cond)
   /* if there's no pending I/O in the transport layer, then we want to do a write */
   if (*cond == 0)
     *cond = G_IO_OUT;
-  return self->partial != NULL;
+  return self->head < self->count;
+}
+
+static void
+log_proto_text_client_free_chunk(LogProtoTextClientChunk *chunk)
+{
+  if (chunk->data_free)
+    chunk->data_free(chunk->data);
+  chunk->data = NULL;
+  chunk->data_free = NULL;
+}
+
+/*
+ * Releases the chunks that were completely written out, and adjusts the
+ * first pending chunk if it was written partially.
+ */
+static void
+log_proto_text_client_release_written(LogProtoTextClient *self, gsize written)
+{
+  while (self->head < self->count && written >= self->iov[self->head].iov_len)
+    {
+      written -= self->iov[self->head].iov_len;
+      log_proto_text_client_free_chunk(&self->chunks[self->head]);
+      self->head++;
+    }
+
+  if (self->head == self->count)
+    {
+      self->head = self->count = 0;
+    }
+  else if (written > 0)
+    {
+      self->iov[self->head].iov_base = (guchar *) self->iov[self->head].iov_base + written;
+      self->iov[self->head].iov_len -= written;
+    }
+}
+
+/* submits the pending chunks to the transport, returns the result of writev() */
+static gssize
+log_proto_text_client_write_pending(LogProtoTextClient *self)
+{
+  gssize rc;
+
+  rc = log_transport_writev(self->super.transport, &self->iov[self->head], self->count - self->head);
+  if (rc >= 0)
+    log_proto_text_client_release_written(self, rc);
+  return rc;
 }
 
 static LogProtoStatus
 log_proto_text_client_flush(LogProtoClient *s)
 {
   LogProtoTextClient *self = (LogProtoTextClient *) s;
-  gint rc;
+  gssize rc;
 
   /* attempt to flush previously buffered data */
-  if (self->partial)
-    {
-      gint len = self->partial_len - self->partial_pos;
+  if (self->head == self->count)
+    return LPS_SUCCESS;
 
-      rc = log_transport_write(self->super.transport, &self->partial[self->partial_pos], len);
-      if (rc < 0)
-        {
-          if (errno != EAGAIN && errno != EINTR)
-            {
-              msg_error("I/O error occurred while writing",
-                        evt_tag_int("fd", self->super.transport->fd),
-                        evt_tag_errno(EVT_TAG_OSERROR, errno),
-                        NULL);
-              return LPS_ERROR;
-            }
-          return LPS_SUCCESS;
-        }
-      else if (rc != len)
-        {
-          self->partial_pos += rc;
-          return LPS_SUCCESS;
-        }
-      else
+  rc = log_proto_text_client_write_pending(self);
+  if (rc < 0)
+    {
+      if (errno != EAGAIN && errno != EINTR)
         {
-          if (self->partial_free)
-            self->partial_free(self->partial);
-          self->partial = NULL;
-          if (self->next_state >= 0)
-            {
-              self->state = self->next_state;
-              self->next_state = -1;
-            }
-          /* NOTE: we return here to give a chance to the framed protocol to send the frame header. */
-          return LPS_SUCCESS;
+          msg_error("I/O error occurred while writing",
+                    evt_tag_int("fd", self->super.transport->fd),
+                    evt_tag_errno(EVT_TAG_OSERROR, errno),
+                    NULL);
+          return LPS_ERROR;
         }
+      return LPS_SUCCESS;
     }
   return LPS_SUCCESS;
 }
 
+/*
+ * log_proto_text_client_submit_write:
+ *
+ * Appends a chunk to the pending batch, which is submitted to the
+ * transport once it becomes full or when the writer flushes us.  If
+ * @msg_free is NULL, @msg is copied as the caller may reuse it right away.
+ **/
 LogProtoStatus
 log_proto_text_client_submit_write(LogProtoClient *s, guchar *msg, gsize msg_len, GDestroyNotify msg_free, gint next_state)
 {
   LogProtoTextClient *self = (LogProtoTextClient *) s;
+  LogProtoTextClientChunk *chunk;
 
-  g_assert(self->partial == NULL);
-  self->partial = msg;
-  self->partial_len = msg_len;
-  self->partial_pos = 0;
-  self->partial_free = msg_free;
-  self->next_state = next_state;
-  return log_proto_text_client_flush(s);
+  g_assert(!log_proto_text_client_is_full(self));
+
+  chunk = &self->chunks[self->count];
+  if (msg_free)
+    {
+      chunk->data = msg;
+      chunk->data_free = msg_free;
+      self->iov[self->count].iov_base = msg;
+    }
+  else if (msg_len <= sizeof(chunk->inline_data))
+    {
+      memcpy(chunk->inline_data, msg, msg_len);
+      self->iov[self->count].iov_base = chunk->inline_data;
+    }
+  else
+    {
+      chunk->data = g_memdup(msg, msg_len);
+      chunk->data_free = g_free;
+      self->iov[self->count].iov_base = chunk->data;
+    }
+  self->iov[self->count].iov_len = msg_len;
+  self->count++;
+
+  if (next_state >= 0)
+    self->state = next_state;
+
+  if (log_proto_text_client_is_full(self))
+    return log_proto_text_client_flush(s);
+  return LPS_SUCCESS;
 }
 
 
@@ -114,37 +177,75 @@ static LogProtoStatus
 log_proto_text_client_post(LogProtoClient *s, guchar *msg, gsize msg_len, gboolean *consumed)
 {
   LogProtoTextClient *self = (LogProtoTextClient *) s;
-  gint rc;
+  gint rc = LPS_SUCCESS;
 
-  /* try to flush already buffered data */
   *consumed = FALSE;
-  rc = log_proto_text_client_flush(s);
-  if (rc == LPS_ERROR)
+  if (log_proto_text_client_is_full(self))
     {
-      /* log_proto_flush() already logs in the case of an error */
-      return rc;
-    }
+      /* try to flush already buffered data */
+      rc = log_proto_text_client_flush(s);
+      if (rc == LPS_ERROR)
+        {
+          /* log_proto_flush() already logs in the case of an error */
+          return rc;
+        }
 
-  if (self->partial)
-    {
-      /* NOTE: the partial buffer has not been emptied yet even with the
-       * flush above, we shouldn't attempt to write again.
-       *
-       * Otherwise: with the framed protocol this could case the frame
-       * header to be split, and interleaved with message payload, as in:
-       *
-       *     First bytes of frame header || payload || tail of frame header.
-       *
-       * This obviously would cause the framing to break. Also libssl
-       * returns an error in this case, which is how this was discovered.
-       */
-      return rc;
+      /* NOTE: the batch has not been emptied yet even with the flush
+       * above, the caller needs to retry once the transport becomes
+       * writable again. */
+      if (log_proto_text_client_is_full(self))
+        return rc;
     }
 
   *consumed = TRUE;
   return log_proto_text_client_submit_write(s, msg, msg_len, (GDestroyNotify) g_free, -1);
 }
 
+/*
+ * Sets the number of chunks collected before they are submitted to the
+ * transport in a single writev() call.  Must be called while no chunks
+ * are pending.
+ */
+void
+log_proto_text_client_set_max_chunks(LogProtoTextClient *self, gint max_chunks)
+{
+  g_assert(self->count == 0);
+
+  self->max_chunks = CLAMP(max_chunks, 1, IOV_MAX);
+  self->iov = g_renew(struct iovec, self->iov, self->max_chunks);
+  self->chunks = g_renew(LogProtoTextClientChunk, self->chunks, self->max_chunks);
+  memset(self->chunks, 0, sizeof(self->chunks[0]) * self->max_chunks);
+}
+
+void
+log_proto_text_client_free_method(LogProtoClient *s)
+{
+  LogProtoTextClient *self = (LogProtoTextClient *) s;
+  gssize rc;
+  gint i;
+
+  /* the messages of the pending chunks were already reported as
+   * consumed, so write out as much as the transport accepts without
+   * blocking before it goes away */
+  while (self->head < self->count)
+    {
+      rc = log_proto_text_client_write_pending(self);
+      if (rc <= 0 && !(rc < 0 && errno == EINTR))
+        break;
+    }
+  if (self->head < self->count)
+    msg_notice("Dropping output not yet written to the destination",
+               evt_tag_int("fd", self->super.transport->fd),
+               evt_tag_int("pending_chunks", self->count - self->head),
+               NULL);
+
+  for (i = self->head; i < self->count; i++)
+    log_proto_text_client_free_chunk(&self->chunks[i]);
+  g_free(self->chunks);
+  g_free(self->iov);
+  log_proto_client_free_method(s);
+}
+
 void
 log_proto_text_client_init(LogProtoTextClient *self, LogTransport *transport, const LogProtoClientOptions *options)
 {
@@ -152,8 +253,9 @@ log_proto_text_client_init(LogProtoTextClient *self, LogTransport *transport, co
   self->super.prepare = log_proto_text_client_prepare;
   self->super.flush = log_proto_text_client_flush;
   self->super.post = log_proto_text_client_post;
+  self->super.free_fn = log_proto_text_client_free_method;
   self->super.transport = transport;
-  self->next_state = -1;
+  log_proto_text_client_set_max_chunks(self, options->flush_lines);
 }
 
 LogProtoClient *
@@ -26,19 +26,36 @@
 
 #include "logproto-client.h"
 
+#include <sys/uio.h>
+
+typedef struct _LogProtoTextClientChunk
+{
+  gpointer data;
+  GDestroyNotify data_free;
+  /* copy of short chunks that the caller doesn't hand over (e.g. frame headers) */
+  guchar inline_data[16];
+} LogProtoTextClientChunk;
+
 typedef struct _LogProtoTextClient
 {
   LogProtoClient super;
-  gint state, next_state;
-  guchar *partial;
-  GDestroyNotify partial_free;
-  gsize partial_len, partial_pos;
+  gint state;
+  /* chunks in the [head, count) range are waiting to be written */
+  struct iovec *iov;
+  LogProtoTextClientChunk *chunks;
+  gint head, count, max_chunks;
 } LogProtoTextClient;
 
+static inline gboolean
+log_proto_text_client_is_full(LogProtoTextClient *self)
+{
+  return self->count == self->max_chunks;
+}
+
 LogProtoStatus log_proto_text_client_submit_write(LogProtoClient *s, guchar *msg, gsize msg_len, GDestroyNotify msg_free, gint next_state);
+void log_proto_text_client_set_max_chunks(LogProtoTextClient *self, gint max_chunks);
 void log_proto_text_client_init(LogProtoTextClient *self, LogTransport *transport, const LogProtoClientOptions *options);
+void log_proto_text_client_free_method(LogProtoClient *s);
 LogProtoClient *log_proto_text_client_new(LogTransport *transport, const LogProtoClientOptions *options);
 
-#define log_proto_text_client_free_method log_proto_client_free_method
-
 #endif
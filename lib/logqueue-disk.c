@@ -0,0 +1,930 @@
+/*
+ * Copyright (c) 2002-2013 BalaBit IT Ltd, Budapest, Hungary
+ * Copyright (c) 1998-2013 Balázs Scheidler
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * As an additional exemption you are allowed to compile & link against the
+ * OpenSSL libraries as published by the OpenSSL project. See the file
+ * COPYING for details.
+ *
+ */
+
+#include "logqueue-disk.h"
+#include "logpipe.h"
+#include "messages.h"
+#include "serialize.h"
+#include "stats.h"
+#include "mainloop.h"
+#include "misc.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * LogQueueDisk is a LogQueue implementation that stores its contents in a
+ * preallocated, fixed size file used as a ring buffer, so that a
+ * destination can absorb a backlog much larger than what would fit into
+ * memory, and can survive restarts of syslog-ng.
+ *
+ * Messages flow through the queue as follows:
+ *
+ *    input queue (per-thread) -> disk ring (locked) -> output thread
+ *
+ * The input side is the same as with LogQueueFifo: input threads put their
+ * items on a per-thread, unlocked list, which is moved to the disk ring
+ * when the input thread finishes its poll iteration.  At that point the
+ * messages are serialized using log_msg_write() and the source is
+ * acknowledged, as the message is now safely stored.
+ *
+ * The output thread reads records from the ring and deserializes them
+ * using log_msg_read().  The area occupied by a record is only released
+ * once the message leaves the queue for good: either it was popped without
+ * push_to_backlog or it was acknowledged using log_queue_ack_backlog().
+ * Records that were popped but not yet released are replayed when the
+ * queue file is opened again after a restart.
+ *
+ * The ring state (head/tail positions and counters) is stored in a header
+ * at the beginning of the file, which is mapped into memory, the file name
+ * itself is recorded in the persist file using the queue's persist name.
+ *
+ * In-memory lists:
+ *   - qout: items that were put back using log_queue_push_head() or
+ *     log_queue_rewind_backlog(), these are consulted before the disk
+ *
+ *   - qbacklog: items that were popped with push_to_backlog and are
+ *     waiting for an ACK
+ *
+ * Threading assumptions are the same as for LogQueueFifo, the head of the
+ * queue (e.g. qout, qbacklog and reading the ring) is only manipulated
+ * from the output thread, the tail is manipulated from the input threads.
+ * The ring counters are shared and are protected by self->super.lock.
+ *
+ * NOTE: disk originated messages are released in the order they were read
+ * from the disk, so a consumer must not mix popping with and without
+ * push_to_backlog.
+ */
+
+#define QDISK_RESERVED_SPACE 4096
+#define QDISK_MIN_BUF_SIZE   (1024 * 1024)
+#define QDISK_FILE_VERSION   1
+#define QDISK_FILE_MAGIC     "SLQF"
+
+typedef struct _QDiskFileHeader
+{
+  gchar magic[4];
+  guint8 version;
+  guint8 big_endian;
+  guint8 __pad[2];
+
+  /* size of the ring area in bytes, it starts at QDISK_RESERVED_SPACE */
+  gint64 capacity;
+  /* the next record to be read by the output thread */
+  gint64 read_head;
+  /* the next record will be written here */
+  gint64 write_head;
+  /* the oldest record that was read but not released yet */
+  gint64 backlog_head;
+  /* number of bytes between backlog_head and write_head */
+  gint64 used;
+  /* number of records between read_head and write_head */
+  gint64 length;
+  /* number of records between backlog_head and read_head */
+  gint64 backlog_len;
+} QDiskFileHeader;
+
+typedef struct _LogQueueDiskNode
+{
+  struct iv_list_head list;
+  LogMessage *msg;
+  gboolean ack_needed:1, from_disk:1;
+} LogQueueDiskNode;
+
+typedef struct _LogQueueDisk
+{
+  LogQueue super;
+
+  gchar *filename;
+  gint fd;
+  gboolean reliable;
+  QDiskFileHeader *hdr;
+
+  /* protected by super.lock, used by the input threads */
+  GString *write_buffer;
+  /* only used by the output thread */
+  GString *read_buffer;
+
+  struct iv_list_head qout;
+  gint qout_len;
+  struct iv_list_head qbacklog;
+  gint qbacklog_len;
+
+  struct
+  {
+    struct iv_list_head items;
+    MainLoopIOWorkerFinishCallback cb;
+    guint16 len;
+    guint16 finish_cb_registered;
+  } qoverflow_input[0];
+} LogQueueDisk;
+
+static inline gint64
+log_queue_disk_advance(LogQueueDisk *self, gint64 pos, gint64 n)
+{
+  pos += n;
+  if (pos >= self->hdr->capacity)
+    pos -= self->hdr->capacity;
+  return pos;
+}
+
+/* write @len bytes to the ring at position @pos, wrapping around at the end of the ring */
+static gboolean
+log_queue_disk_pwrite(LogQueueDisk *self, gint64 pos, const gchar *buf, gsize len)
+{
+  gsize chunk = MIN(len, self->hdr->capacity - pos);
+
+  if (pwrite(self->fd, buf, chunk, QDISK_RESERVED_SPACE + pos) != chunk)
+    return FALSE;
+  if (chunk < len &&
+      pwrite(self->fd, buf + chunk, len - chunk, QDISK_RESERVED_SPACE) != len - chunk)
+    return FALSE;
+  return TRUE;
+}
+
+static gboolean
+log_queue_disk_pread(LogQueueDisk *self, gint64 pos, gchar *buf, gsize len)
+{
+  gsize chunk = MIN(len, self->hdr->capacity - pos);
+
+  if (pread(self->fd, buf, chunk, QDISK_RESERVED_SPACE + pos) != chunk)
+    return FALSE;
+  if (chunk < len &&
+      pread(self->fd, buf + chunk, len - chunk, QDISK_RESERVED_SPACE) != len - chunk)
+    return FALSE;
+  return TRUE;
+}
+
+static gboolean
+log_queue_disk_read_record_length(LogQueueDisk *self, gint64 pos, guint32 *record_len)
+{
+  guint32 n;
+
+  if (!log_queue_disk_pread(self, pos, (gchar *) &n, sizeof(n)))
+    return FALSE;
+  *record_len = GUINT32_FROM_BE(n);
+  return TRUE;
+}
+
+static void
+log_queue_disk_forget_disk_origin(struct iv_list_head *q)
+{
+  struct iv_list_head *pos;
+
+  iv_list_for_each(pos, q)
+    {
+      LogQueueDiskNode *node = iv_list_entry(pos, LogQueueDiskNode, list);
+
+      node->from_disk = FALSE;
+    }
+}
+
+/*
+ * Drops everything stored on disk, used when the queue file is found to
+ * be corrupted.  Messages already read into memory are kept, but they
+ * don't refer to the ring anymore.
+ *
+ * Can only run from the output thread.
+ */
+static void
+log_queue_disk_truncate(LogQueueDisk *self)
+{
+  msg_error("Disk queue file is corrupted, dropping its contents",
+            evt_tag_str("filename", self->filename),
+            evt_tag_int("lost", self->hdr->length),
+            NULL);
+
+  g_static_mutex_lock(&self->super.lock);
+  stats_counter_add(self->super.stored_messages, -self->hdr->length);
+  stats_counter_add(self->super.dropped_messages, self->hdr->length);
+  self->hdr->read_head = self->hdr->write_head = self->hdr->backlog_head = 0;
+  self->hdr->used = 0;
+  self->hdr->length = 0;
+  self->hdr->backlog_len = 0;
+  g_static_mutex_unlock(&self->super.lock);
+
+  log_queue_disk_forget_disk_origin(&self->qout);
+  log_queue_disk_forget_disk_origin(&self->qbacklog);
+}
+
+static void
+log_queue_disk_sync(LogQueueDisk *self)
+{
+  msync(self->hdr, QDISK_RESERVED_SPACE, MS_SYNC);
+  fdatasync(self->fd);
+}
+
+/* NOTE: this is inherently racy, see log_queue_fifo_get_length() */
+static gint64
+log_queue_disk_get_length(LogQueue *s)
+{
+  LogQueueDisk *self = (LogQueueDisk *) s;
+
+  return self->qout_len + self->hdr->length;
+}
+
+/* NOTE: this is inherently racy, can only be called if log processing is suspended (e.g. reload time) */
+static gboolean
+log_queue_disk_keep_on_reload(LogQueue *s)
+{
+  return log_queue_disk_get_length(s) > 0;
+}
+
+/*
+ * Serializes @msg and appends it to the ring, returns FALSE if it
+ * didn't fit or writing the file failed.
+ *
+ * NOTE: self->super.lock must be held when calling this function
+ */
+static gboolean
+log_queue_disk_write_message_unlocked(LogQueueDisk *self, LogMessage *msg)
+{
+  SerializeArchive *sa;
+  guint32 n;
+  gsize record_len;
+
+  g_string_truncate(self->write_buffer, 0);
+  /* placeholder for the length of the record */
+  g_string_append_len(self->write_buffer, (gchar *) &n, sizeof(n));
+
+  sa = serialize_string_archive_new(self->write_buffer);
+  if (!log_msg_write(msg, sa))
+    {
+      serialize_archive_free(sa);
+      msg_error("Error serializing message for the disk queue, dropping message",
+                evt_tag_str("filename", self->filename),
+                NULL);
+      return FALSE;
+    }
+  serialize_archive_free(sa);
+
+  record_len = self->write_buffer->len;
+  if (record_len > self->hdr->capacity - self->hdr->used)
+    return FALSE;
+
+  n = GUINT32_TO_BE(record_len - sizeof(n));
+  memcpy(self->write_buffer->str, &n, sizeof(n));
+
+  if (!log_queue_disk_pwrite(self, self->hdr->write_head, self->write_buffer->str, record_len))
+    {
+      msg_error("Error writing disk queue file",
+                evt_tag_str("filename", self->filename),
+                evt_tag_errno(EVT_TAG_OSERROR, errno),
+                NULL);
+      return FALSE;
+    }
+
+  self->hdr->write_head = log_queue_disk_advance(self, self->hdr->write_head, record_len);
+  self->hdr->used += record_len;
+  self->hdr->length++;
+  return TRUE;
+}
+
+/* move items from the per-thread input queue to the disk
+ *
+ * NOTE: self->super.lock must be held when calling this function */
+static void
+log_queue_disk_move_input_unlocked(LogQueueDisk *self, gint thread_id)
+{
+  struct iv_list_head *pos, *next;
+  gint stored = 0, dropped = 0;
+
+  iv_list_for_each_safe(pos, next, &self->qoverflow_input[thread_id].items)
+    {
+      LogMessageQueueNode *node = iv_list_entry(pos, LogMessageQueueNode, list);
+
+      if (log_queue_disk_write_message_unlocked(self, node->msg))
+        stored++;
+      else
+        dropped++;
+    }
+
+  if (self->reliable && stored > 0)
+    log_queue_disk_sync(self);
+
+  stats_counter_add(self->super.stored_messages, stored);
+  if (dropped)
+    {
+      stats_counter_add(self->super.dropped_messages, dropped);
+      msg_debug("Destination disk queue full, dropping messages",
+                evt_tag_str("filename", self->filename),
+                evt_tag_int("queue_len", self->hdr->length),
+                evt_tag_int("count", dropped),
+                NULL);
+    }
+
+  /* the messages are safely stored on disk (or were dropped), ack them */
+  while (!iv_list_empty(&self->qoverflow_input[thread_id].items))
+    {
+      LogMessageQueueNode *node = iv_list_entry(self->qoverflow_input[thread_id].items.next, LogMessageQueueNode, list);
+      LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
+      LogMessage *msg;
+
+      iv_list_del(&node->list);
+      msg = node->msg;
+      path_options.ack_needed = node->ack_needed;
+      log_msg_free_queue_node(node);
+      log_msg_drop(msg, &path_options);
+    }
+  self->qoverflow_input[thread_id].len = 0;
+}
+
+/* move items from the per-thread input queue to the disk, grabbing
+ * locks first. This is registered as a callback to be called when the
+ * input worker thread finishes its job.
+ */
+static gpointer
+log_queue_disk_move_input(gpointer user_data)
+{
+  LogQueueDisk *self = (LogQueueDisk *) user_data;
+  gint thread_id;
+
+  thread_id = main_loop_io_worker_thread_id();
+
+  g_assert(thread_id >= 0);
+
+  g_static_mutex_lock(&self->super.lock);
+  log_queue_disk_move_input_unlocked(self, thread_id);
+  log_queue_push_notify(&self->super);
+  g_static_mutex_unlock(&self->super.lock);
+  self->qoverflow_input[thread_id].finish_cb_registered = FALSE;
+  return NULL;
+}
+
+/*
+ * Assumed to be called from one of the input threads. If the thread_id
+ * cannot be determined, the item is written to the disk directly.
+ *
+ * NOTE: It consumes the reference passed by the caller.
+ */
+static void
+log_queue_disk_push_tail(LogQueue *s, LogMessage *msg, const LogPathOptions *path_options)
+{
+  LogQueueDisk *self = (LogQueueDisk *) s;
+  LogMessageQueueNode *node;
+  gint thread_id;
+
+  thread_id = main_loop_io_worker_thread_id();
+
+  g_assert(thread_id < 0 || log_queue_max_threads > thread_id);
+
+  if (thread_id >= 0)
+    {
+      /* fastpath, use per-thread input FIFOs, see log_queue_fifo_push_tail() */
+      if (!self->qoverflow_input[thread_id].finish_cb_registered)
+        {
+          main_loop_io_worker_register_finish_callback(&self->qoverflow_input[thread_id].cb);
+          self->qoverflow_input[thread_id].finish_cb_registered = TRUE;
+        }
+
+      node = log_msg_alloc_queue_node(msg, path_options);
+      iv_list_add_tail(&node->list, &self->qoverflow_input[thread_id].items);
+      self->qoverflow_input[thread_id].len++;
+      log_msg_unref(msg);
+      return;
+    }
+
+  /* slow path, write the message to the disk right away */
+  g_static_mutex_lock(&self->super.lock);
+  if (log_queue_disk_write_message_unlocked(self, msg))
+    {
+      if (self->reliable)
+        log_queue_disk_sync(self);
+      stats_counter_inc(self->super.stored_messages);
+      log_queue_push_notify(&self->super);
+    }
+  else
+    {
+      stats_counter_inc(self->super.dropped_messages);
+      msg_debug("Destination disk queue full, dropping message",
+                evt_tag_str("filename", self->filename),
+                evt_tag_int("queue_len", self->hdr->length),
+                NULL);
+    }
+  g_static_mutex_unlock(&self->super.lock);
+  log_msg_drop(msg, path_options);
+}
+
+static LogQueueDiskNode *
+log_queue_disk_node_new(LogMessage *msg, gboolean ack_needed, gboolean from_disk)
+{
+  LogQueueDiskNode *node = g_slice_new(LogQueueDiskNode);
+
+  node->msg = msg;
+  node->ack_needed = ack_needed;
+  node->from_disk = from_disk;
+  return node;
+}
+
+static void
+log_queue_disk_node_free(LogQueueDiskNode *node)
+{
+  g_slice_free(LogQueueDiskNode, node);
+}
+
+/*
+ * Put an item back to the front of the queue. Such items are only
+ * stored in memory.
+ *
+ * This is assumed to be called only from the output thread.
+ *
+ * NOTE: It consumes the reference passed by the caller.
+ */
+static void
+log_queue_disk_push_head(LogQueue *s, LogMessage *msg, const LogPathOptions *path_options)
+{
+  LogQueueDisk *self = (LogQueueDisk *) s;
+  LogQueueDiskNode *node;
+
+  node = log_queue_disk_node_new(msg, path_options->ack_needed, FALSE);
+  iv_list_add(&node->list, &self->qout);
+  self->qout_len++;
+
+  stats_counter_inc(self->super.stored_messages);
+}
+
+/*
+ * Releases the oldest record that was read from the disk but was
+ * retained as it could have been rewound.
+ *
+ * Can only run from the output thread.
+ */
+static void
+log_queue_disk_release_record(LogQueueDisk *self)
+{
+  guint32 record_len;
+
+  if (!log_queue_disk_read_record_length(self, self->hdr->backlog_head, &record_len))
+    {
+      log_queue_disk_truncate(self);
+      return;
+    }
+
+  g_static_mutex_lock(&self->super.lock);
+  self->hdr->backlog_head = log_queue_disk_advance(self, self->hdr->backlog_head, record_len + sizeof(guint32));
+  self->hdr->used -= record_len + sizeof(guint32);
+  self->hdr->backlog_len--;
+  g_static_mutex_unlock(&self->super.lock);
+}
+
+/*
+ * Reads the next record from the ring and advances read_head.
+ *
+ * Can only run from the output thread.
+ */
+static LogMessage *
+log_queue_disk_read_message(LogQueueDisk *self)
+{
+  SerializeArchive *sa;
+  LogMessage *msg;
+  guint32 record_len;
+  gint64 read_head;
+  gboolean success;
+
+  g_static_mutex_lock(&self->super.lock);
+  read_head = self->hdr->read_head;
+  success = self->hdr->length > 0;
+  g_static_mutex_unlock(&self->super.lock);
+
+  if (!success)
+    return NULL;
+
+  /* the area between read_head and write_head is not touched by the input threads */
+  if (!log_queue_disk_read_record_length(self, read_head, &record_len) ||
+      record_len + sizeof(guint32) > self->hdr->used)
+    {
+      log_queue_disk_truncate(self);
+      return NULL;
+    }
+
+  g_string_set_size(self->read_buffer, record_len);
+  if (!log_queue_disk_pread(self, log_queue_disk_advance(self, read_head, sizeof(guint32)), self->read_buffer->str, record_len))
+    {
+      msg_error("Error reading disk queue file",
+                evt_tag_str("filename", self->filename),
+                evt_tag_errno(EVT_TAG_OSERROR, errno),
+                NULL);
+      log_queue_disk_truncate(self);
+      return NULL;
+    }
+
+  msg = log_msg_new_empty();
+  sa = serialize_buffer_archive_new(self->read_buffer->str, record_len);
+  success = log_msg_read(msg, sa);
+  serialize_archive_free(sa);
+
+  if (!success)
+    {
+      log_msg_unref(msg);
+      log_queue_disk_truncate(self);
+      return NULL;
+    }
+
+  g_static_mutex_lock(&self->super.lock);
+  self->hdr->read_head = log_queue_disk_advance(self, read_head, record_len + sizeof(guint32));
+  self->hdr->length--;
+  self->hdr->backlog_len++;
+  g_static_mutex_unlock(&self->super.lock);
+  return msg;
+}
+
+/*
+ * Can only run from the output thread.
+ *
+ * NOTE: this returns a reference which the caller must take care to free.
+ */
+static gboolean
+log_queue_disk_pop_head(LogQueue *s, LogMessage **msg, LogPathOptions *path_options, gboolean push_to_backlog, gboolean ignore_throttle)
+{
+  LogQueueDisk *self = (LogQueueDisk *) s;
+  LogQueueDiskNode *node;
+
+  if (!ignore_throttle && self->super.throttle && self->super.throttle_buckets == 0)
+    {
+      return FALSE;
+    }
+
+  if (self->qout_len > 0)
+    {
+      node = iv_list_entry(self->qout.next, LogQueueDiskNode, list);
+      iv_list_del(&node->list);
+      self->qout_len--;
+    }
+  else
+    {
+      LogMessage *m;
+
+      m = log_queue_disk_read_message(self);
+      if (!m)
+        return FALSE;
+      node = log_queue_disk_node_new(m, FALSE, TRUE);
+    }
+  stats_counter_dec(self->super.stored_messages);
+
+  *msg = node->msg;
+  path_options->ack_needed = node->ack_needed;
+  if (push_to_backlog)
+    {
+      log_msg_ref(*msg);
+      iv_list_add_tail(&node->list, &self->qbacklog);
+      self->qbacklog_len++;
+    }
+  else
+    {
+      if (node->from_disk)
+        log_queue_disk_release_record(self);
+      log_queue_disk_node_free(node);
+    }
+
+  if (!ignore_throttle && self->super.throttle_buckets > 0)
+    {
+      self->super.throttle_buckets--;
+    }
+
+  return TRUE;
+}
+
+/*
+ * Can only run from the output thread.
+ */
+static void
+log_queue_disk_ack_backlog(LogQueue *s, gint n)
+{
+  LogQueueDisk *self = (LogQueueDisk *) s;
+  LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
+  gint i;
+
+  for (i = 0; i < n && self->qbacklog_len > 0; i++)
+    {
+      LogQueueDiskNode *node;
+      LogMessage *msg;
+
+      node = iv_list_entry(self->qbacklog.next, LogQueueDiskNode, list);
+      msg = node->msg;
+      path_options.ack_needed = node->ack_needed;
+
+      iv_list_del(&node->list);
+      self->qbacklog_len--;
+      if (node->from_disk)
+        log_queue_disk_release_record(self);
+      log_queue_disk_node_free(node);
+
+      log_msg_ack(msg, &path_options);
+      log_msg_unref(msg);
+    }
+}
+
+/*
+ * Move items on our backlog back to the front of the queue.  Disk
+ * originated items are not reread from the disk, they remain reserved
+ * there until they are released.
+ *
+ * NOTE: this is assumed to be called from the output thread.
+ */
+static void
+log_queue_disk_rewind_backlog(LogQueue *s)
+{
+  LogQueueDisk *self = (LogQueueDisk *) s;
+
+  iv_list_splice_init(&self->qbacklog, &self->qout);
+  self->qout_len += self->qbacklog_len;
+  stats_counter_add(self->super.stored_messages, self->qbacklog_len);
+  self->qbacklog_len = 0;
+}
+
+static void
+log_queue_disk_free_queue(struct iv_list_head *q)
+{
+  while (!iv_list_empty(q))
+    {
+      LogQueueDiskNode *node;
+      LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
+      LogMessage *msg;
+
+      node = iv_list_entry(q->next, LogQueueDiskNode, list);
+      iv_list_del(&node->list);
+
+      /* disk originated items are not released, they are replayed
+       * when the queue file is opened next time */
+      path_options.ack_needed = node->ack_needed;
+      msg = node->msg;
+      log_queue_disk_node_free(node);
+      log_msg_ack(msg, &path_options);
+      log_msg_unref(msg);
+    }
+}
+
+static void
+log_queue_disk_free(LogQueue *s)
+{
+  LogQueueDisk *self = (LogQueueDisk *) s;
+  gint i;
+
+  /* write out whatever is pending on the input queues */
+  g_static_mutex_lock(&self->super.lock);
+  for (i = 0; i < log_queue_max_threads; i++)
+    log_queue_disk_move_input_unlocked(self, i);
+  g_static_mutex_unlock(&self->super.lock);
+
+  log_queue_disk_free_queue(&self->qout);
+  log_queue_disk_free_queue(&self->qbacklog);
+
+  log_queue_disk_sync(self);
+  munmap((void *) self->hdr, QDISK_RESERVED_SPACE);
+  close(self->fd);
+
+  g_string_free(self->write_buffer, TRUE);
+  g_string_free(self->read_buffer, TRUE);
+  g_free(self->filename);
+  log_queue_free_method(s);
+}
+
+static gboolean
+log_queue_disk_load_header(LogQueueDisk *self)
+{
+  QDiskFileHeader *hdr = self->hdr;
+
+  if (memcmp(hdr->magic, QDISK_FILE_MAGIC, 4) != 0 ||
+      hdr->version != QDISK_FILE_VERSION)
+    {
+      msg_error("Invalid disk queue file header",
+                evt_tag_str("filename", self->filename),
+                NULL);
+      return FALSE;
+    }
+  if (hdr->big_endian != (G_BYTE_ORDER == G_BIG_ENDIAN))
+    {
+      msg_error("Disk queue file was created on a host with a different byte order",
+                evt_tag_str("filename", self->filename),
+                NULL);
+      return FALSE;
+    }
+  if (hdr->capacity <= 0 ||
+      hdr->used < 0 || hdr->used > hdr->capacity ||
+      hdr->read_head < 0 || hdr->read_head >= hdr->capacity ||
+      hdr->write_head < 0 || hdr->write_head >= hdr->capacity ||
+      hdr->backlog_head < 0 || hdr->backlog_head >= hdr->capacity)
+    {
+      msg_error("Inconsistent disk queue file header",
+                evt_tag_str("filename", self->filename),
+                NULL);
+      return FALSE;
+    }
+
+  /* items that were read but not acknowledged are to be sent again */
+  hdr->read_head = hdr->backlog_head;
+  hdr->length += hdr->backlog_len;
+  hdr->backlog_len = 0;
+
+  msg_verbose("Disk queue file reopened",
+              evt_tag_str("filename", self->filename),
+              evt_tag_int("queue_length", hdr->length),
+              NULL);
+  return TRUE;
+}
+
+static void
+log_queue_disk_init_header(LogQueueDisk *self, gint64 capacity)
+{
+  QDiskFileHeader *hdr = self->hdr;
+
+  memset(hdr, 0, sizeof(*hdr));
+  memcpy(hdr->magic, QDISK_FILE_MAGIC, 4);
+  hdr->version = QDISK_FILE_VERSION;
+  hdr->big_endian = (G_BYTE_ORDER == G_BIG_ENDIAN);
+  hdr->capacity = capacity;
+}
+
+static gboolean
+log_queue_disk_open_file(LogQueueDisk *self, gint64 capacity, gboolean create)
+{
+  gpointer p;
+
+  if (create)
+    self->fd = open(self->filename, O_RDWR | O_CREAT | O_EXCL, 0600);
+  else
+    self->fd = open(self->filename, O_RDWR);
+
+  if (self->fd < 0)
+    {
+      if (!create || errno != EEXIST)
+        msg_error("Error opening disk queue file",
+                  evt_tag_str("filename", self->filename),
+                  evt_tag_errno(EVT_TAG_OSERROR, errno),
+                  NULL);
+      return FALSE;
+    }
+  g_fd_set_cloexec(self->fd, TRUE);
+
+  if (create && ftruncate(self->fd, QDISK_RESERVED_SPACE + capacity) < 0)
+    {
+      msg_error("Error allocating disk queue file",
+                evt_tag_str("filename", self->filename),
+                evt_tag_errno(EVT_TAG_OSERROR, errno),
+                NULL);
+      goto error;
+    }
+
+  p = mmap(NULL, QDISK_RESERVED_SPACE, PROT_READ | PROT_WRITE, MAP_SHARED, self->fd, 0);
+  if (p == MAP_FAILED)
+    {
+      msg_error("Error mapping disk queue file header",
+                evt_tag_str("filename", self->filename),
+                evt_tag_errno(EVT_TAG_OSERROR, errno),
+                NULL);
+      goto error;
+    }
+  self->hdr = (QDiskFileHeader *) p;
+
+  if (create)
+    log_queue_disk_init_header(self, capacity);
+  else if (!log_queue_disk_load_header(self))
+    {
+      munmap(p, QDISK_RESERVED_SPACE);
+      self->hdr = NULL;
+      goto error;
+    }
+  return TRUE;
+
+ error:
+  close(self->fd);
+  self->fd = -1;
+  if (create)
+    unlink(self->filename);
+  return FALSE;
+}
+
+/* allocates a new, unused queue file name in @dir and creates the file */
+static gboolean
+log_queue_disk_create_file(LogQueueDisk *self, const gchar *dir, gint64 capacity)
+{
+  gint i;
+
+  for (i = 0; i < 100000; i++)
+    {
+      self->filename = g_strdup_printf("%s/syslog-ng-%05d.qf", dir, i);
+      if (log_queue_disk_open_file(self, capacity, TRUE))
+        return TRUE;
+      g_free(self->filename);
+      self->filename = NULL;
+      if (errno != EEXIST)
+        break;
+    }
+  return FALSE;
+}
+
+LogQueue *
+log_queue_disk_new(LogQueueDiskOptions *options, const gchar *persist_name, PersistState *state)
+{
+  LogQueueDisk *self;
+  gchar *qfile_key;
+  gint64 capacity;
+  gint i;
+
+  g_assert(persist_name != NULL);
+
+  self = g_malloc0(sizeof(LogQueueDisk) + log_queue_max_threads * sizeof(self->qoverflow_input[0]));
+  self->fd = -1;
+  self->reliable = options->reliable;
+
+  capacity = MAX(options->disk_buf_size, QDISK_MIN_BUF_SIZE);
+  qfile_key = g_strdup_printf("%s_qfile", persist_name);
+  self->filename = persist_state_lookup_string(state, qfile_key, NULL, NULL);
+  if (self->filename && !log_queue_disk_open_file(self, capacity, FALSE))
+    {
+      msg_error("Error reopening disk queue file, creating a new one, messages in the old file are lost",
+                evt_tag_str("filename", self->filename),
+                evt_tag_str("persist_name", persist_name),
+                NULL);
+      g_free(self->filename);
+      self->filename = NULL;
+    }
+  if (!self->filename)
+    {
+      if (!log_queue_disk_create_file(self, options->dir ? options->dir : PATH_QDISK, capacity))
+        {
+          msg_error("Error creating disk queue file",
+                    evt_tag_str("dir", options->dir ? options->dir : PATH_QDISK),
+                    evt_tag_str("persist_name", persist_name),
+                    NULL);
+          g_free(qfile_key);
+          g_free(self);
+          return NULL;
+        }
+      persist_state_alloc_string(state, qfile_key, self->filename, -1);
+    }
+  g_free(qfile_key);
+
+  log_queue_init_instance(&self->super, persist_name);
+  self->super.get_length = log_queue_disk_get_length;
+  self->super.keep_on_reload = log_queue_disk_keep_on_reload;
+  self->super.push_tail = log_queue_disk_push_tail;
+  self->super.push_head = log_queue_disk_push_head;
+  self->super.pop_head = log_queue_disk_pop_head;
+  self->super.ack_backlog = log_queue_disk_ack_backlog;
+  self->super.rewind_backlog = log_queue_disk_rewind_backlog;
+
+  self->super.free_fn = log_queue_disk_free;
+
+  for (i = 0; i < log_queue_max_threads; i++)
+    {
+      INIT_IV_LIST_HEAD(&self->qoverflow_input[i].items);
+      main_loop_io_worker_finish_callback_init(&self->qoverflow_input[i].cb);
+      self->qoverflow_input[i].cb.user_data = self;
+      self->qoverflow_input[i].cb.func = log_queue_disk_move_input;
+    }
+  INIT_IV_LIST_HEAD(&self->qout);
+  INIT_IV_LIST_HEAD(&self->qbacklog);
+
+  self->write_buffer = g_string_sized_new(1024);
+  self->read_buffer = g_string_sized_new(1024);
+  return &self->super;
+}
+
+void
+log_queue_disk_options_defaults(LogQueueDiskOptions *options)
+{
+  options->disk_buf_size = 0;
+  options->reliable = FALSE;
+  options->dir = NULL;
+}
+
+void
+log_queue_disk_options_set_dir(LogQueueDiskOptions *options, const gchar *dir)
+{
+  g_free(options->dir);
+  options->dir = g_strdup(dir);
+}
+
+void
+log_queue_disk_options_destroy(LogQueueDiskOptions *options)
+{
+  g_free(options->dir);
+  options->dir = NULL;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2002-2013 BalaBit IT Ltd, Budapest, Hungary
+ * Copyright (c) 1998-2013 Balázs Scheidler
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * As an additional exemption you are allowed to compile & link against the
+ * OpenSSL libraries as published by the OpenSSL project. See the file
+ * COPYING for details.
+ *
+ */
+
+#ifndef LOGQUEUE_DISK_H_INCLUDED
+#define LOGQUEUE_DISK_H_INCLUDED
+
+#include "logqueue.h"
+#include "persist-state.h"
+
+typedef struct _LogQueueDiskOptions
+{
+  /* size of the on-disk ring in bytes, 0 means the disk buffer is disabled */
+  gint64 disk_buf_size;
+  /* sync the queue file before acknowledging messages */
+  gboolean reliable;
+  gchar *dir;
+} LogQueueDiskOptions;
+
+void log_queue_disk_options_defaults(LogQueueDiskOptions *options);
+void log_queue_disk_options_set_dir(LogQueueDiskOptions *options, const gchar *dir);
+void log_queue_disk_options_destroy(LogQueueDiskOptions *options);
+
+LogQueue *log_queue_disk_new(LogQueueDiskOptions *options, const gchar *persist_name, PersistState *state);
+
+#endif
@@ -377,6 +377,93 @@ log_queue_fifo_pop_head(LogQueue *s, LogMessage **msg, LogPathOptions *path_opti
   return TRUE;
 }
 
+/* moves the run of nodes starting at the head of @from and ending at @last to the tail of @to */
+static inline void
+log_queue_fifo_move_run(struct iv_list_head *from, struct iv_list_head *last, struct iv_list_head *to)
+{
+  struct iv_list_head *first = from->next;
+
+  from->next = last->next;
+  last->next->prev = from;
+
+  first->prev = to->prev;
+  to->prev->next = first;
+  last->next = to;
+  to->prev = last;
+}
+
+/*
+ * Can only run from the output thread.
+ *
+ * Pops a run of at most @max_msgs elements with a single refill of the
+ * output queue. When pushing to the backlog, the whole run is moved
+ * there at once instead of relinking the nodes one-by-one.
+ *
+ * NOTE: this returns references which the caller must take care to free.
+ */
+static gint
+log_queue_fifo_pop_batch(LogQueue *s, LogMessage **msgs, LogPathOptions *path_options, gint max_msgs, gboolean push_to_backlog, gboolean ignore_throttle)
+{
+  LogQueueFifo *self = (LogQueueFifo *) s;
+  struct iv_list_head *pos, *last = NULL;
+  gint n, i;
+
+  if (!ignore_throttle && self->super.throttle)
+    max_msgs = MIN(max_msgs, self->super.throttle_buckets);
+
+  if (max_msgs <= 0)
+    return 0;
+
+  if (self->qoverflow_output_len == 0)
+    {
+      /* slow path, output queue is empty, get some elements from the wait queue */
+      g_static_mutex_lock(&self->super.lock);
+      iv_list_splice_tail_init(&self->qoverflow_wait, &self->qoverflow_output);
+      self->qoverflow_output_len = self->qoverflow_wait_len;
+      self->qoverflow_wait_len = 0;
+      g_static_mutex_unlock(&self->super.lock);
+    }
+
+  n = MIN(max_msgs, self->qoverflow_output_len);
+  if (n == 0)
+    return 0;
+
+  for (i = 0, pos = self->qoverflow_output.next; i < n; i++, pos = pos->next)
+    {
+      LogMessageQueueNode *node = iv_list_entry(pos, LogMessageQueueNode, list);
+      LogPathOptions local_options = LOG_PATH_OPTIONS_INIT;
+
+      msgs[i] = node->msg;
+      local_options.ack_needed = node->ack_needed;
+      path_options[i] = local_options;
+      last = pos;
+    }
+  self->qoverflow_output_len -= n;
+  stats_counter_add(self->super.stored_messages, -n);
+
+  if (!ignore_throttle && self->super.throttle_buckets > 0)
+    self->super.throttle_buckets -= MIN(n, self->super.throttle_buckets);
+
+  if (push_to_backlog)
+    {
+      log_queue_fifo_move_run(&self->qoverflow_output, last, &self->qbacklog);
+      self->qbacklog_len += n;
+      for (i = 0; i < n; i++)
+        log_msg_ref(msgs[i]);
+    }
+  else
+    {
+      for (i = 0; i < n; i++)
+        {
+          LogMessageQueueNode *node = iv_list_entry(self->qoverflow_output.next, LogMessageQueueNode, list);
+
+          iv_list_del(&node->list);
+          log_msg_free_queue_node(node);
+        }
+    }
+  return n;
+}
+
 /*
  * Can only run from the output thread.
  */
@@ -386,19 +473,39 @@ log_queue_fifo_ack_backlog(LogQueue *s, gint n)
   LogQueueFifo *self = (LogQueueFifo *) s;
   LogMessage *msg;
   LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
+  struct iv_list_head acked, *last;
   gint i;
 
-  for (i = 0; i < n && self->qbacklog_len > 0; i++)
+  if (n <= 0 || self->qbacklog_len == 0)
+    return;
+
+  /* detach the acked run from the backlog first, if the whole backlog
+   * is acked (the common case for batching consumers), that's a single
+   * splice */
+  INIT_IV_LIST_HEAD(&acked);
+  if (n >= self->qbacklog_len)
+    {
+      iv_list_splice_tail_init(&self->qbacklog, &acked);
+      self->qbacklog_len = 0;
+    }
+  else
+    {
+      for (i = 1, last = self->qbacklog.next; i < n; i++)
+        last = last->next;
+      log_queue_fifo_move_run(&self->qbacklog, last, &acked);
+      self->qbacklog_len -= n;
+    }
+
+  while (!iv_list_empty(&acked))
     {
       LogMessageQueueNode *node;
 
-      node = iv_list_entry(self->qbacklog.next, LogMessageQueueNode, list);
+      node = iv_list_entry(acked.next, LogMessageQueueNode, list);
       msg = node->msg;
       path_options.ack_needed = node->ack_needed;
 
       iv_list_del(&node->list);
       log_msg_free_queue_node(node);
-      self->qbacklog_len--;
 
       log_msg_ack(msg, &path_options);
       log_msg_unref(msg);
@@ -476,6 +583,7 @@ log_queue_fifo_new(gint qoverflow_size, const gchar *persist_name)
   self->super.push_tail = log_queue_fifo_push_tail;
   self->super.push_head = log_queue_fifo_push_head;
   self->super.pop_head = log_queue_fifo_pop_head;
+  self->super.pop_batch = log_queue_fifo_pop_batch;
   self->super.ack_backlog = log_queue_fifo_ack_backlog;
   self->super.rewind_backlog = log_queue_fifo_rewind_backlog;
 
@@ -23,6 +23,7 @@
  */
 
 #include "logqueue.h"
+#include "logpipe.h"
 #include "stats.h"
 #include "messages.h"
 
@@ -175,11 +176,29 @@ log_queue_set_counters(LogQueue *self, StatsCounterItem *stored_messages, StatsC
   stats_counter_set(self->stored_messages, log_queue_get_length(self));
 }
 
+/* generic pop_batch() implementation for queues without a native one */
+gint
+log_queue_pop_batch_method(LogQueue *self, LogMessage **msgs, LogPathOptions *path_options, gint max_msgs, gboolean push_to_backlog, gboolean ignore_throttle)
+{
+  gint n = 0;
+
+  while (n < max_msgs)
+    {
+      LogPathOptions local_options = LOG_PATH_OPTIONS_INIT;
+
+      if (!log_queue_pop_head(self, &msgs[n], &local_options, push_to_backlog, ignore_throttle))
+        break;
+      path_options[n++] = local_options;
+    }
+  return n;
+}
+
 void
 log_queue_init_instance(LogQueue *self, const gchar *persist_name)
 {
   self->ref_cnt = 1;
   self->free_fn = log_queue_free_method;
+  self->pop_batch = log_queue_pop_batch_method;
 
   self->persist_name = persist_name ? g_strdup(persist_name) : NULL;
   g_static_mutex_init(&self->lock);
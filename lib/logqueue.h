@@ -58,6 +58,7 @@ struct _LogQueue
   void (*push_tail)(LogQueue *self, LogMessage *msg, const LogPathOptions *path_options);
   void (*push_head)(LogQueue *self, LogMessage *msg, const LogPathOptions *path_options);
   gboolean (*pop_head)(LogQueue *self, LogMessage **msg, LogPathOptions *path_options, gboolean push_to_backlog, gboolean ignore_throttle);
+  gint (*pop_batch)(LogQueue *self, LogMessage **msgs, LogPathOptions *path_options, gint max_msgs, gboolean push_to_backlog, gboolean ignore_throttle);
   void (*ack_backlog)(LogQueue *self, gint n);
   void (*rewind_backlog)(LogQueue *self);
 
@@ -96,6 +97,18 @@ log_queue_pop_head(LogQueue *self, LogMessage **msg, LogPathOptions *path_option
   return self->pop_head(self, msg, path_options, push_to_backlog, ignore_throttle);
 }
 
+/*
+ * Pops at most @max_msgs messages into @msgs, the corresponding
+ * ack_needed flags are returned in the @path_options array. Returns
+ * the number of messages popped, each of which is a reference the
+ * caller must take care to free, just like with log_queue_pop_head().
+ */
+static inline gint
+log_queue_pop_batch(LogQueue *self, LogMessage **msgs, LogPathOptions *path_options, gint max_msgs, gboolean push_to_backlog, gboolean ignore_throttle)
+{
+  return self->pop_batch(self, msgs, path_options, max_msgs, push_to_backlog, ignore_throttle);
+}
+
 static inline void
 log_queue_rewind_backlog(LogQueue *self)
 {
@@ -129,11 +142,21 @@ log_queue_set_throttle(LogQueue *self, gint throttle)
   self->throttle_buckets = throttle;
 }
 
+/* gives back the throttle buckets charged for messages that were popped
+ * and then returned with log_queue_push_head() without being sent */
+static inline void
+log_queue_refund_throttle(LogQueue *self, gint n)
+{
+  if (self->throttle)
+    self->throttle_buckets = MIN(self->throttle, self->throttle_buckets + n);
+}
+
 void log_queue_push_notify(LogQueue *self);
 void log_queue_reset_parallel_push(LogQueue *self);
 void log_queue_set_parallel_push(LogQueue *self, LogQueuePushNotifyFunc parallel_push_notify, gpointer user_data, GDestroyNotify user_data_destroy);
 gboolean log_queue_check_items(LogQueue *self, gint *timeout, LogQueuePushNotifyFunc parallel_push_notify, gpointer user_data, GDestroyNotify user_data_destroy);
 void log_queue_set_counters(LogQueue *self, StatsCounterItem *stored_messages, StatsCounterItem *dropped_messages);
+gint log_queue_pop_batch_method(LogQueue *self, LogMessage **msgs, LogPathOptions *path_options, gint max_msgs, gboolean push_to_backlog, gboolean ignore_throttle);
 void log_queue_init_instance(LogQueue *self, const gchar *persist_name);
 void log_queue_free_method(LogQueue *self);
 
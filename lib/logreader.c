@@ -32,6 +32,7 @@
 #include "timeutils.h"
 #include "compat.h"
 #include "mainloop.h"
+#include "inotify-watch.h"
 
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -46,6 +47,10 @@
 #include <iv.h>
 #include <iv_work.h>
 
+#if HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#endif
+
 /**
  * FIXME: LogReader has grown big enough that it is difficult to
  * maintain it. The root of the problem is a design issue, instead of
@@ -92,6 +97,15 @@ struct _LogReader
 
   struct iv_fd fd_watch;
   struct iv_timer follow_timer;
+  /* inotify based file following, falls back to follow_timer when not
+   * available or when the followed file was moved/deleted. The events
+   * collected in inotify_events are processed by inotify_task, but only
+   * while the reader is armed, i.e. waiting for input */
+  InotifyWatch inotify_watch;
+  struct iv_task inotify_task;
+  guint32 inotify_events;
+  gboolean inotify_armed;
+  gboolean inotify_disabled;
   struct iv_task restart_task;
   struct iv_event schedule_wakeup;
   MainLoopIOWorkerJob io_job;
@@ -229,7 +243,8 @@ log_reader_io_process_input(gpointer s)
 }
 
 /* follow timer callback. Check if the file has new content, or deleted or
- * moved.  Ran every follow_freq seconds.  */
+ * moved.  Ran every follow_freq seconds, or whenever inotify reports a
+ * change to the followed file.  */
 static void
 log_reader_io_follow_file(gpointer s)
 {
@@ -325,6 +340,126 @@ log_reader_io_follow_file(gpointer s)
   log_reader_update_watches(self);
 }
 
+static void
+log_reader_inotify_arm(LogReader *self)
+{
+  self->inotify_armed = TRUE;
+  if (self->inotify_events && !iv_task_registered(&self->inotify_task))
+    iv_task_register(&self->inotify_task);
+}
+
+static void
+log_reader_inotify_disarm(LogReader *self)
+{
+  self->inotify_armed = FALSE;
+  if (iv_task_registered(&self->inotify_task))
+    iv_task_unregister(&self->inotify_task);
+}
+
+static void
+log_reader_inotify_stop(LogReader *self)
+{
+  log_reader_inotify_disarm(self);
+  inotify_watch_stop(&self->inotify_watch);
+  self->inotify_events = 0;
+}
+
+#if HAVE_SYS_INOTIFY_H
+
+/* called by the shared inotify instance, only records the events, as the
+ * reader may be busy (or its window full) at this point */
+static void
+log_reader_inotify_event(gpointer s, guint32 mask, const gchar *name)
+{
+  LogReader *self = (LogReader *) s;
+
+  self->inotify_events |= mask;
+  if (self->inotify_armed && !iv_task_registered(&self->inotify_task))
+    iv_task_register(&self->inotify_task);
+}
+
+/* processes the events of the followed file and performs the same checks
+ * as the follow timer. Once the file is moved or deleted we can't get
+ * notifications about its replacement, so we fall back to polling until
+ * the file is reopened. */
+static void
+log_reader_io_inotify(gpointer s)
+{
+  LogReader *self = (LogReader *) s;
+  guint32 mask = self->inotify_events;
+
+  self->inotify_events = 0;
+  if (mask & IN_ATTRIB)
+    {
+      struct stat st;
+      gint fd = log_proto_server_get_fd(self->proto);
+
+      /* unlink() only generates IN_ATTRIB while we keep the file open */
+      if (fd >= 0 && fstat(fd, &st) == 0 && st.st_nlink == 0)
+        mask |= IN_DELETE_SELF;
+    }
+
+  if (mask & (IN_MOVE_SELF | IN_DELETE_SELF | IN_IGNORED | IN_UNMOUNT))
+    {
+      msg_trace("Followed file was moved or deleted, polling for its replacement",
+                evt_tag_str("follow_filename", self->follow_filename),
+                NULL);
+      log_reader_inotify_stop(self);
+      self->inotify_disabled = TRUE;
+    }
+  log_reader_io_follow_file(self);
+}
+
+/* returns TRUE if the followed file is watched via inotify, FALSE if it
+ * needs to be polled using follow_freq */
+static gboolean
+log_reader_inotify_start(LogReader *self)
+{
+  struct stat st, followed_st;
+  gint fd;
+
+  if (inotify_watch_started(&self->inotify_watch))
+    return TRUE;
+
+  if (self->inotify_disabled || (self->options->flags & LR_NO_INOTIFY) || !self->follow_filename)
+    return FALSE;
+
+  /* the file does not exist yet, poll until it is created */
+  fd = log_proto_server_get_fd(self->proto);
+  if (fd < 0 || fstat(fd, &st) < 0 || !S_ISREG(st.st_mode))
+    return FALSE;
+
+  if (!inotify_watch_start(&self->inotify_watch, self->follow_filename, IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF))
+    {
+      self->inotify_disabled = TRUE;
+      return FALSE;
+    }
+
+  /* the file may have been replaced since we opened it, in which case the
+   * watch is on the wrong file, let the polling code notice the rotation */
+  if (stat(self->follow_filename, &followed_st) < 0 ||
+      st.st_ino != followed_st.st_ino || st.st_dev != followed_st.st_dev)
+    {
+      inotify_watch_stop(&self->inotify_watch);
+      self->inotify_disabled = TRUE;
+      return FALSE;
+    }
+
+  /* catch up with any writes that happened before the watch was added */
+  self->immediate_check = TRUE;
+  return TRUE;
+}
+
+#else
+
+static gboolean
+log_reader_inotify_start(LogReader *self)
+{
+  return FALSE;
+}
+
+#endif
+
 static void
 log_reader_init_watches(LogReader *self)
 {
@@ -340,6 +475,15 @@ log_reader_init_watches(LogReader *self)
   self->follow_timer.cookie = self;
   self->follow_timer.handler = log_reader_io_follow_file;
 
+  IV_TASK_INIT(&self->inotify_task);
+  self->inotify_task.cookie = self;
+#if HAVE_SYS_INOTIFY_H
+  inotify_watch_init(&self->inotify_watch, self, log_reader_inotify_event);
+  self->inotify_task.handler = log_reader_io_inotify;
+#else
+  inotify_watch_init(&self->inotify_watch, self, NULL);
+#endif
+
   IV_TASK_INIT(&self->restart_task);
   self->restart_task.cookie = self;
   self->restart_task.handler = log_reader_io_process_input;
@@ -366,10 +510,12 @@ log_reader_start_watches(LogReader *self)
 
   if (self->options->follow_freq > 0)
     {
-      /* follow freq specified (only the file source does that, go into timed polling */
+      /* follow freq specified (only the file source does that), use
+       * inotify if possible, go into timed polling otherwise */
 
       /* NOTE: the fd may not be set here, as it may not have been opened yet */
-      iv_timer_register(&self->follow_timer);
+      if (!log_reader_inotify_start(self))
+        iv_timer_register(&self->follow_timer);
     }
   else
     {
@@ -410,6 +556,7 @@ log_reader_stop_watches(LogReader *self)
 {
   if (iv_fd_registered(&self->fd_watch))
     iv_fd_unregister(&self->fd_watch);
+  log_reader_inotify_disarm(self);
   if (iv_timer_registered(&self->follow_timer))
     iv_timer_unregister(&self->follow_timer);
   if (iv_task_registered(&self->restart_task))
@@ -459,6 +606,7 @@ log_reader_update_watches(LogReader *self)
           iv_fd_set_handler_err(&self->fd_watch, NULL);
         }
 
+      log_reader_inotify_disarm(self);
       if (iv_timer_registered(&self->follow_timer))
         iv_timer_unregister(&self->follow_timer);
 
@@ -503,7 +651,12 @@ log_reader_update_watches(LogReader *self)
     }
   else
     {
-      if (self->options->follow_freq > 0)
+      if (inotify_watch_started(&self->inotify_watch))
+        {
+          /* the followed file is watched via inotify, no need to poll */
+          log_reader_inotify_arm(self);
+        }
+      else if (self->options->follow_freq > 0)
         {
           if (iv_timer_registered(&self->follow_timer))
             iv_timer_unregister(&self->follow_timer);
@@ -553,6 +706,7 @@ log_reader_fetch_log(LogReader *self)
   GSockAddr *sa;
   gint msg_count = 0;
   gboolean may_read = TRUE;
+  gboolean at_eof = FALSE;
 
   if (self->waiting_for_preemption)
     may_read = FALSE;
@@ -593,6 +747,7 @@ log_reader_fetch_log(LogReader *self)
       if (!msg)
         {
           /* no more messages for now */
+          at_eof = !self->waiting_for_preemption;
           break;
         }
       if (msg_len > 0 || (self->options->flags & LR_EMPTY_LINES))
@@ -610,20 +765,23 @@ log_reader_fetch_log(LogReader *self)
       log_proto_server_queued(self->proto);
       g_sockaddr_unref(sa);
     }
+  if (msg_count == self->options->fetch_limit)
+    self->immediate_check = TRUE;
   if (self->options->flags & LR_PREEMPT)
     {
       if (log_proto_server_is_preemptable(self->proto))
         {
+          /* the notification is delivered by log_reader_work_finished()
+           * in the main thread, NC_FILE_EOF if we've consumed all input,
+           * NC_FILE_SKIP if there's more to read */
           self->waiting_for_preemption = FALSE;
-          log_pipe_notify(self->control, &self->super.super, NC_FILE_SKIP, self);
+          return at_eof ? NC_FILE_EOF : NC_FILE_SKIP;
         }
       else
         {
           self->waiting_for_preemption = TRUE;
         }
     }
-  if (msg_count == self->options->fetch_limit)
-    self->immediate_check = TRUE;
   return 0;
 }
 
@@ -661,6 +819,8 @@ log_reader_deinit(LogPipe *s)
 
   iv_event_unregister(&self->schedule_wakeup);
   log_reader_stop_watches(self);
+  log_reader_inotify_stop(self);
+  self->inotify_disabled = FALSE;
   if (!log_source_deinit(s))
     return FALSE;
 
@@ -711,6 +871,9 @@ log_reader_reopen_deferred(gpointer s)
   LogProtoServer *proto = args[1];
 
   log_reader_stop_watches(self);
+  /* the new proto may refer to a different file, watch that one */
+  log_reader_inotify_stop(self);
+  self->inotify_disabled = FALSE;
   if (self->io_job.working)
     {
       /* NOTE: proto can be NULL */
@@ -792,6 +955,22 @@ log_reader_new(LogProtoServer *proto)
   return &self->super.super;
 }
 
+/* NOTE: runs in the main thread. Makes the reader fetch its input even
+ * without an I/O event, e.g. to have an LR_PREEMPT reader report
+ * NC_FILE_EOF/NC_FILE_SKIP. */
+void
+log_reader_trigger_fetch(LogPipe *s)
+{
+  LogReader *self = (LogReader *) s;
+
+  main_loop_assert_main_thread();
+
+  if (!(self->super.super.flags & PIF_INITIALIZED) || self->io_job.working || self->suspended)
+    return;
+  self->immediate_check = TRUE;
+  log_reader_update_watches(self);
+}
+
 void 
 log_reader_set_immediate_check(LogPipe *s)
 {
@@ -894,6 +1073,7 @@ CfgFlagHandler log_reader_flag_handlers[] =
   { "kernel",                     CFH_SET, offsetof(LogReaderOptions, flags),               LR_KERNEL },
   { "empty-lines",                CFH_SET, offsetof(LogReaderOptions, flags),               LR_EMPTY_LINES },
   { "threaded",                   CFH_SET, offsetof(LogReaderOptions, flags),               LR_THREADED },
+  { "no-inotify",                 CFH_SET, offsetof(LogReaderOptions, flags),               LR_NO_INOTIFY },
   { NULL },
 };
 
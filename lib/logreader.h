@@ -36,6 +36,7 @@
 #define LR_SYSLOG_PROTOCOL 0x0010
 #define LR_PREEMPT         0x0020
 #define LR_THREADED        0x0040
+#define LR_NO_INOTIFY      0x0080
 
 /* options */
 
@@ -60,6 +61,7 @@ void log_reader_set_options(LogPipe *s, LogPipe *control, LogReaderOptions *opti
 void log_reader_set_follow_filename(LogPipe *self, const gchar *follow_filename);
 void log_reader_set_peer_addr(LogPipe *s, GSockAddr *peer_addr);
 void log_reader_set_immediate_check(LogPipe *s);
+void log_reader_trigger_fetch(LogPipe *s);
 void log_reader_reopen(LogPipe *s, LogProtoServer *proto, LogPipe *control, LogReaderOptions *options, gint stats_level, gint stats_source, const gchar *stats_id, const gchar *stats_instance, gboolean immediate_check);
 
 LogPipe *log_reader_new(LogProtoServer *proto);
@@ -26,6 +26,9 @@
 #include "messages.h"
 #include "timeutils.h"
 #include "str-format.h"
+#include "tls-support.h"
+
+#include <string.h>
 
 static void
 log_stamp_append_frac_digits(LogStamp *stamp, GString *target, gint frac_digits)
@@ -48,28 +51,41 @@ log_stamp_append_frac_digits(LogStamp *stamp, GString *target, gint frac_digits)
     }
 }
 
-/** 
- * log_stamp_format:
- * @stamp: Timestamp to format
- * @target: Target storage for formatted timestamp
- * @ts_format: Specifies basic timestamp format (TS_FMT_BSD, TS_FMT_ISO)
- * @zone_offset: Specifies custom zone offset if @tz_convert == TZ_CNV_CUSTOM
- *
- * Emits the formatted version of @stamp into @target as specified by
- * @ts_format and @tz_convert. 
- **/
-void
-log_stamp_append_format(LogStamp *stamp, GString *target, gint ts_format, glong zone_offset, gint frac_digits)
+/* number of entries in the per-thread formatted timestamp cache, must be a power of 2 */
+#define LOG_STAMP_CACHE_SIZE 16
+
+/*
+ * Timestamps of messages in a burst are mostly the same second, so the
+ * formatted representation is cached per thread.  The fractional digits
+ * are always formatted, only the parts before and after them are reused
+ * from the cache.
+ */
+typedef struct _LogStampCacheEntry
+{
+  time_t tv_sec;
+  glong zone_offset;
+  gint ts_format;
+  /* the formatted timestamp up to the fractional part, empty if the entry is unused */
+  gint prefix_len;
+  gchar prefix[32];
+  /* the zone info following the fractional part */
+  gint suffix_len;
+  gchar suffix[8];
+} LogStampCacheEntry;
+
+TLS_BLOCK_START
+{
+  LogStampCacheEntry log_stamp_cache[LOG_STAMP_CACHE_SIZE];
+}
+TLS_BLOCK_END;
+
+#define log_stamp_cache  __tls_deref(log_stamp_cache)
+
+static void
+log_stamp_append_prefix(LogStamp *stamp, GString *target, gint ts_format, glong target_zone_offset)
 {
-  glong target_zone_offset = 0;
   struct tm *tm, tm_storage;
-  char buf[8];
   time_t t;
-  
-  if (zone_offset != -1)
-    target_zone_offset = zone_offset;
-  else
-    target_zone_offset = stamp->zone_offset;
 
   t = stamp->tv_sec + target_zone_offset;
   cached_gmtime(&t, &tm_storage);
@@ -86,7 +102,6 @@ log_stamp_append_format(LogStamp *stamp, GString *target, gint ts_format, glong
       format_uint32_padded(target, 2, '0', 10, tm->tm_min);
       g_string_append_c(target, ':');
       format_uint32_padded(target, 2, '0', 10, tm->tm_sec);
-      log_stamp_append_frac_digits(stamp, target, frac_digits);
       break;
     case TS_FMT_ISO:
       format_uint32_padded(target, 0, 0, 10, tm->tm_year + 1900);
@@ -100,10 +115,6 @@ log_stamp_append_format(LogStamp *stamp, GString *target, gint ts_format, glong
       format_uint32_padded(target, 2, '0', 10, tm->tm_min);
       g_string_append_c(target, ':');
       format_uint32_padded(target, 2, '0', 10, tm->tm_sec);
-
-      log_stamp_append_frac_digits(stamp, target, frac_digits);
-      format_zone_info(buf, sizeof(buf), target_zone_offset);
-      g_string_append(target, buf);
       break;
     case TS_FMT_FULL:
       format_uint32_padded(target, 0, 0, 10, tm->tm_year + 1900);
@@ -117,12 +128,9 @@ log_stamp_append_format(LogStamp *stamp, GString *target, gint ts_format, glong
       format_uint32_padded(target, 2, '0', 10, tm->tm_min);
       g_string_append_c(target, ':');
       format_uint32_padded(target, 2, '0', 10, tm->tm_sec);
-
-      log_stamp_append_frac_digits(stamp, target, frac_digits);
       break;
     case TS_FMT_UNIX:
       format_uint32_padded(target, 0, 0, 10, (int) stamp->tv_sec);
-      log_stamp_append_frac_digits(stamp, target, frac_digits);
       break;
     default:
       g_assert_not_reached();
@@ -130,6 +138,78 @@ log_stamp_append_format(LogStamp *stamp, GString *target, gint ts_format, glong
     }
 }
 
+static LogStampCacheEntry *
+log_stamp_cache_lookup(LogStamp *stamp, GString *target, gint ts_format, glong target_zone_offset)
+{
+  LogStampCacheEntry *entry;
+  gsize start;
+
+  entry = &log_stamp_cache[(stamp->tv_sec ^ ts_format) & (LOG_STAMP_CACHE_SIZE - 1)];
+  if (G_LIKELY(entry->prefix_len > 0 &&
+               entry->tv_sec == stamp->tv_sec &&
+               entry->zone_offset == target_zone_offset &&
+               entry->ts_format == ts_format))
+    {
+      g_string_append_len(target, entry->prefix, entry->prefix_len);
+      return entry;
+    }
+
+  start = target->len;
+  log_stamp_append_prefix(stamp, target, ts_format, target_zone_offset);
+  if (target->len - start >= sizeof(entry->prefix))
+    {
+      /* doesn't fit, don't cache it */
+      entry->prefix_len = 0;
+      return NULL;
+    }
+
+  entry->tv_sec = stamp->tv_sec;
+  entry->zone_offset = target_zone_offset;
+  entry->ts_format = ts_format;
+  entry->prefix_len = target->len - start;
+  memcpy(entry->prefix, target->str + start, entry->prefix_len);
+  if (ts_format == TS_FMT_ISO)
+    entry->suffix_len = format_zone_info(entry->suffix, sizeof(entry->suffix), target_zone_offset);
+  else
+    entry->suffix_len = 0;
+  return entry;
+}
+
+/** 
+ * log_stamp_format:
+ * @stamp: Timestamp to format
+ * @target: Target storage for formatted timestamp
+ * @ts_format: Specifies basic timestamp format (TS_FMT_BSD, TS_FMT_ISO)
+ * @zone_offset: Specifies custom zone offset if @tz_convert == TZ_CNV_CUSTOM
+ *
+ * Emits the formatted version of @stamp into @target as specified by
+ * @ts_format and @tz_convert. 
+ **/
+void
+log_stamp_append_format(LogStamp *stamp, GString *target, gint ts_format, glong zone_offset, gint frac_digits)
+{
+  glong target_zone_offset = 0;
+  LogStampCacheEntry *entry;
+  char buf[8];
+
+  if (zone_offset != -1)
+    target_zone_offset = zone_offset;
+  else
+    target_zone_offset = stamp->zone_offset;
+
+  entry = log_stamp_cache_lookup(stamp, target, ts_format, target_zone_offset);
+  log_stamp_append_frac_digits(stamp, target, frac_digits);
+  if (entry)
+    {
+      g_string_append_len(target, entry->suffix, entry->suffix_len);
+    }
+  else if (ts_format == TS_FMT_ISO)
+    {
+      format_zone_info(buf, sizeof(buf), target_zone_offset);
+      g_string_append(target, buf);
+    }
+}
+
 void
 log_stamp_format(LogStamp *stamp, GString *target, gint ts_format, glong zone_offset, gint frac_digits)
 {
@@ -28,6 +28,9 @@
 
 #include <errno.h>
 #include <ctype.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
 
 void
 log_transport_free_method(LogTransport *s)
@@ -142,6 +145,20 @@ log_transport_pipe_write_method(LogTransport *s, const gpointer buf, gsize bufle
   return rc;
 }
 
+static gssize
+log_transport_file_writev_method(LogTransport *s, const struct iovec *iov, gint iov_count)
+{
+  LogTransportFile *self = (LogTransportFile *) s;
+  gint rc;
+
+  do
+    {
+      rc = writev(self->super.fd, iov, iov_count);
+    }
+  while (rc == -1 && errno == EINTR);
+  return rc;
+}
+
 /* regular files */
 LogTransport *
 log_transport_file_new(gint fd)
@@ -151,6 +168,7 @@ log_transport_file_new(gint fd)
   log_transport_init_method(&self->super, fd);
   self->super.read = log_transport_file_read_method;
   self->super.write = log_transport_file_write_method;
+  self->super.writev = log_transport_file_writev_method;
   self->super.free_fn = log_transport_free_method;
   return &self->super;
 }
@@ -163,6 +181,11 @@ log_transport_pipe_new(gint fd)
   log_transport_init_method(&self->super, fd);
   self->super.read = log_transport_file_read_method;
   self->super.write = log_transport_pipe_write_method;
+#ifndef __aix__
+  /* NOTE: AIX needs the shrinking write() loop above, see the comment in
+   * log_transport_pipe_write_method() */
+  self->super.writev = log_transport_file_writev_method;
+#endif
   self->super.free_fn = log_transport_free_method;
   return &self->super;
 }
@@ -283,6 +306,60 @@ log_transport_dgram_socket_write_method(LogTransport *s, const gpointer buf, gsi
   return rc;
 }
 
+/* the number of datagrams submitted in a single sendmmsg() call */
+#define LOG_TRANSPORT_DGRAM_BATCH 64
+
+/*
+ * Each iovec is sent as a separate datagram, the return value is the
+ * length of the datagrams that were sent, so the caller sees partial
+ * writes on datagram boundaries only.
+ */
+static gssize
+log_transport_dgram_socket_writev_method(LogTransport *s, const struct iovec *iov, gint iov_count)
+{
+#if HAVE_SENDMMSG
+  LogTransportSocket *self = (LogTransportSocket *) s;
+  struct mmsghdr msgs[LOG_TRANSPORT_DGRAM_BATCH];
+  gssize written = 0;
+  gint i, rc;
+
+  iov_count = MIN(iov_count, LOG_TRANSPORT_DGRAM_BATCH);
+  memset(msgs, 0, sizeof(msgs[0]) * iov_count);
+  for (i = 0; i < iov_count; i++)
+    {
+      msgs[i].msg_hdr.msg_iov = (struct iovec *) &iov[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+  do
+    {
+      rc = sendmmsg(self->super.fd, msgs, iov_count, 0);
+    }
+  while (rc == -1 && errno == EINTR);
+
+  /* NOTE: see the ENOBUFS comment in log_transport_dgram_socket_write_method() */
+  if (rc < 0 && errno == ENOBUFS)
+    return iov[0].iov_len;
+  if (rc < 0)
+    return rc;
+
+  for (i = 0; i < rc; i++)
+    written += iov[i].iov_len;
+  return written;
+#else
+  gssize written = 0;
+  gint i, rc;
+
+  for (i = 0; i < iov_count; i++)
+    {
+      rc = log_transport_dgram_socket_write_method(s, iov[i].iov_base, iov[i].iov_len);
+      if (rc < 0)
+        return written > 0 ? written : rc;
+      written += iov[i].iov_len;
+    }
+  return written;
+#endif
+}
 
 LogTransport *
 log_transport_dgram_socket_new(gint fd)
@@ -292,9 +369,193 @@ log_transport_dgram_socket_new(gint fd)
   log_transport_init_method(&self->super, fd);
   self->super.read = log_transport_dgram_socket_read_method;
   self->super.write = log_transport_dgram_socket_write_method;
+  self->super.writev = log_transport_dgram_socket_writev_method;
   return &self->super;
 }
 
+#if HAVE_RECVMMSG
+
+/* number of sender addresses remembered to avoid allocating a GSockAddr for each datagram */
+#define LOG_TRANSPORT_DGRAM_SADDR_CACHE 16
+
+/* upper limit of the receive buffers preallocated by a single transport,
+ * the batch is shortened if batch_size * buffer_size would exceed it */
+#define LOG_TRANSPORT_DGRAM_BATCH_MAX_BYTES (1024 * 1024)
+
+/*
+ * Datagram socket transport that receives up to batch_size datagrams
+ * with a single recvmmsg() call into preallocated buffers, and returns
+ * them one-by-one from subsequent read() calls.
+ */
+typedef struct _LogTransportDGramBatched LogTransportDGramBatched;
+struct _LogTransportDGramBatched
+{
+  LogTransportSocket super;
+  gint batch_size;
+  gsize buffer_size;
+  guchar *buffers;
+  struct iovec *iov;
+  struct mmsghdr *msgs;
+  struct sockaddr_storage *addrs;
+  /* datagrams in the [head, count) range are received but not yet read */
+  gint head, count;
+  GSockAddr *saddr_cache[LOG_TRANSPORT_DGRAM_SADDR_CACHE];
+  gint saddr_cache_next;
+};
+
+static GSockAddr *
+log_transport_dgram_batched_lookup_saddr(LogTransportDGramBatched *self, struct sockaddr *sa, socklen_t salen)
+{
+  GSockAddr *saddr;
+  gint i;
+
+  for (i = 0; i < LOG_TRANSPORT_DGRAM_SADDR_CACHE; i++)
+    {
+      saddr = self->saddr_cache[i];
+      if (saddr && saddr->salen == salen && memcmp(g_sockaddr_get_sa(saddr), sa, salen) == 0)
+        return g_sockaddr_ref(saddr);
+    }
+
+  saddr = g_sockaddr_new(sa, salen);
+  g_sockaddr_unref(self->saddr_cache[self->saddr_cache_next]);
+  self->saddr_cache[self->saddr_cache_next] = g_sockaddr_ref(saddr);
+  self->saddr_cache_next = (self->saddr_cache_next + 1) % LOG_TRANSPORT_DGRAM_SADDR_CACHE;
+  return saddr;
+}
+
+static gint
+log_transport_dgram_batched_receive(LogTransportDGramBatched *self)
+{
+  gint i, rc;
+
+  for (i = 0; i < self->batch_size; i++)
+    {
+      self->msgs[i].msg_hdr.msg_namelen = sizeof(self->addrs[i]);
+      self->msgs[i].msg_len = 0;
+    }
+
+  do
+    {
+      rc = recvmmsg(self->super.super.fd, self->msgs, self->batch_size, 0, NULL);
+    }
+  while (rc == -1 && errno == EINTR);
+
+  self->head = 0;
+  self->count = MAX(rc, 0);
+  return rc;
+}
+
+static gssize
+log_transport_dgram_batched_read_method(LogTransport *s, gpointer buf, gsize buflen, GSockAddr **sa)
+{
+  LogTransportDGramBatched *self = (LogTransportDGramBatched *) s;
+  struct mmsghdr *msg;
+  gint rc;
+
+  if (self->head == self->count)
+    {
+      rc = log_transport_dgram_batched_receive(self);
+      if (rc < 0)
+        return rc;
+      if (rc == 0)
+        {
+          errno = EAGAIN;
+          return -1;
+        }
+    }
+
+  msg = &self->msgs[self->head];
+  if ((msg->msg_hdr.msg_flags & MSG_TRUNC) || msg->msg_len > buflen)
+    {
+      msg_notice("Incoming datagram was truncated, it did not fit into the receive buffer, you may want to increase log-msg-size()",
+                 evt_tag_int("fd", self->super.super.fd),
+                 evt_tag_int("buffer_size", MIN(self->buffer_size, buflen)),
+                 NULL);
+    }
+  rc = MIN(msg->msg_len, buflen);
+  memcpy(buf, msg->msg_hdr.msg_iov->iov_base, rc);
+  if (msg->msg_hdr.msg_namelen && sa)
+    *sa = log_transport_dgram_batched_lookup_saddr(self, (struct sockaddr *) msg->msg_hdr.msg_name, msg->msg_hdr.msg_namelen);
+  self->head++;
+
+  if (rc == 0)
+    {
+      /* DGRAM sockets should never return EOF, they just need to be read again */
+      rc = -1;
+      errno = EAGAIN;
+    }
+  return rc;
+}
+
+static gboolean
+log_transport_dgram_batched_has_pending_input(LogTransport *s)
+{
+  LogTransportDGramBatched *self = (LogTransportDGramBatched *) s;
+
+  return self->head < self->count;
+}
+
+static void
+log_transport_dgram_batched_free_method(LogTransport *s)
+{
+  LogTransportDGramBatched *self = (LogTransportDGramBatched *) s;
+  gint i;
+
+  for (i = 0; i < LOG_TRANSPORT_DGRAM_SADDR_CACHE; i++)
+    g_sockaddr_unref(self->saddr_cache[i]);
+  g_free(self->buffers);
+  g_free(self->iov);
+  g_free(self->msgs);
+  g_free(self->addrs);
+  log_transport_free_method(s);
+}
+
+LogTransport *
+log_transport_dgram_socket_batched_new(gint fd, gint batch_size, gsize buffer_size)
+{
+  LogTransportDGramBatched *self;
+  gint i;
+
+  if (batch_size * buffer_size > LOG_TRANSPORT_DGRAM_BATCH_MAX_BYTES)
+    batch_size = LOG_TRANSPORT_DGRAM_BATCH_MAX_BYTES / buffer_size;
+  if (batch_size <= 1)
+    return log_transport_dgram_socket_new(fd);
+
+  self = g_new0(LogTransportDGramBatched, 1);
+  log_transport_init_method(&self->super.super, fd);
+  self->super.super.read = log_transport_dgram_batched_read_method;
+  self->super.super.write = log_transport_dgram_socket_write_method;
+  self->super.super.writev = log_transport_dgram_socket_writev_method;
+  self->super.super.has_pending_input = log_transport_dgram_batched_has_pending_input;
+  self->super.super.free_fn = log_transport_dgram_batched_free_method;
+
+  self->batch_size = batch_size;
+  self->buffer_size = buffer_size;
+  self->buffers = g_malloc(batch_size * buffer_size);
+  self->iov = g_new0(struct iovec, batch_size);
+  self->msgs = g_new0(struct mmsghdr, batch_size);
+  self->addrs = g_new0(struct sockaddr_storage, batch_size);
+  for (i = 0; i < batch_size; i++)
+    {
+      self->iov[i].iov_base = self->buffers + i * buffer_size;
+      self->iov[i].iov_len = buffer_size;
+      self->msgs[i].msg_hdr.msg_iov = &self->iov[i];
+      self->msgs[i].msg_hdr.msg_iovlen = 1;
+      self->msgs[i].msg_hdr.msg_name = &self->addrs[i];
+    }
+  return &self->super.super;
+}
+
+#else
+
+LogTransport *
+log_transport_dgram_socket_batched_new(gint fd, gint batch_size, gsize buffer_size)
+{
+  return log_transport_dgram_socket_new(fd);
+}
+
+#endif
+
 static gssize
 log_transport_stream_socket_read_method(LogTransport *s, gpointer buf, gsize buflen, GSockAddr **sa)
 {
@@ -325,6 +586,24 @@ log_transport_stream_socket_write_method(LogTransport *s, const gpointer buf, gs
   return rc;
 }
 
+static gssize
+log_transport_stream_socket_writev_method(LogTransport *s, const struct iovec *iov, gint iov_count)
+{
+  LogTransportSocket *self = (LogTransportSocket *) s;
+  struct msghdr msg;
+  gint rc;
+
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = (struct iovec *) iov;
+  msg.msg_iovlen = iov_count;
+  do
+    {
+      rc = sendmsg(self->super.fd, &msg, 0);
+    }
+  while (rc == -1 && errno == EINTR);
+  return rc;
+}
+
 static void
 log_transport_stream_socket_free_method(LogTransport *s)
 {
@@ -340,6 +619,7 @@ log_transport_stream_socket_new(gint fd)
   log_transport_init_method(&self->super, fd);
   self->super.read = log_transport_stream_socket_read_method;
   self->super.write = log_transport_stream_socket_write_method;
+  self->super.writev = log_transport_stream_socket_writev_method;
   self->super.free_fn = log_transport_stream_socket_free_method;
   return &self->super;
 }
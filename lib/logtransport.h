@@ -28,6 +28,8 @@
 #include "syslog-ng.h"
 #include "gsockaddr.h"
 
+#include <sys/uio.h>
+
 typedef struct _LogTransport LogTransport;
 
 struct _LogTransport
@@ -36,6 +38,10 @@ struct _LogTransport
   GIOCondition cond;
   gssize (*read)(LogTransport *self, gpointer buf, gsize count, GSockAddr **sa);
   gssize (*write)(LogTransport *self, const gpointer buf, gsize count);
+  /* optional, submits several buffers in a single operation */
+  gssize (*writev)(LogTransport *self, const struct iovec *iov, gint iov_count);
+  /* optional, TRUE if input was received but not yet returned by read() */
+  gboolean (*has_pending_input)(LogTransport *self);
   void (*free_fn)(LogTransport *self);
 };
 
@@ -45,12 +51,33 @@ log_transport_write(LogTransport *self, const gpointer buf, gsize count)
   return self->write(self, buf, count);
 }
 
+/*
+ * Returns the number of bytes written from the front of @iov.  Transports
+ * without a native writev method only write the first buffer, which is
+ * indistinguishable from a partial write for the caller.
+ */
+static inline gssize
+log_transport_writev(LogTransport *self, const struct iovec *iov, gint iov_count)
+{
+  if (self->writev)
+    return self->writev(self, iov, iov_count);
+  return self->write(self, iov[0].iov_base, iov[0].iov_len);
+}
+
 static inline gssize
 log_transport_read(LogTransport *self, gpointer buf, gsize count, GSockAddr **sa)
 {
   return self->read(self, buf, count, sa);
 }
 
+static inline gboolean
+log_transport_has_pending_input(LogTransport *self)
+{
+  if (self->has_pending_input)
+    return self->has_pending_input(self);
+  return FALSE;
+}
+
 void log_transport_init_method(LogTransport *s, gint fd);
 void log_transport_free_method(LogTransport *s);
 void log_transport_free(LogTransport *s);
@@ -59,6 +86,9 @@ LogTransport *log_transport_file_new(gint fd);
 LogTransport *log_transport_pipe_new(gint fd);
 LogTransport *log_transport_device_new(gint fd, gint timeout);
 LogTransport *log_transport_dgram_socket_new(gint fd);
+/* NOTE: preallocates batch_size * buffer_size bytes of receive buffers
+ * (capped at 1MB) for each transport, e.g. for each so-reuseport() socket */
+LogTransport *log_transport_dgram_socket_batched_new(gint fd, gint batch_size, gsize buffer_size);
 LogTransport *log_transport_stream_socket_new(gint fd);
 
 #endif
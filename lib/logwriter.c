@@ -40,6 +40,9 @@
 #include <iv_event.h>
 #include <iv_work.h>
 
+/* the number of messages taken from the queue in one go by log_writer_flush() */
+#define LOG_WRITER_POP_BATCH 64
+
 typedef enum
 {
   /* flush modes */
@@ -989,62 +992,83 @@ log_writer_flush(LogWriter *self, LogWriterFlushMode flush_mode)
 
   while (status == LPS_SUCCESS && (!main_loop_io_worker_job_quit() || flush_mode >= LW_FLUSH_QUEUE))
     {
-      LogMessage *lm;
-      LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
-      gboolean consumed = FALSE;
-      
-      if (!log_queue_pop_head(self->queue, &lm, &path_options, FALSE, ignore_throttle))
+      LogMessage *batch[LOG_WRITER_POP_BATCH];
+      LogPathOptions batch_options[LOG_WRITER_POP_BATCH];
+      gint batch_len, i;
+
+      batch_len = log_queue_pop_batch(self->queue, batch, batch_options, LOG_WRITER_POP_BATCH, FALSE, ignore_throttle);
+      if (batch_len == 0)
         {
           /* no more items are available */
           break;
         }
 
-      log_msg_refcache_start_consumer(lm, &path_options);
-      msg_set_context(lm);
-
-      log_writer_format_log(self, lm, self->line_buffer);
-      
-      if (self->line_buffer->len)
+      for (i = 0; i < batch_len; i++)
         {
-          status = log_proto_client_post(proto, (guchar *) self->line_buffer->str, self->line_buffer->len, &consumed);
+          LogMessage *lm = batch[i];
+          LogPathOptions *path_options = &batch_options[i];
+          gboolean consumed = FALSE;
 
-          if (consumed)
-            log_writer_realloc_line_buffer(self);
+          if (i > 0 && (status != LPS_SUCCESS || (main_loop_io_worker_job_quit() && flush_mode < LW_FLUSH_QUEUE)))
+            break;
+
+          log_msg_refcache_start_consumer(lm, path_options);
+          msg_set_context(lm);
 
-          if (status == LPS_ERROR)
+          log_writer_format_log(self, lm, self->line_buffer);
+
+          if (self->line_buffer->len)
             {
-              if ((self->options->options & LWO_IGNORE_ERRORS) != 0)
+              status = log_proto_client_post(proto, (guchar *) self->line_buffer->str, self->line_buffer->len, &consumed);
+
+              if (consumed)
+                log_writer_realloc_line_buffer(self);
+
+              if (status == LPS_ERROR)
                 {
-                  consumed = TRUE;
-                  status = LPS_SUCCESS;
+                  if ((self->options->options & LWO_IGNORE_ERRORS) != 0)
+                    {
+                      consumed = TRUE;
+                      status = LPS_SUCCESS;
+                    }
                 }
             }
-        }
-      else
-        {
-          msg_debug("Error posting log message as template() output resulted in an empty string, skipping message",
-                    NULL);
-          consumed = TRUE;
-        }
-      if (consumed)
-        {
-          if (lm->flags & LF_LOCAL)
-            step_sequence_number(&self->seq_num);
-          log_msg_ack(lm, &path_options);
-          log_msg_unref(lm);
-        }
-      else
-        {
-          /* push back to the queue */
-          log_queue_push_head(self->queue, lm, &path_options);
+          else
+            {
+              msg_debug("Error posting log message as template() output resulted in an empty string, skipping message",
+                        NULL);
+              consumed = TRUE;
+            }
+          if (consumed)
+            {
+              if (lm->flags & LF_LOCAL)
+                step_sequence_number(&self->seq_num);
+              log_msg_ack(lm, path_options);
+              log_msg_unref(lm);
+            }
+          else
+            {
+              msg_set_context(NULL);
+              log_msg_refcache_stop();
+              break;
+            }
+
           msg_set_context(NULL);
           log_msg_refcache_stop();
-          break;
+          count++;
         }
 
-      msg_set_context(NULL);
-      log_msg_refcache_stop();
-      count++;
+      if (i < batch_len)
+        {
+          /* push the unsent part of the batch back to the queue, in reverse order to keep ordering */
+          gint j;
+
+          for (j = batch_len - 1; j >= i; j--)
+            log_queue_push_head(self->queue, batch[j], &batch_options[j]);
+          if (!ignore_throttle)
+            log_queue_refund_throttle(self->queue, batch_len - i);
+          break;
+        }
     }
 
   if (status != LPS_SUCCESS)
@@ -1409,6 +1433,7 @@ log_writer_options_init(LogWriterOptions *options, GlobalConfig *cfg, guint32 op
     
   if (options->flush_lines == -1)
     options->flush_lines = cfg->flush_lines;
+  options->proto_options.super.flush_lines = options->flush_lines;
   if (options->flush_timeout == -1)
     options->flush_timeout = cfg->flush_timeout;
   if (options->suppress == -1)
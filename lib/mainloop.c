@@ -33,6 +33,7 @@
 #include "dnscache.h"
 #include "tls-support.h"
 #include "scratch-buffers.h"
+#include "logmsg.h"
 
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -324,6 +325,7 @@ main_loop_io_worker_thread_stop(void *cookie)
   g_static_mutex_unlock(&main_loop_io_workers_idmap_lock);
   dns_cache_destroy();
   scratch_buffers_free();
+  log_msg_pool_release_thread_cache();
 
   if (call_info.cond)
     g_cond_free(call_info.cond);
@@ -673,6 +675,7 @@ main_loop_init(void)
   IV_TASK_INIT(&main_loop_io_workers_reenable_jobs_task);
   main_loop_io_workers_reenable_jobs_task.handler = main_loop_io_worker_reenable_jobs;
   log_queue_set_max_threads(MIN(main_loop_io_workers.max_threads, MAIN_LOOP_MAX_WORKER_THREADS));
+  stats_set_max_threads(MIN(main_loop_io_workers.max_threads, MAIN_LOOP_MAX_WORKER_THREADS));
   main_loop_call_init();
 
   current_configuration = cfg_new(0);
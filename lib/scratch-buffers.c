@@ -29,10 +29,12 @@
 TLS_BLOCK_START
 {
   GTrashStack *scratch_buffers;
+  GPtrArray *scratch_buffer_arrays;
 }
 TLS_BLOCK_END;
 
 #define local_scratch_buffers	__tls_deref(scratch_buffers)
+#define local_scratch_buffer_arrays	__tls_deref(scratch_buffer_arrays)
 
 ScratchBuffer *
 scratch_buffer_acquire(void)
@@ -56,10 +58,46 @@ scratch_buffer_release(ScratchBuffer *sb)
   g_trash_stack_push(&local_scratch_buffers, sb);
 }
 
+/*
+ * Returns an empty array to be filled with strings of scratch buffers
+ * (see sb_string()).  The array and the buffers in it are released
+ * together with scratch_buffer_array_release().
+ */
+GPtrArray *
+scratch_buffer_array_acquire(void)
+{
+  if (local_scratch_buffer_arrays && local_scratch_buffer_arrays->len > 0)
+    return g_ptr_array_remove_index_fast(local_scratch_buffer_arrays, local_scratch_buffer_arrays->len - 1);
+  return g_ptr_array_sized_new(8);
+}
+
+void
+scratch_buffer_array_release(GPtrArray *array)
+{
+  gint i;
+
+  for (i = 0; i < array->len; i++)
+    scratch_buffer_release(sb_from_string(g_ptr_array_index(array, i)));
+  g_ptr_array_set_size(array, 0);
+
+  if (!local_scratch_buffer_arrays)
+    local_scratch_buffer_arrays = g_ptr_array_sized_new(4);
+  g_ptr_array_add(local_scratch_buffer_arrays, array);
+}
+
 void
 scratch_buffers_free(void)
 {
   ScratchBuffer *sb;
+  gint i;
+
+  if (local_scratch_buffer_arrays)
+    {
+      for (i = 0; i < local_scratch_buffer_arrays->len; i++)
+        g_ptr_array_free(g_ptr_array_index(local_scratch_buffer_arrays, i), TRUE);
+      g_ptr_array_free(local_scratch_buffer_arrays, TRUE);
+      local_scratch_buffer_arrays = NULL;
+    }
 
   while ((sb = g_trash_stack_pop(&local_scratch_buffers)) != NULL)
     {
@@ -37,6 +37,11 @@ ScratchBuffer *scratch_buffer_acquire(void);
 void scratch_buffer_release(ScratchBuffer *sb);
 
 #define sb_string(buffer) (&buffer->s)
+#define sb_from_string(str) ((ScratchBuffer *) (((gchar *) (str)) - G_STRUCT_OFFSET(ScratchBuffer, s)))
+
+/* GPtrArrays holding GString pointers of scratch buffers */
+GPtrArray *scratch_buffer_array_acquire(void);
+void scratch_buffer_array_release(GPtrArray *array);
 
 void scratch_buffers_free(void);
 
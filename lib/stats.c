@@ -96,6 +96,10 @@ static GHashTable *counter_hash;
 GStaticMutex stats_mutex;
 gint current_stats_level;
 gboolean stats_locked;
+gint stats_max_threads;
+#ifndef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8
+GStaticMutex stats_counter_atomic_lock = G_STATIC_MUTEX_INIT;
+#endif
 
 static gboolean
 stats_counter_equal(gconstpointer p1, gconstpointer p2)
@@ -118,7 +122,10 @@ static void
 stats_counter_free(gpointer p)
 { 
   StatsCounter *sc = (StatsCounter *) p;
-  
+  StatsCounterType type;
+
+  for (type = 0; type < SC_TYPE_MAX; type++)
+    g_free(sc->counters[type].shards);
   g_free(sc->id);
   g_free(sc->instance);
   g_free(sc);
@@ -169,6 +176,17 @@ stats_add_counter(gint stats_level, gint source, const gchar *id, const gchar *i
   return sc;
 }
 
+static void
+stats_counter_alloc_shards(StatsCounter *sc, StatsCounterType type)
+{
+  /* static counters are few and can be hot, so they get per-thread
+   * shards.  Dynamic ones (per host, per sender, ...) may come in
+   * large numbers, they use the shared value only.  Timestamps are
+   * always set, never incremented, so they are not sharded either. */
+  if (!sc->dynamic && type != SC_TYPE_STAMP && !sc->counters[type].shards && stats_max_threads > 0)
+    sc->counters[type].shards = g_new0(StatsCounterShard, stats_max_threads);
+}
+
 /**
  * stats_register_counter:
  * @stats_level: the required statistics level to make this counter available
@@ -201,6 +219,8 @@ stats_register_counter(gint stats_level, gint source, const gchar *id, const gch
 
   *counter = &sc->counters[type];
   sc->live_mask |= 1 << type;
+
+  stats_counter_alloc_shards(sc, type);
 }
 
 StatsCounter *
@@ -331,6 +351,53 @@ stats_cleanup_orphans(void)
   g_hash_table_foreach_remove(counter_hash, stats_counter_is_orphaned, NULL);
 }
 
+static void
+stats_counter_fold_shards(gpointer key, gpointer value, gpointer user_data)
+{
+  StatsCounter *sc = (StatsCounter *) value;
+  StatsCounterType type;
+
+  for (type = 0; type < SC_TYPE_MAX; type++)
+    {
+      StatsCounterItem *counter = &sc->counters[type];
+
+      if (counter->shards)
+        {
+          counter->value = stats_counter_get(counter);
+          g_free(counter->shards);
+          counter->shards = NULL;
+        }
+    }
+}
+
+static void
+stats_counter_realloc_shards(gpointer key, gpointer value, gpointer user_data)
+{
+  StatsCounter *sc = (StatsCounter *) value;
+  StatsCounterType type;
+
+  for (type = 0; type < SC_TYPE_MAX; type++)
+    {
+      if (sc->live_mask & (1 << type))
+        stats_counter_alloc_shards(sc, type);
+    }
+}
+
+/*
+ * Sets the number of I/O worker threads that get their own counter
+ * shards.  The counters registered so far are resized, which is only
+ * safe while the worker threads are not running.
+ */
+void
+stats_set_max_threads(gint max_threads)
+{
+  if (counter_hash)
+    g_hash_table_foreach(counter_hash, stats_counter_fold_shards, NULL);
+  stats_max_threads = max_threads;
+  if (counter_hash)
+    g_hash_table_foreach(counter_hash, stats_counter_realloc_shards, NULL);
+}
+
 void
 stats_counter_inc_pri(guint16 pri)
 {
@@ -385,6 +452,7 @@ const gchar *source_names[SCS_MAX] =
   "sender",
   "smtp",
   "amqp",
+  "redis",
 };
 
 
@@ -411,11 +479,11 @@ stats_format_log_counter(gpointer key, gpointer value, gpointer user_data)
                 source_name = "destination";
               else
                 g_assert_not_reached();
-              tag = evt_tag_printf(tag_names[type], "%s(%s%s%s)=%u", source_name, sc->id, (sc->id[0] && sc->instance[0]) ? "," : "", sc->instance, stats_counter_get(&sc->counters[type]));
+              tag = evt_tag_printf(tag_names[type], "%s(%s%s%s)=%" G_GUINT64_FORMAT, source_name, sc->id, (sc->id[0] && sc->instance[0]) ? "," : "", sc->instance, stats_counter_get(&sc->counters[type]));
             }
           else
             {
-              tag = evt_tag_printf(tag_names[type], "%s%s(%s%s%s)=%u", 
+              tag = evt_tag_printf(tag_names[type], "%s%s(%s%s%s)=%" G_GUINT64_FORMAT,
                                    (sc->source & SCS_SOURCE ? "src." : (sc->source & SCS_DESTINATION ? "dst." : "")),
                                    source_names[sc->source & SCS_SOURCE_MASK],
                                    sc->id, (sc->id[0] && sc->instance[0]) ? "," : "", sc->instance,
@@ -530,7 +598,7 @@ stats_format_csv(gpointer key, gpointer value, gpointer user_data)
                          source_names[sc->source & SCS_SOURCE_MASK]);
             }
           tag_name = stats_format_csv_escapevar(tag_names[type]);
-          g_string_append_printf(csv, "%s;%s;%s;%c;%s;%u\n", source_name, s_id, s_instance, state, tag_name, stats_counter_get(&sc->counters[type]));
+          g_string_append_printf(csv, "%s;%s;%s;%c;%s;%" G_GUINT64_FORMAT "\n", source_name, s_id, s_instance, state, tag_name, stats_counter_get(&sc->counters[type]));
           g_free(tag_name);
         }
     }
@@ -72,19 +72,38 @@ enum
   SCS_SENDER         = 26,
   SCS_SMTP           = 27,
   SCS_AMQP           = 28,
+  SCS_REDIS          = 29,
   SCS_MAX,
   SCS_SOURCE_MASK    = 0xff
 };
 
+/* per-thread parts of a counter are padded to a cache line each, so
+ * that I/O workers don't contend on the same line */
+#define STATS_COUNTER_SHARD_SIZE 64
+
+typedef union _StatsCounterShard
+{
+  guint64 value;
+  gchar __padding[STATS_COUNTER_SHARD_SIZE];
+} StatsCounterShard;
+
 typedef struct _StatsCounter StatsCounter;
 typedef struct _StatsCounterItem
 {
-  gint value;
+  /* changed atomically by threads that have no shard of their own */
+  guint64 value;
+  /* one shard per I/O worker thread, only written by its owner, NULL if
+   * the counter is not sharded */
+  StatsCounterShard *shards;
 } StatsCounterItem;
 
 extern gint current_stats_level;
 extern GStaticMutex stats_mutex;
 extern gboolean stats_locked;
+extern gint stats_max_threads;
+#ifndef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8
+extern GStaticMutex stats_counter_atomic_lock;
+#endif
 
 void stats_generate_log(void);
 gchar *stats_generate_csv(void);
@@ -99,6 +118,7 @@ void stats_cleanup_orphans(void);
 
 void stats_counter_inc_pri(guint16 pri);
 
+void stats_set_max_threads(gint max_threads);
 void stats_reinit(GlobalConfig *cfg);
 void stats_init(void);
 void stats_destroy(void);
@@ -123,44 +143,96 @@ stats_unlock(void)
   g_static_mutex_unlock(&stats_mutex);
 }
 
+static inline void
+stats_counter_atomic_add(guint64 *value, gint64 add)
+{
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8
+  __sync_fetch_and_add(value, add);
+#else
+  g_static_mutex_lock(&stats_counter_atomic_lock);
+  *value += add;
+  g_static_mutex_unlock(&stats_counter_atomic_lock);
+#endif
+}
+
+/* returns the shard of the current I/O worker thread, or NULL if the
+ * shared value needs to be used */
+static inline StatsCounterShard *
+stats_counter_get_shard(StatsCounterItem *counter)
+{
+  gint thread_id;
+
+  if (!counter->shards)
+    return NULL;
+
+  thread_id = main_loop_io_worker_thread_id();
+  if (thread_id < 0 || thread_id >= stats_max_threads)
+    return NULL;
+  return &counter->shards[thread_id];
+}
+
 static inline void
 stats_counter_add(StatsCounterItem *counter, gint add)
 {
-  if (counter)
-    g_atomic_int_add(&counter->value, add);
+  StatsCounterShard *shard;
+
+  if (!counter)
+    return;
+
+  shard = stats_counter_get_shard(counter);
+  if (shard)
+    shard->value += add;
+  else
+    stats_counter_atomic_add(&counter->value, add);
 }
 
 static inline void
 stats_counter_inc(StatsCounterItem *counter)
 {
-  if (counter)
-    g_atomic_int_inc(&counter->value);
+  stats_counter_add(counter, 1);
 }
 
 static inline void
 stats_counter_dec(StatsCounterItem *counter)
 {
-  if (counter)
-    g_atomic_int_add(&counter->value, -1);
+  stats_counter_add(counter, -1);
 }
 
 /* NOTE: this is _not_ atomic and doesn't have to be as sets would race anyway */
 static inline void
-stats_counter_set(StatsCounterItem *counter, guint32 value)
+stats_counter_set(StatsCounterItem *counter, guint64 value)
 {
+  gint i;
+
   if (counter)
-    counter->value = value;
+    {
+      counter->value = value;
+      if (counter->shards)
+        {
+          for (i = 0; i < stats_max_threads; i++)
+            counter->shards[i].value = 0;
+        }
+    }
 }
 
-/* NOTE: this is _not_ atomic and doesn't have to be as sets would race anyway */
-static inline guint32
+/* NOTE: this is _not_ atomic and doesn't have to be as sets would race
+ * anyway, the shards are summed up without synchronizing with the
+ * writers, which is fine for reporting purposes */
+static inline guint64
 stats_counter_get(StatsCounterItem *counter)
 {
-  guint32 result = 0;
+  guint64 result = 0;
+  gint i;
 
   if (counter)
-    result = counter->value;
+    {
+      result = counter->value;
+      if (counter->shards)
+        {
+          for (i = 0; i < stats_max_threads; i++)
+            result += counter->shards[i].value;
+        }
+    }
   return result;
 }
 #endif
-
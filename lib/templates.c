@@ -32,6 +32,7 @@
 #include "gsocket.h"
 #include "plugin.h"
 #include "str-format.h"
+#include "scratch-buffers.h"
 
 #include <time.h>
 #include <string.h>
@@ -654,16 +655,25 @@ log_macro_lookup(gchar *macro, gint len)
 
 enum
 {
+  LTE_TEXT,
   LTE_MACRO,
   LTE_VALUE,
   LTE_FUNC
 };
 
-typedef struct _LogTemplateElem
+/* estimated expansion length of a single macro or value, used to compute
+ * the initial size hint of a template */
+#define LTE_EXPANSION_ESTIMATE 16
+
+/* elements of the compiled template, each copies its literal text
+ * prefix and then performs the operation specified by type.  They are
+ * stored in a contiguous array, in the order of evaluation. */
+struct _LogTemplateElem
 {
   gsize text_len;
   gchar *text;
   gchar *default_value;
+  gsize default_value_len;
   guint16 msg_ref;
   guint8 type;
   union
@@ -676,7 +686,7 @@ typedef struct _LogTemplateElem
       gpointer state;
     } func;
   };
-} LogTemplateElem;
+};
 
 
 /* simple template functions which take templates as arguments */
@@ -714,15 +724,10 @@ tf_simple_func_eval(LogTemplateFunction *self, gpointer s, const LogTemplateInvo
 
   for (i = 0; i < state->argc; i++)
     {
-      GString **arg;
-
-      if (args->bufs->len <= i)
-        g_ptr_array_add(args->bufs, g_string_sized_new(256));
+      GString *arg = sb_string(scratch_buffer_acquire());
 
-      arg = (GString **) &g_ptr_array_index(args->bufs, i);
-      g_string_truncate(*arg, 0);
-
-      log_template_append_format_recursive(state->argv[i], args, *arg);
+      g_ptr_array_add(args->bufs, arg);
+      log_template_append_format_recursive(state->argv[i], args, arg);
     }
 }
 
@@ -758,12 +763,12 @@ log_template_set_escape(LogTemplate *self, gboolean enable)
 static void
 log_template_reset_compiled(LogTemplate *self)
 {
-  while (self->compiled_template)
+  gint i;
+
+  for (i = 0; i < self->compiled_template_len; i++)
     {
-      LogTemplateElem *e;
+      LogTemplateElem *e = &self->compiled_template[i];
 
-      e = self->compiled_template->data;
-      self->compiled_template = g_list_delete_link(self->compiled_template, self->compiled_template);
       switch (e->type)
         {
         case LTE_FUNC:
@@ -778,43 +783,52 @@ log_template_reset_compiled(LogTemplate *self)
         g_free(e->default_value);
       if (e->text)
         g_free(e->text);
-      g_free(e);
     }
-
+  g_free(self->compiled_template);
+  self->compiled_template = NULL;
+  self->compiled_template_len = 0;
+  self->size_hint = 0;
 }
 
 static void
-log_template_add_macro_elem(LogTemplate *self, guint macro, GString *text, gchar *default_value, gint msg_ref)
+log_template_append_elem(LogTemplate *self, LogTemplateElem *e, GString *text, gchar *default_value, gint msg_ref)
 {
-  LogTemplateElem *e;
-  
-  e = g_new0(LogTemplateElem, 1);
-  e->type = LTE_MACRO;
   e->text_len = text ? text->len : 0;
   e->text = text ? g_strndup(text->str, text->len) : NULL;
-  e->macro = macro;
   e->default_value = default_value;
+  e->default_value_len = default_value ? strlen(default_value) : 0;
   e->msg_ref = msg_ref;
-  self->compiled_template = g_list_prepend(self->compiled_template, e);
+
+  self->size_hint += e->text_len;
+  if (e->type != LTE_TEXT)
+    self->size_hint += LTE_EXPANSION_ESTIMATE;
+
+  self->compiled_template = g_renew(LogTemplateElem, self->compiled_template, self->compiled_template_len + 1);
+  self->compiled_template[self->compiled_template_len++] = *e;
+}
+
+static void
+log_template_add_macro_elem(LogTemplate *self, guint macro, GString *text, gchar *default_value, gint msg_ref)
+{
+  LogTemplateElem e = { 0 };
+
+  e.type = macro == M_NONE ? LTE_TEXT : LTE_MACRO;
+  e.macro = macro;
+  log_template_append_elem(self, &e, text, default_value, msg_ref);
 }
 
 static void
 log_template_add_value_elem(LogTemplate *self, gchar *value_name, gsize value_name_len, GString *text, gchar *default_value, gint msg_ref)
 {
-  LogTemplateElem *e;
+  LogTemplateElem e = { 0 };
   gchar *dup;
-  
-  e = g_new0(LogTemplateElem, 1);
-  e->type = LTE_VALUE;
-  e->text_len = text ? text->len : 0;
-  e->text = text ? g_strndup(text->str, text->len) : NULL;
+
+  e.type = LTE_VALUE;
   /* value_name is not NUL terminated */
   dup = g_strndup(value_name, value_name_len);
-  e->value_handle = log_msg_get_value_handle(dup);
+  e.value_handle = log_msg_get_value_handle(dup);
   g_free(dup);
-  e->default_value = default_value;
-  e->msg_ref = msg_ref;
-  self->compiled_template = g_list_prepend(self->compiled_template, e);
+  log_template_append_elem(self, &e, text, default_value, msg_ref);
 }
 
 
@@ -822,7 +836,7 @@ log_template_add_value_elem(LogTemplate *self, gchar *value_name, gsize value_na
 static gboolean
 log_template_add_func_elem(LogTemplate *self, GString *text, gint argc, gchar *argv[], gint msg_ref, GError **error)
 {
-  LogTemplateElem *e;
+  LogTemplateElem e = { 0 };
   Plugin *p;
   gchar *argv_copy[argc + 1];
 
@@ -831,42 +845,32 @@ log_template_add_func_elem(LogTemplate *self, GString *text, gint argc, gchar *a
   if (argc == 0)
     return TRUE;
 
-  e = g_malloc0(sizeof(LogTemplateElem) + (argc - 1) * sizeof(LogTemplate *));
-  e->type = LTE_FUNC;
-  e->text_len = text ? text->len : 0;
-  e->text = text ? g_strndup(text->str, text->len) : NULL;
-  e->msg_ref = msg_ref;
+  e.type = LTE_FUNC;
 
   p = plugin_find(self->cfg, LL_CONTEXT_TEMPLATE_FUNC, argv[0]);
   if (!p)
     {
       g_set_error(error, LOG_TEMPLATE_ERROR, LOG_TEMPLATE_ERROR_COMPILE, "Unknown template function %s", argv[0]);
-      goto error;
+      return FALSE;
     }
   else
     {
-      e->func.ops = plugin_construct(p, self->cfg, LL_CONTEXT_TEMPLATE_FUNC, argv[0]);
+      e.func.ops = plugin_construct(p, self->cfg, LL_CONTEXT_TEMPLATE_FUNC, argv[0]);
     }
 
-  e->func.state = g_malloc0(e->func.ops->size_of_state);
+  e.func.state = g_malloc0(e.func.ops->size_of_state);
 
   /* prepare may modify the argv array: remove and rearrange elements */
   memcpy(argv_copy, argv, (argc + 1) * sizeof(argv[0]));
-  if (!e->func.ops->prepare(e->func.ops, e->func.state, self, argc, argv_copy, error))
+  if (!e.func.ops->prepare(e.func.ops, e.func.state, self, argc, argv_copy, error))
     {
-      e->func.ops->free_state(e->func.state);
-      g_free(e->func.state);
-      goto error;
+      e.func.ops->free_state(e.func.state);
+      g_free(e.func.state);
+      return FALSE;
     }
   g_strfreev(argv);
-  self->compiled_template = g_list_prepend(self->compiled_template, e);
+  log_template_append_elem(self, &e, text, NULL, msg_ref);
   return TRUE;
-
- error:
-  if (e->text)
-    g_free(e->text);
-  g_free(e);
-  return FALSE;
 }
 
 static void
@@ -1132,7 +1136,6 @@ log_template_compile(LogTemplate *self, const gchar *template, GError **error)
       log_template_add_macro_elem(self, last_macro, last_text, NULL, 0);
       g_string_free(last_text, TRUE);
     }
-  self->compiled_template = g_list_reverse(self->compiled_template);
   return TRUE;
   
  error:
@@ -1151,18 +1154,27 @@ log_template_compile(LogTemplate *self, const gchar *template, GError **error)
 void
 log_template_append_format_with_context(LogTemplate *self, LogMessage **messages, gint num_messages, LogTemplateOptions *opts, gint tz, gint32 seq_num, const gchar *context_id, GString *result)
 {
-  GList *p;
-  LogTemplateElem *e;
-  
-  for (p = self->compiled_template; p; p = g_list_next(p))
+  LogTemplateElem *e, *end;
+  gsize start_len = result->len;
+
+  /* make room for the expected output in one step, instead of growing
+   * the result element by element */
+  if (result->allocated_len <= start_len + self->size_hint)
+    {
+      g_string_set_size(result, start_len + self->size_hint);
+      g_string_truncate(result, start_len);
+    }
+
+  end = self->compiled_template + self->compiled_template_len;
+  for (e = self->compiled_template; e < end; e++)
     {
       gint msg_ndx;
 
-      e = (LogTemplateElem *) p->data;
-      if (e->text)
-        {
-          g_string_append_len(result, e->text, e->text_len);
-        }
+      if (e->text_len)
+        g_string_append_len(result, e->text, e->text_len);
+
+      if (e->type == LTE_TEXT)
+        continue;
 
       /* NOTE: msg_ref is 1 larger than the index specified by the user in
        * order to make it distinguishable from the zero value.  Therefore
@@ -1189,55 +1201,50 @@ log_template_append_format_with_context(LogTemplate *self, LogMessage **messages
             if (value && value[0])
               result_append(result, value, value_len, self->escape);
             else if (e->default_value)
-              result_append(result, e->default_value, -1, self->escape);
+              result_append(result, e->default_value, e->default_value_len, self->escape);
             break;
           }
         case LTE_MACRO:
           {
             gint len = result->len;
 
-            if (e->macro)
-              {
-                log_macro_expand(result, e->macro, self->escape, opts ? opts : &self->cfg->template_options, tz, seq_num, context_id, messages[msg_ndx]);
-                if (len == result->len && e->default_value)
-                  g_string_append(result, e->default_value);
-              }
+            log_macro_expand(result, e->macro, self->escape, opts ? opts : &self->cfg->template_options, tz, seq_num, context_id, messages[msg_ndx]);
+            if (len == result->len && e->default_value)
+              g_string_append_len(result, e->default_value, e->default_value_len);
             break;
           }
         case LTE_FUNC:
           {
-            g_static_mutex_lock(&self->arg_lock);
-            if (!self->arg_bufs)
-              self->arg_bufs = g_ptr_array_sized_new(0);
-
-            if (1)
+            LogTemplateInvokeArgs args =
               {
-                LogTemplateInvokeArgs args =
-                  {
-                    self->arg_bufs,
-                    e->msg_ref ? &messages[msg_ndx] : messages,
-                    e->msg_ref ? 1 : num_messages,
-                    opts,
-                    tz,
-                    seq_num,
-                    context_id
-                  };
-
-
-                /* if a function call is called with an msg_ref, we only
-                 * pass that given logmsg to argument resolution, otherwise
-                 * we pass the whole set so the arguments can individually
-                 * specify which message they want to resolve from
-                 */
-                if (e->func.ops->eval)
-                  e->func.ops->eval(e->func.ops, e->func.state, &args);
-                e->func.ops->call(e->func.ops, e->func.state, &args, result);
-              }
-            g_static_mutex_unlock(&self->arg_lock);
+                scratch_buffer_array_acquire(),
+                e->msg_ref ? &messages[msg_ndx] : messages,
+                e->msg_ref ? 1 : num_messages,
+                opts,
+                tz,
+                seq_num,
+                context_id
+              };
+
+            /* if a function call is called with an msg_ref, we only
+             * pass that given logmsg to argument resolution, otherwise
+             * we pass the whole set so the arguments can individually
+             * specify which message they want to resolve from
+             *
+             * argument buffers come from the per-thread scratch
+             * buffers, so the same template can be formatted by
+             * several threads in parallel
+             */
+            if (e->func.ops->eval)
+              e->func.ops->eval(e->func.ops, e->func.state, &args);
+            e->func.ops->call(e->func.ops, e->func.state, &args, result);
+            scratch_buffer_array_release(args.bufs);
             break;
           }
         }
     }
+
+  log_template_update_size_hint(&self->size_hint, result->len - start_len);
 }
 
 void
@@ -1276,7 +1283,6 @@ log_template_new(GlobalConfig *cfg, gchar *name)
   self->name = g_strdup(name);
   self->ref_cnt = 1;
   self->cfg = cfg;
-  g_static_mutex_init(&self->arg_lock);
   if (cfg_is_config_version_older(configuration, 0x0300))
     {
       static gboolean warn_written = FALSE;
@@ -1295,18 +1301,9 @@ log_template_new(GlobalConfig *cfg, gchar *name)
 static void 
 log_template_free(LogTemplate *self)
 {
-  if (self->arg_bufs)
-    {
-      gint i;
-
-      for (i = 0; i < self->arg_bufs->len; i++)
-        g_string_free(g_ptr_array_index(self->arg_bufs, i), TRUE);
-      g_ptr_array_free(self->arg_bufs, TRUE);
-    }
   log_template_reset_compiled(self);
   g_free(self->name);
   g_free(self->template);
-  g_static_mutex_free(&self->arg_lock);
   g_free(self);
 }
 
@@ -42,18 +42,22 @@ enum LogTemplateError
   LOG_TEMPLATE_ERROR_COMPILE,
 };
 
+typedef struct _LogTemplateElem LogTemplateElem;
+
 /* structure that represents an expandable syslog-ng template */
 typedef struct _LogTemplate
 {
   gint ref_cnt;
   gchar *name;
   gchar *template;
-  GList *compiled_template;
+  /* compiled form of the template, see log_template_compile() */
+  LogTemplateElem *compiled_template;
+  gint compiled_template_len;
+  /* expected length of the output, used to preallocate the result buffer */
+  gsize size_hint;
   gboolean escape;
   gboolean def_inline;
   GlobalConfig *cfg;
-  GStaticMutex arg_lock;
-  GPtrArray *arg_bufs;
 } LogTemplate;
 
 /* template expansion options that can be influenced by the user and
@@ -93,9 +97,11 @@ extern LogMacroDef macros[];
  * several times. */
 typedef struct _LogTemplateInvokeArgs
 {
-  /* scratch buffers, stores GString *, elements are managed by the
-   * function, storage/free is performed by the core. Can be used to
-   * avoid allocating GString buffers in the fast-path. */
+  /* argument buffers, stores GString *, empty when the function is
+   * invoked.  Elements must be the strings of scratch buffers owned by
+   * the current thread (see sb_string()), they are released by the
+   * core once the function returns. Can be used to avoid allocating
+   * GString buffers in the fast-path. */
 
   GPtrArray *bufs;
 
@@ -123,8 +129,8 @@ struct _LogTemplateFunction
    * representation if necessary.  Returns the compiled state in state */
   gboolean (*prepare)(LogTemplateFunction *self, gpointer state, LogTemplate *parent, gint argc, gchar *argv[], GError **error);
 
-  /* evaluate arguments, storing argument buffers in arg_bufs in case it
-   * makes sense to reuse those buffers */
+  /* evaluate arguments, storing argument buffers in args->bufs in case
+   * it makes sense to reuse those buffers */
   void (*eval)(LogTemplateFunction *self, gpointer state, const LogTemplateInvokeArgs *args);
 
   /* call the function */
@@ -195,6 +201,30 @@ void log_template_append_format_with_context(LogTemplate *self, LogMessage **mes
 void log_template_format_with_context(LogTemplate *self, LogMessage **messages, gint num_messages, LogTemplateOptions *opts, gint tz, gint32 seq_num, const gchar *context_id, GString *result);
 void log_template_append_format_recursive(LogTemplate *self, const LogTemplateInvokeArgs *args, GString *result);
 
+/* outputs larger than this are not preallocated for */
+#define LOG_TEMPLATE_SIZE_HINT_MAX 65536
+
+/*
+ * Update the expected output size after producing @len bytes: it grows
+ * right away, but only decays gradually, so a single large output
+ * doesn't make every later call preallocate too much.
+ *
+ * NOTE: the hint is updated from parallel threads without locking, it is
+ * only a hint, a lost update doesn't matter.
+ */
+static inline void
+log_template_update_size_hint(gsize *size_hint, gsize len)
+{
+  gsize hint = *size_hint;
+
+  len = MIN(len, LOG_TEMPLATE_SIZE_HINT_MAX);
+  if (len > hint)
+    hint = len;
+  else
+    hint -= (hint - len) / 8;
+  *size_hint = hint;
+}
+
 
 /* low level macro functions */
 guint log_macro_lookup(gchar *macro, gint len);
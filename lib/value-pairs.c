@@ -45,6 +45,18 @@ typedef struct
   LogTemplate *template;
 } VPPairConf;
 
+typedef struct
+{
+  gchar *name;
+  gint type;
+  gint id;
+  LogTemplate *template;
+} VPPlanEntry;
+
+/* NVHandles are at most 65535 */
+#define VP_HANDLE_CACHE_CHUNK_SIZE 256
+#define VP_HANDLE_CACHE_CHUNKS     256
+
 struct _ValuePairs
 {
   VPPatternSpec **patterns;
@@ -54,6 +66,12 @@ struct _ValuePairs
   /* guint32 as CfgFlagHandler only supports 32 bit integers */
   guint32 scopes;
   guint32 patterns_size;
+
+  /* macros & pairs with their final names, see vp_compile() */
+  GStaticMutex compile_lock;
+  gint compiled;
+  GArray *plan;
+  gchar **handle_cache[VP_HANDLE_CACHE_CHUNKS];
 };
 
 typedef enum
@@ -72,6 +90,7 @@ enum
 {
   VPT_MACRO,
   VPT_NVPAIR,
+  VPT_TEMPLATE,
 };
 
 typedef struct
@@ -128,9 +147,12 @@ static CfgFlagHandler value_pair_scope[] =
   { "everything",         CFH_SET, offsetof(ValuePairs, scopes), VPS_EVERYTHING },
 };
 
+static void vp_plan_free(ValuePairs *vp);
+
 gboolean
 value_pairs_add_scope(ValuePairs *vp, const gchar *scope)
 {
+  vp_plan_free(vp);
   return cfg_process_flag(value_pair_scope, vp, scope);
 }
 
@@ -141,6 +163,7 @@ value_pairs_add_glob_pattern(ValuePairs *vp, const gchar *pattern,
   gint i;
   VPPatternSpec *p;
 
+  vp_plan_free(vp);
   i = vp->patterns_size++;
   vp->patterns = g_renew(VPPatternSpec *, vp->patterns, vp->patterns_size);
 
@@ -156,6 +179,7 @@ value_pairs_add_pair(ValuePairs *vp, GlobalConfig *cfg, const gchar *key, const
 {
   VPPairConf *p = g_new(VPPairConf, 1);
 
+  vp_plan_free(vp);
   p->name = g_strdup(key);
   p->template = log_template_new(cfg, NULL);
   log_template_compile(p->template, value, NULL);
@@ -185,40 +209,134 @@ vp_transform_apply (ValuePairs *vp, gchar *key)
   return ckey;
 }
 
-/* runs over the name-value pairs requested by the user (e.g. with value_pairs_add_pair) */
+/*
+ * Compiled value-pairs
+ *
+ * The set of macros and explicit pairs to be emitted, along with their
+ * names after the transformations, is resolved at first use into a plan.
+ * The decisions about the message nv-pairs depend only on their handle,
+ * so those are cached per NVHandle, the first time a given handle is
+ * encountered. The cache is a two level table filled lock-free, as
+ * messages may be formatted by several threads at the same time.
+ */
+
+#define VP_EXCLUDED ((gchar *) vp_excluded_marker)
+
+static const gchar vp_excluded_marker[] = "";
+
 static void
-vp_pairs_foreach(gpointer data, gpointer user_data)
+vp_handle_cache_free(ValuePairs *vp)
 {
-  ValuePairs *vp = ((gpointer *)user_data)[0];
-  LogMessage *msg = ((gpointer *)user_data)[2];
-  gint32 seq_num = GPOINTER_TO_INT (((gpointer *)user_data)[3]);
-  GTree *scope_set = ((gpointer *)user_data)[5];
-  ScratchBuffer *sb = scratch_buffer_acquire();
-  VPPairConf *vpc = (VPPairConf *)data;
+  gint i, j;
 
-  log_template_format((LogTemplate *)vpc->template, msg, NULL, LTZ_LOCAL,
-                      seq_num, NULL, sb_string(sb));
+  for (i = 0; i < VP_HANDLE_CACHE_CHUNKS; i++)
+    {
+      if (!vp->handle_cache[i])
+        continue;
 
-  if (!sb_string(sb)->str[0])
+      for (j = 0; j < VP_HANDLE_CACHE_CHUNK_SIZE; j++)
+        {
+          if (vp->handle_cache[i][j] != VP_EXCLUDED)
+            g_free(vp->handle_cache[i][j]);
+        }
+      g_free(vp->handle_cache[i]);
+      vp->handle_cache[i] = NULL;
+    }
+}
+
+static void
+vp_plan_free(ValuePairs *vp)
+{
+  gint i;
+
+  if (vp->plan)
     {
-      scratch_buffer_release(sb);
-      return;
+      for (i = 0; i < vp->plan->len; i++)
+        g_free(g_array_index(vp->plan, VPPlanEntry, i).name);
+      g_array_free(vp->plan, TRUE);
+      vp->plan = NULL;
     }
+  vp_handle_cache_free(vp);
+  vp->compiled = FALSE;
+}
+
+static void
+vp_compile_set(ValuePairs *vp, ValuePairSpec *set, GArray *plan)
+{
+  gint i;
 
-  g_tree_insert(scope_set, vp_transform_apply(vp, vpc->name),
-                sb_string(sb)->str);
-  g_string_steal(sb_string(sb));
-  scratch_buffer_release(sb);
+  for (i = 0; set[i].name; i++)
+    {
+      VPPlanEntry entry;
+      gint j;
+      gboolean exclude = FALSE;
+
+      for (j = 0; j < vp->patterns_size; j++)
+        {
+          if (g_pattern_match_string(vp->patterns[j]->pattern, set[i].name))
+            exclude = !vp->patterns[j]->include;
+        }
+
+      if (exclude)
+	continue;
+
+      entry.name = vp_transform_apply(vp, set[i].name);
+      entry.type = set[i].type;
+      entry.id = set[i].id;
+      entry.template = NULL;
+      g_array_append_val(plan, entry);
+    }
+}
+
+static void
+vp_compile(ValuePairs *vp)
+{
+  GArray *plan;
+  gint i;
+
+  if (g_atomic_int_get(&vp->compiled))
+    return;
+
+  g_static_mutex_lock(&vp->compile_lock);
+  if (!vp->compiled)
+    {
+      plan = g_array_new(FALSE, FALSE, sizeof(VPPlanEntry));
+
+      if (vp->scopes & (VPS_RFC3164 + VPS_RFC5424 + VPS_SELECTED_MACROS))
+        vp_compile_set(vp, rfc3164, plan);
+
+      if (vp->scopes & VPS_RFC5424)
+        vp_compile_set(vp, rfc5424, plan);
+
+      if (vp->scopes & VPS_SELECTED_MACROS)
+        vp_compile_set(vp, selected_macros, plan);
+
+      if (vp->scopes & VPS_ALL_MACROS)
+        vp_compile_set(vp, all_macros, plan);
+
+      /* the explicit key-value pairs come last, so they override anything
+       * above with the same name */
+      for (i = 0; i < vp->vpairs->len; i++)
+        {
+          VPPairConf *vpc = (VPPairConf *) g_ptr_array_index(vp->vpairs, i);
+          VPPlanEntry entry;
+
+          entry.name = vp_transform_apply(vp, vpc->name);
+          entry.type = VPT_TEMPLATE;
+          entry.id = 0;
+          entry.template = vpc->template;
+          g_array_append_val(plan, entry);
+        }
+
+      vp->plan = plan;
+      g_atomic_int_set(&vp->compiled, TRUE);
+    }
+  g_static_mutex_unlock(&vp->compile_lock);
 }
 
-/* runs over the LogMessage nv-pairs, and inserts them unless excluded */
 static gboolean
-vp_msg_nvpairs_foreach(NVHandle handle, gchar *name,
-                       const gchar *value, gssize value_len,
-                       gpointer user_data)
+vp_msg_nvpair_is_included(ValuePairs *vp, NVHandle handle, const gchar *name)
 {
-  ValuePairs *vp = ((gpointer *)user_data)[0];
-  GTree *scope_set = ((gpointer *)user_data)[5];
   gint j;
   gboolean inc = FALSE;
 
@@ -229,64 +347,152 @@ vp_msg_nvpairs_foreach(NVHandle handle, gchar *name,
     }
 
   /* NOTE: dot-nv-pairs include SDATA too */
-  if (((name[0] == '.' && (vp->scopes & VPS_DOT_NV_PAIRS)) ||
-       (name[0] != '.' && (vp->scopes & VPS_NV_PAIRS)) ||
-       (log_msg_is_handle_sdata(handle) && (vp->scopes & VPS_SDATA))) ||
-      inc)
+  return ((name[0] == '.' && (vp->scopes & VPS_DOT_NV_PAIRS)) ||
+          (name[0] != '.' && (vp->scopes & VPS_NV_PAIRS)) ||
+          (log_msg_is_handle_sdata(handle) && (vp->scopes & VPS_SDATA))) ||
+         inc;
+}
+
+/* returns the name to be used for the nv-pair, or NULL if it is excluded */
+static const gchar *
+vp_msg_nvpair_lookup(ValuePairs *vp, NVHandle handle, const gchar *name)
+{
+  gchar **chunk;
+  gchar *key;
+
+  chunk = (gchar **) g_atomic_pointer_get(&vp->handle_cache[handle / VP_HANDLE_CACHE_CHUNK_SIZE]);
+  if (G_UNLIKELY(!chunk))
+    {
+      chunk = g_new0(gchar *, VP_HANDLE_CACHE_CHUNK_SIZE);
+      if (!g_atomic_pointer_compare_and_exchange((volatile gpointer *) &vp->handle_cache[handle / VP_HANDLE_CACHE_CHUNK_SIZE], NULL, chunk))
+        {
+          g_free(chunk);
+          chunk = (gchar **) g_atomic_pointer_get(&vp->handle_cache[handle / VP_HANDLE_CACHE_CHUNK_SIZE]);
+        }
+    }
+
+  key = (gchar *) g_atomic_pointer_get(&chunk[handle % VP_HANDLE_CACHE_CHUNK_SIZE]);
+  if (G_UNLIKELY(!key))
     {
-      /* NOTE: the key is a borrowed reference in the hash, and value is freed */
-      g_tree_insert(scope_set, vp_transform_apply(vp, name), g_strndup(value, value_len));
+      key = vp_msg_nvpair_is_included(vp, handle, name) ? vp_transform_apply(vp, (gchar *) name) : VP_EXCLUDED;
+      if (!g_atomic_pointer_compare_and_exchange((volatile gpointer *) &chunk[handle % VP_HANDLE_CACHE_CHUNK_SIZE], NULL, key))
+        {
+          /* another thread was faster */
+          if (key != VP_EXCLUDED)
+            g_free(key);
+          key = (gchar *) g_atomic_pointer_get(&chunk[handle % VP_HANDLE_CACHE_CHUNK_SIZE]);
+        }
     }
+  return key != VP_EXCLUDED ? key : NULL;
+}
+
+/*
+ * The result set of a single message. Names are borrowed from the plan and
+ * the handle cache, values are stored NUL terminated one after the other
+ * in a scratch buffer, and the entries themselves in another one, so that
+ * nothing is allocated per message once the buffers have grown.
+ */
+typedef struct
+{
+  const gchar *name;
+  gsize value_ofs;
+  gint seq;
+} VPResultEntry;
+
+typedef struct
+{
+  ValuePairs *vp;
+  GString *values;
+  GString *entries;
+  gint num_entries;
+} VPResults;
+
+static inline void
+vp_results_add(VPResults *results, const gchar *name, gsize value_ofs)
+{
+  VPResultEntry entry;
+
+  entry.name = name;
+  entry.value_ofs = value_ofs;
+  entry.seq = results->num_entries++;
+
+  g_string_append_c(results->values, 0);
+  g_string_append_len(results->entries, (gchar *) &entry, sizeof(entry));
+}
+
+/* orders by name, and by insertion order within the same name */
+static gint
+vp_results_cmp(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+  const VPResultEntry *ea = (const VPResultEntry *) a;
+  const VPResultEntry *eb = (const VPResultEntry *) b;
+  GCompareDataFunc compare_func = (GCompareDataFunc) user_data;
+  gint res;
+
+  res = compare_func(ea->name, eb->name, NULL);
+  if (res == 0)
+    res = ea->seq - eb->seq;
+  return res;
+}
+
+/* runs over the LogMessage nv-pairs, and inserts them unless excluded */
+static gboolean
+vp_msg_nvpairs_foreach(NVHandle handle, gchar *name,
+                       const gchar *value, gssize value_len,
+                       gpointer user_data)
+{
+  VPResults *results = (VPResults *) user_data;
+  const gchar *key;
+  gsize value_ofs;
 
+  key = vp_msg_nvpair_lookup(results->vp, handle, name);
+  if (!key)
+    return FALSE;
+
+  value_ofs = results->values->len;
+  g_string_append_len(results->values, value, value_len);
+  vp_results_add(results, key, value_ofs);
   return FALSE;
 }
 
-/* runs over a set of ValuePairSpec structs and merges them into the value-pair set */
+/* runs over the compiled set of macros & pairs and adds the non-empty ones */
 static void
-vp_merge_set(ValuePairs *vp, LogMessage *msg, gint32 seq_num, ValuePairSpec *set, GTree *dest)
+vp_merge_plan(VPResults *results, LogMessage *msg, gint32 seq_num)
 {
+  GArray *plan = results->vp->plan;
   gint i;
-  ScratchBuffer *sb = scratch_buffer_acquire();
 
-  for (i = 0; set[i].name; i++)
+  for (i = 0; i < plan->len; i++)
     {
-      gint j;
-      gboolean exclude = FALSE;
-
-      for (j = 0; j < vp->patterns_size; j++)
-        {
-          if (g_pattern_match_string(vp->patterns[j]->pattern, set[i].name))
-            exclude = !vp->patterns[j]->include;
-        }
-
-      if (exclude)
-	continue;
+      VPPlanEntry *entry = &g_array_index(plan, VPPlanEntry, i);
+      gsize value_ofs = results->values->len;
 
-      switch (set[i].type)
+      switch (entry->type)
         {
         case VPT_MACRO:
-          log_macro_expand(sb_string(sb), set[i].id, FALSE, NULL, LTZ_LOCAL, seq_num, NULL, msg);
+          log_macro_expand(results->values, entry->id, FALSE, NULL, LTZ_LOCAL, seq_num, NULL, msg);
           break;
         case VPT_NVPAIR:
           {
             const gchar *nv;
             gssize len;
 
-            nv = log_msg_get_value(msg, (NVHandle) set[i].id, &len);
-            g_string_append_len(sb_string(sb), nv, len);
+            nv = log_msg_get_value(msg, (NVHandle) entry->id, &len);
+            g_string_append_len(results->values, nv, len);
             break;
           }
+        case VPT_TEMPLATE:
+          log_template_append_format(entry->template, msg, NULL, LTZ_LOCAL, seq_num, NULL, results->values);
+          break;
         default:
           g_assert_not_reached();
         }
 
-      if (!sb_string(sb)->str[0])
-	continue;
+      if (results->values->len == value_ofs)
+        continue;
 
-      g_tree_insert(dest, vp_transform_apply(vp, set[i].name), sb_string(sb)->str);
-      g_string_steal(sb_string(sb));
+      vp_results_add(results, entry->name, value_ofs);
     }
-  scratch_buffer_release(sb);
 }
 
 void
@@ -294,13 +500,19 @@ value_pairs_foreach_sorted (ValuePairs *vp, VPForeachFunc func,
                             GCompareDataFunc compare_func,
                             LogMessage *msg, gint32 seq_num, gpointer user_data)
 {
-  gpointer args[] = { vp, func, msg, GINT_TO_POINTER (seq_num), user_data, NULL };
-  GTree *scope_set;
+  ScratchBuffer *values_sb, *entries_sb;
+  VPResults results;
+  VPResultEntry *entries;
+  gint i;
 
-  scope_set = g_tree_new_full((GCompareDataFunc)compare_func, NULL,
-                              (GDestroyNotify)g_free,
-                              (GDestroyNotify)g_free);
-  args[5] = scope_set;
+  vp_compile(vp);
+
+  values_sb = scratch_buffer_acquire();
+  entries_sb = scratch_buffer_acquire();
+  results.vp = vp;
+  results.values = sb_string(values_sb);
+  results.entries = sb_string(entries_sb);
+  results.num_entries = 0;
 
   /*
    * Build up the base set
@@ -308,27 +520,28 @@ value_pairs_foreach_sorted (ValuePairs *vp, VPForeachFunc func,
   if (vp->scopes & (VPS_NV_PAIRS + VPS_DOT_NV_PAIRS + VPS_SDATA) ||
       vp->patterns_size > 0)
     nv_table_foreach(msg->payload, logmsg_registry,
-                     (NVTableForeachFunc) vp_msg_nvpairs_foreach, args);
-
-  if (vp->scopes & (VPS_RFC3164 + VPS_RFC5424 + VPS_SELECTED_MACROS))
-    vp_merge_set(vp, msg, seq_num, rfc3164, scope_set);
-
-  if (vp->scopes & VPS_RFC5424)
-    vp_merge_set(vp, msg, seq_num, rfc5424, scope_set);
-
-  if (vp->scopes & VPS_SELECTED_MACROS)
-    vp_merge_set(vp, msg, seq_num, selected_macros, scope_set);
+                     (NVTableForeachFunc) vp_msg_nvpairs_foreach, &results);
 
-  if (vp->scopes & VPS_ALL_MACROS)
-    vp_merge_set(vp, msg, seq_num, all_macros, scope_set);
+  /* Merge the macros and the explicit key-value pairs too */
+  vp_merge_plan(&results, msg, seq_num);
 
-  /* Merge the explicit key-value pairs too */
-  g_ptr_array_foreach(vp->vpairs, (GFunc)vp_pairs_foreach, args);
+  entries = (VPResultEntry *) results.entries->str;
+  g_qsort_with_data(entries, results.num_entries, sizeof(VPResultEntry), vp_results_cmp, (gpointer) compare_func);
 
   /* Aaand we run it through the callback! */
-  g_tree_foreach(scope_set, (GTraverseFunc)func, user_data);
+  for (i = 0; i < results.num_entries; i++)
+    {
+      /* the same name may have been added multiple times, the last one wins */
+      if (i + 1 < results.num_entries &&
+          compare_func(entries[i].name, entries[i + 1].name, NULL) == 0)
+        continue;
+
+      if (func(entries[i].name, results.values->str + entries[i].value_ofs, user_data))
+        break;
+    }
 
-  g_tree_destroy(scope_set);
+  scratch_buffer_release(entries_sb);
+  scratch_buffer_release(values_sb);
 }
 
 void
@@ -579,6 +792,7 @@ value_pairs_new(void)
 
   vp = g_new0(ValuePairs, 1);
   vp->vpairs = g_ptr_array_sized_new(8);
+  g_static_mutex_init(&vp->compile_lock);
 
   if (!value_pair_sets_initialized)
     {
@@ -617,6 +831,9 @@ value_pairs_free (ValuePairs *vp)
   gint i;
   GList *l;
 
+  vp_plan_free(vp);
+  g_static_mutex_free(&vp->compile_lock);
+
   for (i = 0; i < vp->vpairs->len; i++)
     vp_free_pair(g_ptr_array_index(vp->vpairs, i));
 
@@ -643,6 +860,7 @@ value_pairs_free (ValuePairs *vp)
 void
 value_pairs_add_transforms(ValuePairs *vp, gpointer vpts)
 {
+  vp_plan_free(vp);
   vp->transforms = g_list_append(vp->transforms, vpts);
 }
 
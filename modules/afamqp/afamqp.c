@@ -35,6 +35,9 @@
 #include <amqp.h>
 #include <amqp_framing.h>
 
+/* number of messages popped from the queue at once */
+#define AFAMQP_POP_BATCH 64
+
 typedef struct
 {
   LogDestDriver super;
@@ -454,34 +457,45 @@ afamqp_worker_publish(AMQPDestDriver *self, LogMessage *msg)
   return success;
 }
 
+/*
+ * Pops a batch of messages and publishes them one by one. They are
+ * kept in the backlog until published, a failure puts the unpublished
+ * ones back to the queue.
+ */
 static gboolean
 afamqp_worker_insert(AMQPDestDriver *self)
 {
-  gboolean success;
-  LogMessage *msg;
-  LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
+  LogMessage *batch[AFAMQP_POP_BATCH];
+  LogPathOptions batch_options[AFAMQP_POP_BATCH];
+  gboolean success = TRUE;
+  gint popped, published = 0, i;
 
   afamqp_dd_connect(self, TRUE);
 
-  success = log_queue_pop_head(self->queue, &msg, &path_options, FALSE, FALSE);
-  if (!success)
-    return TRUE;
-
-  msg_set_context(msg);
-  success = afamqp_worker_publish (self, msg);
-  msg_set_context(NULL);
-
-  if (success)
+  popped = log_queue_pop_batch(self->queue, batch, batch_options, AFAMQP_POP_BATCH, TRUE, FALSE);
+  for (i = 0; i < popped; i++)
     {
-      stats_counter_inc(self->stored_messages);
-      step_sequence_number(&self->seq_num);
-      log_msg_ack(msg, &path_options);
-      log_msg_unref(msg);
+      if (success)
+        {
+          msg_set_context(batch[i]);
+          success = afamqp_worker_publish (self, batch[i]);
+          msg_set_context(NULL);
+
+          if (success)
+            {
+              stats_counter_inc(self->stored_messages);
+              step_sequence_number(&self->seq_num);
+              published++;
+            }
+        }
+      log_msg_unref(batch[i]);
     }
-  else
+
+  log_queue_ack_backlog(self->queue, published);
+  if (!success)
     {
       g_mutex_lock(self->queue_mutex);
-      log_queue_push_head(self->queue, msg, &path_options);
+      log_queue_rewind_backlog(self->queue);
       g_mutex_unlock(self->queue_mutex);
     }
 
@@ -32,6 +32,7 @@
 #define AFFILE_CREATE_DIRS 0x00000008
 #define AFFILE_FSYNC       0x00000010
 #define AFFILE_PRIVILEGED  0x00000020
+#define AFFILE_WILDCARD    0x00000040
 
 gboolean affile_open_file(gchar *name, gint flags,
                           const FilePermOptions *perm_options,
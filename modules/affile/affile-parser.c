@@ -38,6 +38,7 @@ static CfgLexerKeyword affile_keywords[] = {
   { "remove_if_older",    KW_OVERWRITE_IF_OLDER, 0, KWS_OBSOLETE, "overwrite_if_older" },
   { "overwrite_if_older", KW_OVERWRITE_IF_OLDER },
   { "follow_freq",        KW_FOLLOW_FREQ,  },
+  { "max_files",          KW_MAX_FILES, 0x0304 },
 
   { NULL }
 };
@@ -32,6 +32,8 @@
 #include "logproto-record-server.h"
 #include "logproto-text-server.h"
 #include "logproto-linux-proc-kmsg-reader.h"
+#include "timeutils.h"
+#include "inotify-watch.h"
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -42,6 +44,10 @@
 #include <time.h>
 #include <stdlib.h>
 
+#if HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#endif
+
 static inline gboolean
 affile_is_linux_proc_kmsg(const gchar *filename)
 {
@@ -52,6 +58,14 @@ affile_is_linux_proc_kmsg(const gchar *filename)
   return FALSE;
 }
 
+static inline gboolean
+affile_is_wildcard(const gchar *filename)
+{
+  const gchar *basename = strrchr(filename, '/');
+
+  return strpbrk(basename ? basename + 1 : filename, "*?") != NULL;
+}
+
 static inline gboolean
 affile_is_device_node(const gchar *filename)
 {
@@ -80,26 +94,24 @@ affile_sd_open_file(AFFileSourceDriver *self, gchar *name, gint *fd)
 }
 
 static inline gchar *
-affile_sd_format_persist_name(AFFileSourceDriver *self)
+affile_sd_format_persist_name(const gchar *filename)
 {
   static gchar persist_name[1024];
   
-  g_snprintf(persist_name, sizeof(persist_name), "affile_sd_curpos(%s)", self->filename->str);
+  g_snprintf(persist_name, sizeof(persist_name), "affile_sd_curpos(%s)", filename);
   return persist_name;
 }
  
 static void
-affile_sd_recover_state(LogPipe *s, GlobalConfig *cfg, LogProtoServer *proto)
+affile_sd_recover_state(AFFileSourceDriver *self, GlobalConfig *cfg, LogProtoServer *proto, const gchar *filename)
 {
-  AFFileSourceDriver *self = (AFFileSourceDriver *) s;
-
   if ((self->flags & AFFILE_PIPE) || self->reader_options.follow_freq <= 0)
     return;
 
-  if (!log_proto_server_restart_with_state(proto, cfg->state, affile_sd_format_persist_name(self)))
+  if (!log_proto_server_restart_with_state(proto, cfg->state, affile_sd_format_persist_name(filename)))
     {
       msg_error("Error converting persistent state from on-disk format, losing file position information",
-                evt_tag_str("filename", self->filename->str),
+                evt_tag_str("filename", filename),
                 NULL);
       return;
     }
@@ -180,7 +192,7 @@ affile_sd_notify(LogPipe *s, LogPipe *sender, gint notify_code, gpointer user_da
                 self->reader = NULL;
                 close(fd);
               }
-            affile_sd_recover_state(s, cfg, proto);
+            affile_sd_recover_state(self, cfg, proto, self->filename->str);
           }
         else
           {
@@ -207,6 +219,508 @@ affile_sd_queue(LogPipe *s, LogMessage *msg, const LogPathOptions *path_options,
   log_pipe_forward_msg(s, msg, path_options);
 }
 
+/*
+ * Wildcard file sources
+ *
+ * A file source with wildcard characters in its filename follows all the
+ * matching files in the given directory. The directory is watched using
+ * inotify (or rescanned every follow_freq if that is not available) and a
+ * LogReader is created for each matching file.
+ *
+ * At most max_files readers are open at a time, files that have data to
+ * be read but no free slot wait in the pending queue. While there are
+ * pending files, readers give up their slot at the end of each fetch batch
+ * (going to the end of the queue) or once they reach EOF (becoming idle
+ * until the file changes), which results in round-robin reading.
+ */
+
+enum
+{
+  AFFILE_WF_IDLE,
+  AFFILE_WF_PENDING,
+  AFFILE_WF_OPEN,
+};
+
+typedef struct _AFFileWildcardFile
+{
+  LogPipe super;
+  AFFileSourceDriver *owner;
+  gchar *name;
+  GString *filename;
+  LogPipe *reader;
+  gint state;
+  /* the file was removed from the directory while being read, read the
+   * rest of it and then let go */
+  gboolean deleted;
+  /* size & mtime at the time the file became idle, used to notice changes while polling */
+  off_t idle_size;
+  time_t idle_mtime;
+} AFFileWildcardFile;
+
+static void affile_sd_wildcard_file_notify(AFFileSourceDriver *self, AFFileWildcardFile *wf, gint notify_code);
+
+static void
+affile_wf_queue(LogPipe *s, LogMessage *msg, const LogPathOptions *path_options, gpointer user_data)
+{
+  AFFileWildcardFile *self = (AFFileWildcardFile *) s;
+  static NVHandle filename_handle = 0;
+
+  if (!filename_handle)
+    filename_handle = log_msg_get_value_handle("FILE_NAME");
+
+  log_msg_set_value(msg, filename_handle, self->filename->str, self->filename->len);
+
+  log_pipe_forward_msg(&self->owner->super.super.super, msg, path_options);
+}
+
+static void
+affile_wf_notify(LogPipe *s, LogPipe *sender, gint notify_code, gpointer user_data)
+{
+  AFFileWildcardFile *self = (AFFileWildcardFile *) s;
+
+  affile_sd_wildcard_file_notify(self->owner, self, notify_code);
+}
+
+static void
+affile_wf_free(LogPipe *s)
+{
+  AFFileWildcardFile *self = (AFFileWildcardFile *) s;
+
+  g_assert(!self->reader);
+  g_free(self->name);
+  g_string_free(self->filename, TRUE);
+  log_pipe_free_method(s);
+}
+
+static AFFileWildcardFile *
+affile_wf_new(AFFileSourceDriver *owner, const gchar *name)
+{
+  AFFileWildcardFile *self = g_new0(AFFileWildcardFile, 1);
+
+  log_pipe_init_instance(&self->super);
+  self->super.queue = affile_wf_queue;
+  self->super.notify = affile_wf_notify;
+  self->super.free_fn = affile_wf_free;
+  self->owner = owner;
+  self->name = g_strdup(name);
+  self->filename = g_string_new(owner->wildcard_dir);
+  g_string_append_c(self->filename, G_DIR_SEPARATOR);
+  g_string_append(self->filename, name);
+  self->state = AFFILE_WF_IDLE;
+  return self;
+}
+
+static gboolean
+affile_sd_wildcard_open(AFFileSourceDriver *self, AFFileWildcardFile *wf)
+{
+  GlobalConfig *cfg = log_pipe_get_config(&self->super.super.super);
+  LogProtoServer *proto;
+  gint fd;
+
+  if (!affile_sd_open_file(self, wf->filename->str, &fd))
+    {
+      msg_error("Error opening file for reading",
+                evt_tag_str("filename", wf->filename->str),
+                evt_tag_errno(EVT_TAG_OSERROR, errno),
+                NULL);
+      return FALSE;
+    }
+
+  proto = affile_sd_construct_proto(self, fd);
+  wf->reader = log_reader_new(proto);
+
+  log_reader_set_options(wf->reader, &wf->super, &self->reader_options, 1, SCS_FILE, self->super.super.id, wf->filename->str);
+  log_reader_set_follow_filename(wf->reader, wf->filename->str);
+  log_reader_set_immediate_check(wf->reader);
+
+  log_pipe_append(wf->reader, &wf->super);
+  if (!log_pipe_init(wf->reader, cfg))
+    {
+      msg_error("Error initializing log_reader, closing fd",
+                evt_tag_int("fd", fd),
+                NULL);
+      log_pipe_unref(wf->reader);
+      wf->reader = NULL;
+      close(fd);
+      return FALSE;
+    }
+  affile_sd_recover_state(self, cfg, proto, wf->filename->str);
+  wf->state = AFFILE_WF_OPEN;
+  wf->deleted = FALSE;
+  self->num_open_files++;
+  return TRUE;
+}
+
+static void
+affile_sd_wildcard_close(AFFileSourceDriver *self, AFFileWildcardFile *wf)
+{
+  log_pipe_deinit(wf->reader);
+  log_pipe_unref(wf->reader);
+  wf->reader = NULL;
+  wf->state = AFFILE_WF_IDLE;
+  self->num_open_files--;
+}
+
+static void
+affile_sd_wildcard_remove(AFFileSourceDriver *self, AFFileWildcardFile *wf)
+{
+  if (wf->state == AFFILE_WF_OPEN)
+    affile_sd_wildcard_close(self, wf);
+  else if (wf->state == AFFILE_WF_PENDING)
+    g_queue_remove(self->wildcard_pending, wf);
+  g_hash_table_remove(self->wildcard_files, wf->name);
+}
+
+static void
+affile_sd_wildcard_preempt_reader(gpointer key, gpointer value, gpointer user_data)
+{
+  AFFileWildcardFile *wf = (AFFileWildcardFile *) value;
+
+  if (wf->state == AFFILE_WF_OPEN)
+    log_reader_trigger_fetch(wf->reader);
+}
+
+/* the file has data to be read, open it if there's a free slot, queue it otherwise */
+static void
+affile_sd_wildcard_schedule(AFFileSourceDriver *self, AFFileWildcardFile *wf)
+{
+  if (self->num_open_files < self->max_files)
+    {
+      if (!affile_sd_wildcard_open(self, wf))
+        affile_sd_wildcard_remove(self, wf);
+      return;
+    }
+
+  wf->state = AFFILE_WF_PENDING;
+  g_queue_push_tail(self->wildcard_pending, wf);
+
+  /* the first file to wait for a slot: make the open readers report back
+   * (NC_FILE_EOF/NC_FILE_SKIP), even if they are idle */
+  if (g_queue_get_length(self->wildcard_pending) == 1)
+    g_hash_table_foreach(self->wildcard_files, affile_sd_wildcard_preempt_reader, NULL);
+}
+
+static void
+affile_sd_wildcard_fill_slots(AFFileSourceDriver *self)
+{
+  AFFileWildcardFile *wf;
+
+  while (self->num_open_files < self->max_files &&
+         (wf = g_queue_pop_head(self->wildcard_pending)))
+    {
+      if (!affile_sd_wildcard_open(self, wf))
+        g_hash_table_remove(self->wildcard_files, wf->name);
+    }
+}
+
+/* NOTE: runs in the main thread */
+static void
+affile_sd_wildcard_file_notify(AFFileSourceDriver *self, AFFileWildcardFile *wf, gint notify_code)
+{
+  struct stat st;
+
+  if (wf->state != AFFILE_WF_OPEN)
+    return;
+
+  /* closing the reader drops its reference to wf */
+  log_pipe_ref(&wf->super);
+  switch (notify_code)
+    {
+    case NC_FILE_EOF:
+      if (wf->deleted)
+        {
+          /* the removed file was read to its end, start following its
+           * replacement if there's one */
+          affile_sd_wildcard_close(self, wf);
+          if (stat(wf->filename->str, &st) >= 0 && S_ISREG(st.st_mode))
+            affile_sd_wildcard_schedule(self, wf);
+          else
+            affile_sd_wildcard_remove(self, wf);
+        }
+      else if (!g_queue_is_empty(self->wildcard_pending))
+        {
+          affile_sd_wildcard_close(self, wf);
+          if (stat(wf->filename->str, &st) >= 0)
+            {
+              wf->idle_size = st.st_size;
+              wf->idle_mtime = st.st_mtime;
+            }
+        }
+      break;
+    case NC_FILE_SKIP:
+      if (!wf->deleted && !g_queue_is_empty(self->wildcard_pending))
+        {
+          affile_sd_wildcard_close(self, wf);
+          wf->state = AFFILE_WF_PENDING;
+          g_queue_push_tail(self->wildcard_pending, wf);
+        }
+      break;
+    case NC_FILE_MOVED:
+      msg_verbose("Follow-mode file source moved, tracking of the new file is started",
+                  evt_tag_str("filename", wf->filename->str),
+                  NULL);
+      affile_sd_wildcard_close(self, wf);
+      affile_sd_wildcard_schedule(self, wf);
+      break;
+    case NC_CLOSE:
+    case NC_READ_ERROR:
+      affile_sd_wildcard_remove(self, wf);
+      break;
+    default:
+      break;
+    }
+  affile_sd_wildcard_fill_slots(self);
+  log_pipe_unref(&wf->super);
+}
+
+static void
+affile_sd_wildcard_add(AFFileSourceDriver *self, const gchar *name)
+{
+  AFFileWildcardFile *wf;
+  struct stat st;
+
+  wf = affile_wf_new(self, name);
+  if (stat(wf->filename->str, &st) < 0 || !S_ISREG(st.st_mode))
+    {
+      log_pipe_unref(&wf->super);
+      return;
+    }
+
+  msg_verbose("Wildcard file source found a new file",
+              evt_tag_str("filename", wf->filename->str),
+              NULL);
+  log_pipe_init(&wf->super, log_pipe_get_config(&self->super.super.super));
+  g_hash_table_insert(self->wildcard_files, wf->name, wf);
+  affile_sd_wildcard_schedule(self, wf);
+}
+
+static void
+affile_sd_wildcard_file_changed(AFFileSourceDriver *self, const gchar *name, gboolean removed)
+{
+  AFFileWildcardFile *wf;
+
+  if (!g_pattern_match_string(self->wildcard_pattern, name))
+    return;
+
+  wf = g_hash_table_lookup(self->wildcard_files, name);
+  if (removed)
+    {
+      if (!wf)
+        return;
+
+      if (wf->state == AFFILE_WF_OPEN)
+        {
+          /* read what's left, NC_FILE_EOF takes care of the rest */
+          wf->deleted = TRUE;
+          log_reader_trigger_fetch(wf->reader);
+        }
+      else
+        {
+          affile_sd_wildcard_remove(self, wf);
+        }
+    }
+  else if (!wf)
+    {
+      affile_sd_wildcard_add(self, name);
+    }
+  else if (wf->state == AFFILE_WF_IDLE)
+    {
+      affile_sd_wildcard_schedule(self, wf);
+    }
+}
+
+static void
+affile_sd_wildcard_collect_missing(gpointer key, gpointer value, gpointer user_data)
+{
+  gpointer *args = (gpointer *) user_data;
+  GHashTable *seen = args[0];
+  GList **missing = args[1];
+
+  if (!g_hash_table_lookup(seen, key))
+    *missing = g_list_prepend(*missing, key);
+}
+
+static void
+affile_sd_wildcard_rescan(AFFileSourceDriver *self)
+{
+  GHashTable *seen;
+  GList *missing = NULL, *l;
+  gpointer args[] = { NULL, &missing };
+  GDir *dir;
+  const gchar *name;
+
+  seen = g_hash_table_new(g_str_hash, g_str_equal);
+  dir = g_dir_open(self->wildcard_dir, 0, NULL);
+  if (dir)
+    {
+      while ((name = g_dir_read_name(dir)))
+        {
+          AFFileWildcardFile *wf;
+          struct stat st;
+
+          if (!g_pattern_match_string(self->wildcard_pattern, name))
+            continue;
+
+          wf = g_hash_table_lookup(self->wildcard_files, name);
+          if (!wf)
+            {
+              affile_sd_wildcard_add(self, name);
+              wf = g_hash_table_lookup(self->wildcard_files, name);
+            }
+          else if (wf->state == AFFILE_WF_IDLE &&
+                   stat(wf->filename->str, &st) >= 0 &&
+                   (st.st_size != wf->idle_size || st.st_mtime != wf->idle_mtime))
+            {
+              affile_sd_wildcard_schedule(self, wf);
+              wf = g_hash_table_lookup(self->wildcard_files, name);
+            }
+          if (wf)
+            g_hash_table_insert(seen, wf->name, wf);
+        }
+      g_dir_close(dir);
+    }
+
+  /* files that disappeared since the last scan */
+  args[0] = seen;
+  g_hash_table_foreach(self->wildcard_files, affile_sd_wildcard_collect_missing, args);
+  for (l = missing; l; l = l->next)
+    affile_sd_wildcard_file_changed(self, (gchar *) l->data, TRUE);
+  g_list_free(missing);
+  g_hash_table_destroy(seen);
+}
+
+static void
+affile_sd_wildcard_arm_rescan(AFFileSourceDriver *self)
+{
+  iv_validate_now();
+  self->rescan_timer.expires = iv_now;
+  timespec_add_msec(&self->rescan_timer.expires, self->reader_options.follow_freq);
+  iv_timer_register(&self->rescan_timer);
+}
+
+static void
+affile_sd_wildcard_stop_dir_watch(AFFileSourceDriver *self)
+{
+  inotify_watch_stop(&self->dir_watch);
+}
+
+#if HAVE_SYS_INOTIFY_H
+
+/* called by the inotify instance shared with the file readers */
+static void
+affile_sd_wildcard_dir_event(gpointer s, guint32 mask, const gchar *name)
+{
+  AFFileSourceDriver *self = (AFFileSourceDriver *) s;
+
+  if (mask & IN_Q_OVERFLOW)
+    {
+      affile_sd_wildcard_rescan(self);
+    }
+  else if (mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED | IN_UNMOUNT))
+    {
+      msg_verbose("Directory of wildcard file source is gone, polling until it is recreated",
+                  evt_tag_str("directory", self->wildcard_dir),
+                  NULL);
+      affile_sd_wildcard_stop_dir_watch(self);
+      affile_sd_wildcard_arm_rescan(self);
+      affile_sd_wildcard_rescan(self);
+    }
+  else if (name)
+    {
+      affile_sd_wildcard_file_changed(self, name, !!(mask & (IN_DELETE | IN_MOVED_FROM)));
+    }
+}
+
+#endif
+
+/* returns TRUE if the directory is watched via inotify, FALSE if it needs to be rescanned periodically */
+static gboolean
+affile_sd_wildcard_start_dir_watch(AFFileSourceDriver *self)
+{
+#if HAVE_SYS_INOTIFY_H
+  if (self->reader_options.flags & LR_NO_INOTIFY)
+    return FALSE;
+
+  return inotify_watch_start(&self->dir_watch, self->wildcard_dir,
+                             IN_CREATE | IN_MOVED_TO | IN_MODIFY | IN_DELETE | IN_MOVED_FROM |
+                             IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+#else
+  return FALSE;
+#endif
+}
+
+static void
+affile_sd_wildcard_rescan_timer_expired(gpointer s)
+{
+  AFFileSourceDriver *self = (AFFileSourceDriver *) s;
+
+  if (!affile_sd_wildcard_start_dir_watch(self))
+    affile_sd_wildcard_arm_rescan(self);
+  affile_sd_wildcard_rescan(self);
+}
+
+static gboolean
+affile_sd_wildcard_init(AFFileSourceDriver *self)
+{
+  if (self->reader_options.follow_freq <= 0)
+    {
+      msg_error("Wildcard file sources require follow_freq() to be set",
+                evt_tag_str("filename", self->filename->str),
+                NULL);
+      return FALSE;
+    }
+
+  /* make the readers report the end of each fetch batch, so that they can be rotated */
+  self->reader_options.flags |= LR_PREEMPT;
+
+  self->wildcard_files = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, (GDestroyNotify) log_pipe_unref);
+  self->wildcard_pending = g_queue_new();
+  self->num_open_files = 0;
+
+  if (!affile_sd_wildcard_start_dir_watch(self))
+    {
+      msg_verbose("Unable to watch the directory of wildcard file source, polling it instead",
+                  evt_tag_str("directory", self->wildcard_dir),
+                  evt_tag_int("follow_freq", self->reader_options.follow_freq),
+                  NULL);
+      affile_sd_wildcard_arm_rescan(self);
+    }
+  affile_sd_wildcard_rescan(self);
+  return TRUE;
+}
+
+static void
+affile_sd_wildcard_close_file(gpointer key, gpointer value, gpointer user_data)
+{
+  AFFileSourceDriver *self = (AFFileSourceDriver *) user_data;
+  AFFileWildcardFile *wf = (AFFileWildcardFile *) value;
+
+  if (wf->state == AFFILE_WF_OPEN)
+    affile_sd_wildcard_close(self, wf);
+}
+
+static void
+affile_sd_wildcard_deinit(AFFileSourceDriver *self)
+{
+  affile_sd_wildcard_stop_dir_watch(self);
+  if (iv_timer_registered(&self->rescan_timer))
+    iv_timer_unregister(&self->rescan_timer);
+
+  g_hash_table_foreach(self->wildcard_files, affile_sd_wildcard_close_file, self);
+  g_queue_free(self->wildcard_pending);
+  self->wildcard_pending = NULL;
+  g_hash_table_destroy(self->wildcard_files);
+  self->wildcard_files = NULL;
+}
+
+void
+affile_sd_set_max_files(LogDriver *s, gint max_files)
+{
+  AFFileSourceDriver *self = (AFFileSourceDriver *) s;
+
+  self->max_files = max_files;
+}
+
 static gboolean
 affile_sd_init(LogPipe *s)
 {
@@ -220,6 +734,9 @@ affile_sd_init(LogPipe *s)
 
   log_reader_options_init(&self->reader_options, cfg, self->super.super.group);
 
+  if (self->flags & AFFILE_WILDCARD)
+    return affile_sd_wildcard_init(self);
+
   file_opened = affile_sd_open_file(self, self->filename->str, &fd);
   if (!file_opened && self->reader_options.follow_freq > 0)
     {
@@ -257,7 +774,7 @@ affile_sd_init(LogPipe *s)
           close(fd);
           return FALSE;
         }
-      affile_sd_recover_state(s, cfg, proto);
+      affile_sd_recover_state(self, cfg, proto, self->filename->str);
     }
   else
     {
@@ -276,6 +793,9 @@ affile_sd_deinit(LogPipe *s)
 {
   AFFileSourceDriver *self = (AFFileSourceDriver *) s;
 
+  if (self->flags & AFFILE_WILDCARD)
+    affile_sd_wildcard_deinit(self);
+
   if (self->reader)
     {
       log_pipe_deinit(self->reader);
@@ -296,6 +816,9 @@ affile_sd_free(LogPipe *s)
 
   g_string_free(self->filename, TRUE);
   g_assert(!self->reader);
+  g_free(self->wildcard_dir);
+  if (self->wildcard_pattern)
+    g_pattern_spec_free(self->wildcard_pattern);
 
   log_reader_options_destroy(&self->reader_options);
 
@@ -319,6 +842,26 @@ affile_sd_new(gchar *filename, guint32 flags)
   file_perm_options_defaults(&self->file_perm_options);
   self->reader_options.parse_options.flags |= LP_LOCAL;
 
+#if HAVE_SYS_INOTIFY_H
+  inotify_watch_init(&self->dir_watch, self, affile_sd_wildcard_dir_event);
+#else
+  inotify_watch_init(&self->dir_watch, self, NULL);
+#endif
+  IV_TIMER_INIT(&self->rescan_timer);
+  self->rescan_timer.cookie = self;
+  self->rescan_timer.handler = affile_sd_wildcard_rescan_timer_expired;
+
+  if ((self->flags & AFFILE_PIPE) == 0 && affile_is_wildcard(filename))
+    {
+      gchar *basename = g_path_get_basename(filename);
+
+      self->flags |= AFFILE_WILDCARD;
+      self->wildcard_dir = g_path_get_dirname(filename);
+      self->wildcard_pattern = g_pattern_spec_new(basename);
+      self->max_files = 100;
+      g_free(basename);
+    }
+
   if ((self->flags & AFFILE_PIPE))
     {
       static gboolean warned = FALSE;
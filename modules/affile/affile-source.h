@@ -27,6 +27,9 @@
 #include "driver.h"
 #include "logreader.h"
 #include "file-perms.h"
+#include "inotify-watch.h"
+
+#include <iv.h>
 
 typedef struct _AFFileSourceDriver
 {
@@ -39,9 +42,18 @@ typedef struct _AFFileSourceDriver
   gint pad_size;
   guint32 flags;
   /* state information to follow a set of files using a wildcard expression */
+  gchar *wildcard_dir;
+  GPatternSpec *wildcard_pattern;
+  gint max_files;
+  gint num_open_files;
+  GHashTable *wildcard_files;
+  GQueue *wildcard_pending;
+  InotifyWatch dir_watch;
+  struct iv_timer rescan_timer;
 } AFFileSourceDriver;
 
 LogDriver *affile_sd_new(gchar *filename, guint32 flags);
+void affile_sd_set_max_files(LogDriver *s, gint max_files);
 void affile_sd_set_recursion(LogDriver *s, const gint recursion);
 void affile_sd_set_pri_level(LogDriver *s, const gint16 severity);
 void affile_sd_set_pri_facility(LogDriver *s, const gint16 facility);
@@ -39,6 +39,8 @@ static CfgLexerKeyword afmongodb_keywords[] = {
   { "host",                     KW_HOST },
   { "port",                     KW_PORT },
   { "path",                     KW_PATH },
+  { "flush_lines",              KW_FLUSH_LINES },
+  { "flush_timeout",            KW_FLUSH_TIMEOUT },
   { NULL }
 };
 
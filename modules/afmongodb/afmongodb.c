@@ -56,6 +56,8 @@ typedef struct
   gint port;
 
   gboolean safe_mode;
+  gint flush_lines;
+  gint flush_timeout;
 
   gchar *user;
   gchar *password;
@@ -87,7 +89,14 @@ typedef struct
   gchar *ns;
 
   GString *current_value;
-  bson *bson;
+  /* documents of the bulk insert being assembled, reused between bulks;
+   * the messages belonging to them are kept in the backlog */
+  bson **bulk;
+  gint bulk_len;
+  GTimeVal bulk_flush_target;
+  /* messages popped from the queue in one go */
+  LogMessage **batch;
+  LogPathOptions *batch_options;
 } MongoDBDestDriver;
 
 /*
@@ -207,6 +216,22 @@ afmongodb_dd_set_safe_mode(LogDriver *d, gboolean state)
   self->safe_mode = state;
 }
 
+void
+afmongodb_dd_set_flush_lines(LogDriver *d, gint flush_lines)
+{
+  MongoDBDestDriver *self = (MongoDBDestDriver *)d;
+
+  self->flush_lines = flush_lines;
+}
+
+void
+afmongodb_dd_set_flush_timeout(LogDriver *d, gint flush_timeout)
+{
+  MongoDBDestDriver *self = (MongoDBDestDriver *)d;
+
+  self->flush_timeout = flush_timeout;
+}
+
 /*
  * Utilities
  */
@@ -374,58 +399,102 @@ afmongodb_vp_process_value(const gchar *name, const gchar *prefix,
 }
 
 static gboolean
-afmongodb_worker_insert (MongoDBDestDriver *self)
+afmongodb_worker_flush (MongoDBDestDriver *self)
 {
-  gboolean success;
-  guint8 *oid;
-  LogMessage *msg;
-  LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
-
-  afmongodb_dd_connect(self, TRUE);
+  gboolean success = TRUE;
 
-  success = log_queue_pop_head(self->queue, &msg, &path_options, FALSE, FALSE);
-  if (!success)
+  if (self->bulk_len == 0)
     return TRUE;
 
-  msg_set_context(msg);
+  if (!mongo_sync_cmd_insert_n(self->conn, self->ns, self->bulk_len,
+                               (const bson **)self->bulk))
+    {
+      msg_error("Network error while inserting into MongoDB",
+                evt_tag_int("time_reopen", self->time_reopen),
+                evt_tag_int("documents", self->bulk_len),
+                NULL);
+      success = FALSE;
+    }
+
+  if (success)
+    {
+      stats_counter_add(self->stored_messages, self->bulk_len);
+      log_queue_ack_backlog(self->queue, self->bulk_len);
+    }
+  else
+    {
+      log_queue_rewind_backlog(self->queue);
+    }
+  self->bulk_len = 0;
 
-  bson_reset (self->bson);
+  return success;
+}
+
+/* formats @msg into the next free document of the bulk */
+static void
+afmongodb_worker_append_document(MongoDBDestDriver *self, LogMessage *msg)
+{
+  guint8 *oid;
+  bson *doc;
+
+  doc = self->bulk[self->bulk_len++];
+  bson_reset (doc);
 
   oid = mongo_util_oid_new_with_time (self->last_msg_stamp, self->seq_num);
-  bson_append_oid (self->bson, "_id", oid);
+  bson_append_oid (doc, "_id", oid);
   g_free (oid);
 
   value_pairs_walk(self->vp,
                    afmongodb_vp_obj_start,
                    afmongodb_vp_process_value,
                    afmongodb_vp_obj_end,
-                   msg, self->seq_num, self->bson);
-  bson_finish (self->bson);
+                   msg, self->seq_num, doc);
+  bson_finish (doc);
+}
 
-  if (!mongo_sync_cmd_insert_n(self->conn, self->ns, 1,
-                               (const bson **)&self->bson))
-    {
-      msg_error("Network error while inserting into MongoDB",
-                evt_tag_int("time_reopen", self->time_reopen),
-                NULL);
-      success = FALSE;
-    }
+static gboolean
+afmongodb_worker_insert (MongoDBDestDriver *self)
+{
+  gint popped, i;
+
+  afmongodb_dd_connect(self, TRUE);
 
-  msg_set_context(NULL);
+  popped = log_queue_pop_batch(self->queue, self->batch, self->batch_options,
+                               self->flush_lines - self->bulk_len, TRUE, FALSE);
+  if (popped == 0)
+    return TRUE;
 
-  if (success)
+  if (self->bulk_len == 0)
     {
-      stats_counter_inc(self->stored_messages);
-      step_sequence_number(&self->seq_num);
-      log_msg_ack(msg, &path_options);
-      log_msg_unref(msg);
+      g_get_current_time(&self->bulk_flush_target);
+      g_time_val_add(&self->bulk_flush_target, self->flush_timeout * 1000);
     }
-  else
+
+  for (i = 0; i < popped; i++)
     {
-      log_queue_push_head(self->queue, msg, &path_options);
+      msg_set_context(self->batch[i]);
+      afmongodb_worker_append_document(self, self->batch[i]);
+      msg_set_context(NULL);
+
+      /* the message itself is held by the backlog until the bulk is sent */
+      log_msg_unref(self->batch[i]);
+      step_sequence_number(&self->seq_num);
     }
 
-  return success;
+  if (self->bulk_len >= self->flush_lines)
+    return afmongodb_worker_flush(self);
+  return TRUE;
+}
+
+/* returns TRUE if the pending bulk has waited flush_timeout() already */
+static gboolean
+afmongodb_worker_flush_timeout_expired(MongoDBDestDriver *self)
+{
+  GTimeVal now;
+
+  g_get_current_time(&now);
+  return now.tv_sec > self->bulk_flush_target.tv_sec ||
+         (now.tv_sec == self->bulk_flush_target.tv_sec && now.tv_usec >= self->bulk_flush_target.tv_usec);
 }
 
 static void
@@ -442,6 +511,7 @@ static gpointer
 afmongodb_worker_thread (gpointer arg)
 {
   MongoDBDestDriver *self = (MongoDBDestDriver *)arg;
+  gint i;
 
   msg_debug ("Worker thread started",
 	     evt_tag_str("driver", self->super.super.id),
@@ -453,7 +523,12 @@ afmongodb_worker_thread (gpointer arg)
 
   self->current_value = g_string_sized_new(256);
 
-  self->bson = bson_new_sized(4096);
+  self->bulk = g_new(bson *, self->flush_lines);
+  for (i = 0; i < self->flush_lines; i++)
+    self->bulk[i] = bson_new_sized(4096);
+  self->bulk_len = 0;
+  self->batch = g_new(LogMessage *, self->flush_lines);
+  self->batch_options = g_new(LogPathOptions, self->flush_lines);
 
   while (!self->writer_thread_terminate)
     {
@@ -468,8 +543,23 @@ afmongodb_worker_thread (gpointer arg)
 	}
       else if (!log_queue_check_items(self->queue, NULL, afmongodb_dd_message_became_available_in_the_queue, self, NULL))
 	{
-	  g_cond_wait(self->writer_thread_wakeup_cond, self->suspend_mutex);
+	  if (self->bulk_len == 0)
+	    g_cond_wait(self->writer_thread_wakeup_cond, self->suspend_mutex);
+	  else if (!afmongodb_worker_flush_timeout_expired(self))
+	    g_cond_timed_wait(self->writer_thread_wakeup_cond,
+			      self->suspend_mutex,
+			      &self->bulk_flush_target);
 	  g_mutex_unlock(self->suspend_mutex);
+
+	  /* the queue is still empty and the bulk is old enough, send it */
+	  if (self->bulk_len > 0 && !self->writer_thread_terminate &&
+	      afmongodb_worker_flush_timeout_expired(self) &&
+	      !afmongodb_worker_flush(self))
+	    {
+	      afmongodb_dd_disconnect(self);
+	      afmongodb_dd_suspend(self);
+	    }
+	  continue;
 	}
       else
         g_mutex_unlock(self->suspend_mutex);
@@ -484,12 +574,21 @@ afmongodb_worker_thread (gpointer arg)
 	}
     }
 
+  /* whatever could not be sent goes back to the queue */
+  if (self->bulk_len > 0 && (!self->conn || !afmongodb_worker_flush(self)))
+    log_queue_rewind_backlog(self->queue);
+  self->bulk_len = 0;
+
   afmongodb_dd_disconnect(self);
 
   g_free (self->ns);
   g_string_free (self->current_value, TRUE);
 
-  bson_free (self->bson);
+  for (i = 0; i < self->flush_lines; i++)
+    bson_free (self->bulk[i]);
+  g_free (self->bulk);
+  g_free (self->batch);
+  g_free (self->batch_options);
 
   msg_debug ("Worker thread finished",
 	     evt_tag_str("driver", self->super.super.id),
@@ -529,7 +628,17 @@ afmongodb_dd_init(LogPipe *s)
     return FALSE;
 
   if (cfg)
-    self->time_reopen = cfg->time_reopen;
+    {
+      self->time_reopen = cfg->time_reopen;
+      if (self->flush_lines == -1)
+        self->flush_lines = cfg->flush_lines;
+      if (self->flush_timeout == -1)
+        self->flush_timeout = cfg->flush_timeout;
+    }
+  if (self->flush_lines < 1)
+    self->flush_lines = 1;
+  if (self->flush_timeout < 0)
+    self->flush_timeout = 0;
 
   if (!self->vp)
     {
@@ -682,6 +791,8 @@ afmongodb_dd_new(void)
   afmongodb_dd_set_database((LogDriver *)self, "syslog");
   afmongodb_dd_set_collection((LogDriver *)self, "messages");
   afmongodb_dd_set_safe_mode((LogDriver *)self, FALSE);
+  afmongodb_dd_set_flush_lines((LogDriver *)self, -1);
+  afmongodb_dd_set_flush_timeout((LogDriver *)self, -1);
 
   init_sequence_number(&self->seq_num);
 
@@ -1,384 +0,0 @@
-/* A Bison parser, made by GNU Bison 2.5.  */
-
-/* Bison interface for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2011 Free Software Foundation, Inc.
-   
-   This program is free software: you can redistribute it and/or modify
-   it under the terms of the GNU General Public License as published by
-   the Free Software Foundation, either version 3 of the License, or
-   (at your option) any later version.
-   
-   This program is distributed in the hope that it will be useful,
-   but WITHOUT ANY WARRANTY; without even the implied warranty of
-   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-   GNU General Public License for more details.
-   
-   You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
-
-/* As a special exception, you may create a larger work that contains
-   part or all of the Bison parser skeleton and distribute that work
-   under terms of your choice, so long as that work isn't itself a
-   parser generator using the skeleton or a modified version thereof
-   as a parser skeleton.  Alternatively, if you modify or redistribute
-   the parser skeleton itself, you may (at your option) remove this
-   special exception, which will cause the skeleton and the resulting
-   Bison output files to be licensed under the GNU General Public
-   License without this special exception.
-   
-   This special exception was added by the Free Software Foundation in
-   version 2.2 of Bison.  */
-
-/* "%code requires" blocks.  */
-
-/* Line 2068 of yacc.c  */
-#line 24 "afredis-grammar.y"
-
-
-#include "afredis-parser.h"
-
-
-
-
-/* Line 2068 of yacc.c  */
-#line 46 "../../../modules/afredis/afredis-grammar.h"
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     LL_CONTEXT_ROOT = 1,
-     LL_CONTEXT_DESTINATION = 2,
-     LL_CONTEXT_SOURCE = 3,
-     LL_CONTEXT_PARSER = 4,
-     LL_CONTEXT_REWRITE = 5,
-     LL_CONTEXT_FILTER = 6,
-     LL_CONTEXT_LOG = 7,
-     LL_CONTEXT_BLOCK_DEF = 8,
-     LL_CONTEXT_BLOCK_REF = 9,
-     LL_CONTEXT_BLOCK_CONTENT = 10,
-     LL_CONTEXT_BLOCK_ARG = 11,
-     LL_CONTEXT_PRAGMA = 12,
-     LL_CONTEXT_FORMAT = 13,
-     LL_CONTEXT_TEMPLATE_FUNC = 14,
-     LL_CONTEXT_INNER_DEST = 15,
-     LL_CONTEXT_INNER_SRC = 16,
-     LL_CONTEXT_CLIENT_PROTO = 17,
-     LL_CONTEXT_SERVER_PROTO = 18,
-     KW_SOURCE = 10000,
-     KW_FILTER = 10001,
-     KW_PARSER = 10002,
-     KW_DESTINATION = 10003,
-     KW_LOG = 10004,
-     KW_OPTIONS = 10005,
-     KW_INCLUDE = 10006,
-     KW_BLOCK = 10007,
-     KW_JUNCTION = 10008,
-     KW_CHANNEL = 10009,
-     KW_INTERNAL = 10010,
-     KW_FILE = 10011,
-     KW_SQL = 10030,
-     KW_TYPE = 10031,
-     KW_COLUMNS = 10032,
-     KW_INDEXES = 10033,
-     KW_VALUES = 10034,
-     KW_PASSWORD = 10035,
-     KW_DATABASE = 10036,
-     KW_USERNAME = 10037,
-     KW_TABLE = 10038,
-     KW_ENCODING = 10039,
-     KW_SESSION_STATEMENTS = 10040,
-     KW_DELIMITERS = 10050,
-     KW_QUOTES = 10051,
-     KW_QUOTE_PAIRS = 10052,
-     KW_NULL = 10053,
-     KW_SYSLOG = 10060,
-     KW_MARK_FREQ = 10071,
-     KW_STATS_FREQ = 10072,
-     KW_STATS_LEVEL = 10073,
-     KW_FLUSH_LINES = 10074,
-     KW_SUPPRESS = 10075,
-     KW_FLUSH_TIMEOUT = 10076,
-     KW_LOG_MSG_SIZE = 10077,
-     KW_FILE_TEMPLATE = 10078,
-     KW_PROTO_TEMPLATE = 10079,
-     KW_MARK_MODE = 10080,
-     KW_CHAIN_HOSTNAMES = 10090,
-     KW_NORMALIZE_HOSTNAMES = 10091,
-     KW_KEEP_HOSTNAME = 10092,
-     KW_CHECK_HOSTNAME = 10093,
-     KW_BAD_HOSTNAME = 10094,
-     KW_KEEP_TIMESTAMP = 10100,
-     KW_USE_DNS = 10110,
-     KW_USE_FQDN = 10111,
-     KW_DNS_CACHE = 10120,
-     KW_DNS_CACHE_SIZE = 10121,
-     KW_DNS_CACHE_EXPIRE = 10130,
-     KW_DNS_CACHE_EXPIRE_FAILED = 10131,
-     KW_DNS_CACHE_HOSTS = 10132,
-     KW_PERSIST_ONLY = 10140,
-     KW_TZ_CONVERT = 10150,
-     KW_TS_FORMAT = 10151,
-     KW_FRAC_DIGITS = 10152,
-     KW_LOG_FIFO_SIZE = 10160,
-     KW_LOG_FETCH_LIMIT = 10162,
-     KW_LOG_IW_SIZE = 10163,
-     KW_LOG_PREFIX = 10164,
-     KW_PROGRAM_OVERRIDE = 10165,
-     KW_HOST_OVERRIDE = 10166,
-     KW_THROTTLE = 10170,
-     KW_THREADED = 10171,
-     KW_FLAGS = 10190,
-     KW_PAD_SIZE = 10200,
-     KW_TIME_ZONE = 10201,
-     KW_RECV_TIME_ZONE = 10202,
-     KW_SEND_TIME_ZONE = 10203,
-     KW_LOCAL_TIME_ZONE = 10204,
-     KW_FORMAT = 10205,
-     KW_TIME_REOPEN = 10210,
-     KW_TIME_REAP = 10211,
-     KW_TIME_SLEEP = 10212,
-     KW_TMPL_ESCAPE = 10220,
-     KW_OPTIONAL = 10230,
-     KW_CREATE_DIRS = 10240,
-     KW_OWNER = 10250,
-     KW_GROUP = 10251,
-     KW_PERM = 10252,
-     KW_DIR_OWNER = 10260,
-     KW_DIR_GROUP = 10261,
-     KW_DIR_PERM = 10262,
-     KW_TEMPLATE = 10270,
-     KW_TEMPLATE_ESCAPE = 10271,
-     KW_DEFAULT_FACILITY = 10300,
-     KW_DEFAULT_LEVEL = 10301,
-     KW_PORT = 10323,
-     KW_USE_TIME_RECVD = 10340,
-     KW_FACILITY = 10350,
-     KW_LEVEL = 10351,
-     KW_HOST = 10352,
-     KW_MATCH = 10353,
-     KW_MESSAGE = 10354,
-     KW_NETMASK = 10355,
-     KW_TAGS = 10356,
-     KW_VALUE = 10361,
-     KW_REWRITE = 10370,
-     KW_SET = 10371,
-     KW_SUBST = 10372,
-     KW_YES = 10380,
-     KW_NO = 10381,
-     KW_IFDEF = 10410,
-     KW_ENDIF = 10411,
-     LL_DOTDOT = 10420,
-     LL_IDENTIFIER = 10421,
-     LL_NUMBER = 10422,
-     LL_FLOAT = 10423,
-     LL_STRING = 10424,
-     LL_TOKEN = 10425,
-     LL_BLOCK = 10426,
-     LL_PRAGMA = 10427,
-     LL_EOL = 10428,
-     LL_ERROR = 10429,
-     KW_VALUE_PAIRS = 10500,
-     KW_SELECT = 10501,
-     KW_EXCLUDE = 10502,
-     KW_PAIR = 10503,
-     KW_KEY = 10504,
-     KW_SCOPE = 10505,
-     KW_SHIFT = 10506,
-     KW_REKEY = 10507,
-     KW_ADD_PREFIX = 10508,
-     KW_REPLACE = 10509,
-     KW_REDIS = 10511,
-     KW_SUBJECT = 10512,
-     KW_FROM = 10513,
-     KW_TO = 10514,
-     KW_BODY = 10515,
-     KW_HEADER = 10516,
-     KW_CC = 10517,
-     KW_BCC = 10518,
-     KW_SENDER = 10519,
-     KW_REPLY_TO = 10520
-   };
-#endif
-/* Tokens.  */
-#define LL_CONTEXT_ROOT 1
-#define LL_CONTEXT_DESTINATION 2
-#define LL_CONTEXT_SOURCE 3
-#define LL_CONTEXT_PARSER 4
-#define LL_CONTEXT_REWRITE 5
-#define LL_CONTEXT_FILTER 6
-#define LL_CONTEXT_LOG 7
-#define LL_CONTEXT_BLOCK_DEF 8
-#define LL_CONTEXT_BLOCK_REF 9
-#define LL_CONTEXT_BLOCK_CONTENT 10
-#define LL_CONTEXT_BLOCK_ARG 11
-#define LL_CONTEXT_PRAGMA 12
-#define LL_CONTEXT_FORMAT 13
-#define LL_CONTEXT_TEMPLATE_FUNC 14
-#define LL_CONTEXT_INNER_DEST 15
-#define LL_CONTEXT_INNER_SRC 16
-#define LL_CONTEXT_CLIENT_PROTO 17
-#define LL_CONTEXT_SERVER_PROTO 18
-#define KW_SOURCE 10000
-#define KW_FILTER 10001
-#define KW_PARSER 10002
-#define KW_DESTINATION 10003
-#define KW_LOG 10004
-#define KW_OPTIONS 10005
-#define KW_INCLUDE 10006
-#define KW_BLOCK 10007
-#define KW_JUNCTION 10008
-#define KW_CHANNEL 10009
-#define KW_INTERNAL 10010
-#define KW_FILE 10011
-#define KW_SQL 10030
-#define KW_TYPE 10031
-#define KW_COLUMNS 10032
-#define KW_INDEXES 10033
-#define KW_VALUES 10034
-#define KW_PASSWORD 10035
-#define KW_DATABASE 10036
-#define KW_USERNAME 10037
-#define KW_TABLE 10038
-#define KW_ENCODING 10039
-#define KW_SESSION_STATEMENTS 10040
-#define KW_DELIMITERS 10050
-#define KW_QUOTES 10051
-#define KW_QUOTE_PAIRS 10052
-#define KW_NULL 10053
-#define KW_SYSLOG 10060
-#define KW_MARK_FREQ 10071
-#define KW_STATS_FREQ 10072
-#define KW_STATS_LEVEL 10073
-#define KW_FLUSH_LINES 10074
-#define KW_SUPPRESS 10075
-#define KW_FLUSH_TIMEOUT 10076
-#define KW_LOG_MSG_SIZE 10077
-#define KW_FILE_TEMPLATE 10078
-#define KW_PROTO_TEMPLATE 10079
-#define KW_MARK_MODE 10080
-#define KW_CHAIN_HOSTNAMES 10090
-#define KW_NORMALIZE_HOSTNAMES 10091
-#define KW_KEEP_HOSTNAME 10092
-#define KW_CHECK_HOSTNAME 10093
-#define KW_BAD_HOSTNAME 10094
-#define KW_KEEP_TIMESTAMP 10100
-#define KW_USE_DNS 10110
-#define KW_USE_FQDN 10111
-#define KW_DNS_CACHE 10120
-#define KW_DNS_CACHE_SIZE 10121
-#define KW_DNS_CACHE_EXPIRE 10130
-#define KW_DNS_CACHE_EXPIRE_FAILED 10131
-#define KW_DNS_CACHE_HOSTS 10132
-#define KW_PERSIST_ONLY 10140
-#define KW_TZ_CONVERT 10150
-#define KW_TS_FORMAT 10151
-#define KW_FRAC_DIGITS 10152
-#define KW_LOG_FIFO_SIZE 10160
-#define KW_LOG_FETCH_LIMIT 10162
-#define KW_LOG_IW_SIZE 10163
-#define KW_LOG_PREFIX 10164
-#define KW_PROGRAM_OVERRIDE 10165
-#define KW_HOST_OVERRIDE 10166
-#define KW_THROTTLE 10170
-#define KW_THREADED 10171
-#define KW_FLAGS 10190
-#define KW_PAD_SIZE 10200
-#define KW_TIME_ZONE 10201
-#define KW_RECV_TIME_ZONE 10202
-#define KW_SEND_TIME_ZONE 10203
-#define KW_LOCAL_TIME_ZONE 10204
-#define KW_FORMAT 10205
-#define KW_TIME_REOPEN 10210
-#define KW_TIME_REAP 10211
-#define KW_TIME_SLEEP 10212
-#define KW_TMPL_ESCAPE 10220
-#define KW_OPTIONAL 10230
-#define KW_CREATE_DIRS 10240
-#define KW_OWNER 10250
-#define KW_GROUP 10251
-#define KW_PERM 10252
-#define KW_DIR_OWNER 10260
-#define KW_DIR_GROUP 10261
-#define KW_DIR_PERM 10262
-#define KW_TEMPLATE 10270
-#define KW_TEMPLATE_ESCAPE 10271
-#define KW_DEFAULT_FACILITY 10300
-#define KW_DEFAULT_LEVEL 10301
-#define KW_PORT 10323
-#define KW_USE_TIME_RECVD 10340
-#define KW_FACILITY 10350
-#define KW_LEVEL 10351
-#define KW_HOST 10352
-#define KW_MATCH 10353
-#define KW_MESSAGE 10354
-#define KW_NETMASK 10355
-#define KW_TAGS 10356
-#define KW_VALUE 10361
-#define KW_REWRITE 10370
-#define KW_SET 10371
-#define KW_SUBST 10372
-#define KW_YES 10380
-#define KW_NO 10381
-#define KW_IFDEF 10410
-#define KW_ENDIF 10411
-#define LL_DOTDOT 10420
-#define LL_IDENTIFIER 10421
-#define LL_NUMBER 10422
-#define LL_FLOAT 10423
-#define LL_STRING 10424
-#define LL_TOKEN 10425
-#define LL_BLOCK 10426
-#define LL_PRAGMA 10427
-#define LL_EOL 10428
-#define LL_ERROR 10429
-#define KW_VALUE_PAIRS 10500
-#define KW_SELECT 10501
-#define KW_EXCLUDE 10502
-#define KW_PAIR 10503
-#define KW_KEY 10504
-#define KW_SCOPE 10505
-#define KW_SHIFT 10506
-#define KW_REKEY 10507
-#define KW_ADD_PREFIX 10508
-#define KW_REPLACE 10509
-#define KW_REDIS 10511
-#define KW_SUBJECT 10512
-#define KW_FROM 10513
-#define KW_TO 10514
-#define KW_BODY 10515
-#define KW_HEADER 10516
-#define KW_CC 10517
-#define KW_BCC 10518
-#define KW_SENDER 10519
-#define KW_REPLY_TO 10520
-
-
-
-
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-#endif
-
-
-
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
-
-
-
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2012 BalaBit IT Ltd, Budapest, Hungary
+ * Copyright (c) 2011-2013 BalaBit IT Ltd, Budapest, Hungary
  * Copyright (c) 2011-2012 Gergely Nagy <algernon@balabit.hu>
  *
  * This program is free software; you can redistribute it and/or modify it
@@ -21,8 +21,6 @@
  *
  */
 
-#include <signal.h>
-
 #include "afredis.h"
 #include "afredis-parser.h"
 #include "plugin.h"
@@ -30,23 +28,13 @@
 #include "misc.h"
 #include "stats.h"
 #include "logqueue.h"
+#include "templates.h"
 
-#include "hiredis/hiredis.h"
-#include "driver.h"
-
-typedef struct
-{
-  gchar *name;
-  gchar *template;
-  LogTemplate *value;
-} AFREDISHeader;
+#include <hiredis/hiredis.h>
+#include <string.h>
 
-typedef struct
-{
-  gchar *phrase;
-  gchar *address;
-  afredis_rcpt_type_t type;
-} AFREDISRecipient;
+/* number of commands sent in one go, if flush_lines() is not set */
+#define AFREDIS_DEFAULT_PIPELINE_DEPTH 100
 
 typedef struct
 {
@@ -57,19 +45,18 @@ typedef struct
   gchar *host;
   gint port;
 
-  gchar *subject;
-  AFREDISRecipient *mail_from;
-  GList *rcpt_tos;
-  GList *headers;
-  gchar *body;
+  GList *command;
+  gint flush_lines;
 
   time_t time_reopen;
 
   StatsCounterItem *dropped_messages;
   StatsCounterItem *stored_messages;
 
-  LogTemplate *subject_tmpl;
-  LogTemplate *body_tmpl;
+  LogTemplateOptions template_options;
+  /* the templated arguments of the command, argc items */
+  LogTemplate **argv_tmpl;
+  gint argc;
 
   /* Thread related stuff; shared */
   GThread *writer_thread;
@@ -83,126 +70,57 @@ typedef struct
   LogQueue *queue;
 
   /* Writer-only stuff */
+  redisContext *c;
   gint32 seq_num;
-  GString *str;
+  GString **argv_str;
+  const gchar **argv;
+  size_t *argvlen;
+  LogMessage **batch;
+  LogPathOptions *batch_options;
 } AFREDISDriver;
 
-static gchar *
-afredis_wash_string (gchar *str)
-{
-  gint i;
-
-  for (i = 0; i < strlen (str); i++)
-    if (str[i] == '\n' ||
-        str[i] == '\r')
-      str[i] = ' ';
-
-  return str;
-}
-
 /*
  * Configuration
  */
 
 void
 afredis_dd_set_host(LogDriver *d, const gchar *host)
-{   
-  AFREDISDriver *self = (AFREDISDriver *)d;
-    
-  g_free(self->host);
-  self->host = g_strdup (host);
-}
-
-void
-afredis_dd_set_port(LogDriver *d, gint port)
-{
-  AFREDISDriver *self = (AFREDISDriver *)d;
-
-  self->port = (int)port;
-}
-
-void
-afredis_dd_set_subject(LogDriver *d, const gchar *subject)
 {
   AFREDISDriver *self = (AFREDISDriver *)d;
 
-  g_free(self->subject);
-  self->subject = g_strdup(subject);
+  g_free(self->host);
+  self->host = g_strdup(host);
 }
 
 void
-afredis_dd_set_from(LogDriver *d, const gchar *phrase, const gchar *mbox)
+afredis_dd_set_port(LogDriver *d, gint port)
 {
   AFREDISDriver *self = (AFREDISDriver *)d;
 
-  g_free(self->mail_from->phrase);
-  g_free(self->mail_from->address);
-  self->mail_from->phrase = afredis_wash_string(g_strdup(phrase));
-  self->mail_from->address = afredis_wash_string(g_strdup(mbox));
+  self->port = port;
 }
 
 void
-afredis_dd_add_rcpt(LogDriver *d, afredis_rcpt_type_t type, const gchar *phrase,
-                   const gchar *mbox)
+afredis_dd_set_command(LogDriver *d, GList *command)
 {
   AFREDISDriver *self = (AFREDISDriver *)d;
-  AFREDISRecipient *rcpt;
 
-  rcpt = g_new0(AFREDISRecipient, 1);
-  rcpt->phrase = afredis_wash_string(g_strdup(phrase));
-  rcpt->address = afredis_wash_string(g_strdup(mbox));
-  rcpt->type = type;
-
-  self->rcpt_tos = g_list_append(self->rcpt_tos, rcpt);
+  string_list_free(self->command);
+  self->command = command;
 }
 
 void
-afredis_dd_set_body(LogDriver *d, const gchar *body)
-{
-  AFREDISDriver *self = (AFREDISDriver *)d;
-
-  g_free(self->body);
-  self->body = g_strdup(body);
-}
-
-gboolean
-afredis_dd_add_header(LogDriver *d, const gchar *header, const gchar *value)
+afredis_dd_set_flush_lines(LogDriver *d, gint flush_lines)
 {
   AFREDISDriver *self = (AFREDISDriver *)d;
-  AFREDISHeader *h;
-
-  if (!g_ascii_strcasecmp(header, "to") ||
-      !g_ascii_strcasecmp(header, "cc") ||
-      !g_ascii_strcasecmp(header, "bcc") ||
-      !g_ascii_strcasecmp(header, "from") ||
-      !g_ascii_strcasecmp(header, "sender") ||
-      !g_ascii_strcasecmp(header, "reply-to") ||
-      !g_ascii_strcasecmp(header, "date"))
-    return FALSE;
 
-  h = g_new0(AFREDISHeader, 1);
-  h->name = g_strdup(header);
-  h->template = g_strdup(value);
-
-  self->headers = g_list_append(self->headers, h);
-
-  return TRUE;
+  self->flush_lines = flush_lines;
 }
 
 /*
  * Utilities
- */ /*
-void
-ignore_sigpipe (void)
-{
-  struct sigaction sa;
+ */
 
-  sa.sa_handler = SIG_IGN;
-  sigemptyset(&sa.sa_mask);
-  sa.sa_flags = 0;
-  sigaction(SIGPIPE, &sa, NULL);
-}
-*/
 static gchar *
 afredis_dd_format_stats_instance(AFREDISDriver *self)
 {
@@ -212,7 +130,17 @@ afredis_dd_format_stats_instance(AFREDISDriver *self)
              "redis,%s,%u", self->host, self->port);
   return persist_name;
 }
-/*
+
+static gchar *
+afredis_dd_format_persist_name(AFREDISDriver *self)
+{
+  static gchar persist_name[1024];
+
+  g_snprintf(persist_name, sizeof(persist_name),
+             "afredis(%s,%u)", self->host, self->port);
+  return persist_name;
+}
+
 static void
 afredis_dd_suspend(AFREDISDriver *self)
 {
@@ -221,214 +149,123 @@ afredis_dd_suspend(AFREDISDriver *self)
   g_time_val_add(&self->writer_thread_suspend_target,
                  self->time_reopen * 1000000);
 }
-*/
-/*
- * Worker thread
- */ /*
-static void
-afredis_dd_msg_add_recipient(AFREDISRecipient *rcpt, redis_message_t message)
-{
-  gchar *hdr;
-
-  redis_add_recipient(message, rcpt->address);
-
-  switch (rcpt->type)
-    {
-    case AFREDIS_RCPT_TYPE_TO:
-      hdr = "To";
-      break;
-    case AFREDIS_RCPT_TYPE_CC:
-      hdr = "Cc";
-      break;
-    case AFREDIS_RCPT_TYPE_REPLY_TO:
-      hdr = "Reply-To";
-      break;
-    default:
-      return;
-    }
-  redis_set_header(message, hdr, rcpt->phrase, rcpt->address);
-  redis_set_header_option(message, hdr, Hdr_OVERRIDE, 1);
-}
 
 static void
-afredis_dd_msg_add_header(AFREDISHeader *hdr, gpointer user_data)
+afredis_dd_disconnect(AFREDISDriver *self)
 {
-  AFREDISDriver *self = ((gpointer *)user_data)[0];
-  LogMessage *msg = ((gpointer *)user_data)[1];
-  redis_message_t message = ((gpointer *)user_data)[2];
-
-  log_template_format(hdr->value, msg, NULL, LTZ_SEND, self->seq_num, NULL, self->str);
+  if (self->c)
+    redisFree(self->c);
+  self->c = NULL;
+}
 
-  redis_set_header(message, hdr->name, afredis_wash_string (self->str->str), NULL);
-  redis_set_header_option(message, hdr->name, Hdr_OVERRIDE, 1);
-}*/
-/*
-static void
-afredis_dd_log_rcpt_status(redis_recipient_t rcpt, const char *mailbox,
-                          gpointer user_data)
+static gboolean
+afredis_dd_connect(AFREDISDriver *self, gboolean reconnect)
 {
-  const redis_status_t *status;
+  if (reconnect && self->c)
+    return TRUE;
 
-  status = redis_recipient_status(rcpt);
-  msg_debug("REDIS recipient result",
-            evt_tag_str("recipient", mailbox),
-            evt_tag_int("code", status->code),
-            evt_tag_str("text", status->text),
-            NULL);
-}
+  afredis_dd_disconnect(self);
 
-static void
-afredis_dd_cb_event(redis_session_t session, int event, AFREDISDriver *self)
-{
-  switch (event)
+  self->c = redisConnect(self->host, self->port);
+  if (!self->c || self->c->err)
     {
-    case REDIS_EV_CONNECT:
-      msg_verbose("Connected to REDIS server",
-                  evt_tag_str("host", self->host),
-                  evt_tag_int("port", self->port),
-                  NULL);
-      break;
-    case REDIS_EV_MAILSTATUS:
-    case REDIS_EV_RCPTSTATUS:
-    case REDIS_EV_MESSAGEDATA:
-    case REDIS_EV_MESSAGESENT:
-      /* Ignore */ 
-   //   break; 
-   /* case REDIS_EV_DISCONNECT:
-      msg_verbose("Disconnected from REDIS server",
-                  evt_tag_str("host", self->host),
-                  evt_tag_int("port", self->port),
-                  NULL);
-      break;
-    default:
-      msg_verbose("Unknown REDIS event",
-                  evt_tag_int("event_id", event),
-                  NULL);
-      break;
+      msg_error("Error connecting to REDIS server",
+                evt_tag_str("host", self->host),
+                evt_tag_int("port", self->port),
+                evt_tag_str("error", self->c ? self->c->errstr : "out of memory"),
+                evt_tag_int("time_reopen", self->time_reopen),
+                NULL);
+      afredis_dd_disconnect(self);
+      return FALSE;
     }
+
+  msg_verbose("Connected to REDIS server",
+              evt_tag_str("host", self->host),
+              evt_tag_int("port", self->port),
+              NULL);
+  return TRUE;
 }
 
+/*
+ * Worker thread
+ */
+
+/* formats the command for @msg and appends it to the output buffer */
 static void
-afredis_dd_cb_monitor(const gchar *buf, gint buflen, gint writing,
-                     AFREDISDriver *self)
+afredis_worker_append_command(AFREDISDriver *self, LogMessage *msg)
 {
-  gchar fmt[32];
-
-  g_snprintf(fmt, sizeof(fmt), "%%.%us", buflen);
+  gint i;
 
-  switch (writing)
+  for (i = 0; i < self->argc; i++)
     {
-    case REDIS_CB_READING:
-      msg_debug ("REDIS Session: SERVER",
-                 evt_tag_printf("message", fmt, buf),
-                 NULL);
-      break;
-    case REDIS_CB_WRITING:
-      msg_debug("REDIS Session: CLIENT",
-                evt_tag_printf("message", fmt, buf),
-                NULL);
-      break;
-    case REDIS_CB_HEADERS:
-      msg_debug("REDIS Session: HEADERS",
-                evt_tag_printf("data", fmt, buf),
-                NULL);
-      break;
+      log_template_format(self->argv_tmpl[i], msg, &self->template_options,
+                          LTZ_SEND, self->seq_num, NULL, self->argv_str[i]);
+      self->argv[i] = self->argv_str[i]->str;
+      self->argvlen[i] = self->argv_str[i]->len;
     }
+  redisAppendCommandArgv(self->c, self->argc, self->argv, self->argvlen);
 }
 
+/**
+ * afredis_worker_insert:
+ *
+ * Pops up to flush_lines() messages, appends their commands to the
+ * pipeline and sends them to the server in one go. The messages are kept
+ * in the backlog until all the replies have arrived, which is when
+ * they are acknowledged as a unit.
+ *
+ * Returns: FALSE to indicate that the connection should be closed and
+ * this destination suspended for time_reopen() time.
+ **/
 static gboolean
 afredis_worker_insert(AFREDISDriver *self)
 {
-  gboolean success;
-  LogMessage *msg;
-  LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
-  redis_session_t session;
-  redis_message_t message;
-  gpointer args[] = { self, NULL, NULL };
-
-  success = log_queue_pop_head(self->queue, &msg, &path_options, FALSE, FALSE);
-  if (!success)
-    return TRUE;
-
-  msg_set_context(msg);
-
-  session = redis_create_session();
-  message = redis_add_message(session);
-
-  g_string_printf(self->str, "%s:%d", self->host, self->port);
-  redis_set_server(session, self->str->str);
-
-  redis_set_eventcb(session, (redis_eventcb_t)afredis_dd_cb_event, (void *)self);
-  redis_set_monitorcb(session, (redis_monitorcb_t)afredis_dd_cb_monitor,
-                     (void *)self, 1);
-
-  redis_set_reverse_path(message, self->mail_from->address);
-
-  /* Defaults */  
- /* redis_set_header(message, "To", NULL, NULL);
-  redis_set_header(message, "From", NULL, NULL);
-
-  log_template_format(self->subject_tmpl, msg, NULL, LTZ_SEND,
-                      self->seq_num, NULL, self->str);
-  redis_set_header(message, "Subject", afredis_wash_string(self->str->str));
-  redis_set_header_option(message, "Subject", Hdr_OVERRIDE, 1);
-
-  /* Add recipients */  
-/*  g_list_foreach(self->rcpt_tos, (GFunc)afredis_dd_msg_add_recipient, message);
-
-  /* Add custom header (overrides anything set before, or in the
-     body). */ 
- /* args[1] = msg;
-  args[2] = message;
-  g_list_foreach(self->headers, (GFunc)afredis_dd_msg_add_header, args);
+  redisReply *reply;
+  gint pending, rejected = 0, i;
 
-  /* Set the body.
-   *
-   * We add a header to the body, otherwise libesmtp will not
-   * recognise headers, and will append them to the end of the body.
-   */ 
-/*  g_string_assign(self->str, "X-Mailer: syslog-ng " VERSION "\r\n\r\n");
-  log_template_append_format(self->body_tmpl, msg, NULL, LTZ_SEND,
-                             self->seq_num, NULL, self->str);
-  redis_set_message_str(message, self->str->str);
+  if (!afredis_dd_connect(self, TRUE))
+    return FALSE;
 
-  if (!redis_start_session(session))
+  pending = log_queue_pop_batch(self->queue, self->batch, self->batch_options, self->flush_lines, TRUE, FALSE);
+  for (i = 0; i < pending; i++)
     {
-      gchar error[1024];
-      redis_strerror(redis_errno(), error, sizeof (error) - 1);
-
-      msg_error("REDIS server error, suspending",
-                evt_tag_str("error", error),
-                evt_tag_int("time_reopen", self->time_reopen),
-                NULL);
-      success = FALSE;
-    }
-  else
-    {
-      const redis_status_t *status = redis_message_transfer_status(message);
-      msg_debug("REDIS result",
-                evt_tag_int("code", status->code),
-                evt_tag_str("text", status->text),
-                NULL);
-      redis_enumerate_recipients(message, afredis_dd_log_rcpt_status, NULL);
-    }
-  redis_destroy_session(session);
-
-  msg_set_context(NULL);
+      msg_set_context(self->batch[i]);
+      afredis_worker_append_command(self, self->batch[i]);
+      msg_set_context(NULL);
 
-  if (success)
-    {
-      stats_counter_inc(self->stored_messages);
+      log_msg_unref(self->batch[i]);
       step_sequence_number(&self->seq_num);
-      log_msg_ack(msg, &path_options);
-      log_msg_unref(msg);
     }
-  else
+
+  for (i = 0; i < pending; i++)
     {
-      log_queue_push_head(self->queue, msg, &path_options);
+      if (redisGetReply(self->c, (void **) &reply) != REDIS_OK)
+        {
+          msg_error("Error sending commands to REDIS server, rewinding backlog",
+                    evt_tag_str("host", self->host),
+                    evt_tag_int("port", self->port),
+                    evt_tag_str("error", self->c->errstr),
+                    evt_tag_int("time_reopen", self->time_reopen),
+                    NULL);
+          log_queue_rewind_backlog(self->queue);
+          return FALSE;
+        }
+
+      if (reply->type == REDIS_REPLY_ERROR)
+        {
+          /* the server rejected the command, retrying it would not help */
+          msg_error("REDIS server rejected command, message dropped",
+                    evt_tag_str("error", reply->str),
+                    NULL);
+          rejected++;
+        }
+      freeReplyObject(reply);
     }
 
-  return success;
+  stats_counter_add(self->dropped_messages, rejected);
+  log_queue_ack_backlog(self->queue, pending);
+
+  return TRUE;
 }
 
 static void
@@ -445,14 +282,21 @@ static gpointer
 afredis_worker_thread(gpointer arg)
 {
   AFREDISDriver *self = (AFREDISDriver *)arg;
+  gint i;
 
   msg_debug("Worker thread started",
             evt_tag_str("driver", self->super.super.id),
             NULL);
 
-  self->str = g_string_sized_new(1024);
+  self->argv_str = g_new(GString *, self->argc);
+  for (i = 0; i < self->argc; i++)
+    self->argv_str[i] = g_string_sized_new(256);
+  self->argv = g_new(const gchar *, self->argc);
+  self->argvlen = g_new(size_t, self->argc);
+  self->batch = g_new(LogMessage *, self->flush_lines);
+  self->batch_options = g_new(LogPathOptions, self->flush_lines);
 
-  ignore_sigpipe();
+  afredis_dd_connect(self, FALSE);
 
   while (!self->writer_thread_terminate)
     {
@@ -478,13 +322,22 @@ afredis_worker_thread(gpointer arg)
       if (self->writer_thread_terminate)
         break;
 
-      if (!afredis_worker_insert (self))
+      if (!afredis_worker_insert(self))
         {
+          afredis_dd_disconnect(self);
           afredis_dd_suspend(self);
         }
     }
 
-  g_string_free(self->str, TRUE);
+  afredis_dd_disconnect(self);
+
+  for (i = 0; i < self->argc; i++)
+    g_string_free(self->argv_str[i], TRUE);
+  g_free(self->argv_str);
+  g_free(self->argv);
+  g_free(self->argvlen);
+  g_free(self->batch);
+  g_free(self->batch_options);
 
   msg_debug("Worker thread finished",
             evt_tag_str("driver", self->super.super.id),
@@ -492,11 +345,11 @@ afredis_worker_thread(gpointer arg)
 
   return NULL;
 }
-*/
+
 /*
  * Main thread
  */
-/*
+
 static void
 afredis_dd_start_thread(AFREDISDriver *self)
 {
@@ -513,43 +366,68 @@ afredis_dd_stop_thread(AFREDISDriver *self)
   g_thread_join(self->writer_thread);
 }
 
-static void
-afredis_dd_init_header(AFREDISHeader *hdr, GlobalConfig *cfg)
+static gboolean
+afredis_dd_compile_command(AFREDISDriver *self, GlobalConfig *cfg)
 {
-  if (!hdr->value)
+  GError *error = NULL;
+  GList *l;
+  gint i;
+
+  if (self->argv_tmpl)
+    return TRUE;
+
+  self->argc = g_list_length(self->command);
+  self->argv_tmpl = g_new0(LogTemplate *, self->argc);
+  for (i = 0, l = self->command; l; i++, l = l->next)
     {
-      hdr->value = log_template_new(cfg, hdr->name);
-      log_template_compile(hdr->value, hdr->template, NULL);
+      self->argv_tmpl[i] = log_template_new(cfg, NULL);
+      if (!log_template_compile(self->argv_tmpl[i], (gchar *) l->data, &error))
+        {
+          msg_error("Error compiling REDIS command template",
+                    evt_tag_str("template", (gchar *) l->data),
+                    evt_tag_str("error", error->message),
+                    NULL);
+          g_clear_error(&error);
+          return FALSE;
+        }
     }
+  return TRUE;
 }
-*/
+
 static gboolean
 afredis_dd_init(LogPipe *s)
 {
   AFREDISDriver *self = (AFREDISDriver *)s;
   GlobalConfig *cfg = log_pipe_get_config(s);
 
+  if (!log_dest_driver_init_method(s))
+    return FALSE;
+
   if (cfg)
-    self->time_reopen = cfg->time_reopen;
+    {
+      self->time_reopen = cfg->time_reopen;
+      if (self->flush_lines == -1)
+        self->flush_lines = cfg->flush_lines;
+    }
+  if (self->flush_lines < 1)
+    self->flush_lines = AFREDIS_DEFAULT_PIPELINE_DEPTH;
+
+  if (!self->command)
+    afredis_dd_set_command((LogDriver *)self,
+                           g_list_append(g_list_append(g_list_append(NULL, g_strdup("LPUSH")),
+                                                       g_strdup("syslog")),
+                                         g_strdup("${ISODATE} ${HOST} ${MSGHDR}${MSG}")));
+  if (!afredis_dd_compile_command(self, cfg))
+    return FALSE;
+
+  log_template_options_init(&self->template_options, cfg);
 
   msg_verbose("Initializing REDIS destination",
               evt_tag_str("host", self->host),
               evt_tag_int("port", self->port),
               NULL);
-/*
-  self->queue = log_dest_driver_acquire_queue(&self->super, afredis_dd_format_stats_instance(self));
 
-  g_list_foreach(self->headers, (GFunc)afredis_dd_init_header, cfg);
-  if (!self->subject_tmpl)
-    {
-      self->subject_tmpl = log_template_new(cfg, "subject");
-      log_template_compile(self->subject_tmpl, self->subject, NULL);
-    }
-  if (!self->body_tmpl)
-    {
-      self->body_tmpl = log_template_new(cfg, "body");
-      log_template_compile(self->body_tmpl, self->body, NULL);
-    }
+  self->queue = log_dest_driver_acquire_queue(&self->super, afredis_dd_format_persist_name(self));
 
   stats_lock();
   stats_register_counter(0, SCS_REDIS | SCS_DESTINATION, self->super.super.id,
@@ -560,8 +438,9 @@ afredis_dd_init(LogPipe *s)
                          SC_TYPE_DROPPED, &self->dropped_messages);
   stats_unlock();
 
+  log_queue_set_counters(self->queue, self->stored_messages, self->dropped_messages);
   afredis_dd_start_thread(self);
-*/
+
   return TRUE;
 }
 
@@ -569,10 +448,11 @@ static gboolean
 afredis_dd_deinit(LogPipe *s)
 {
   AFREDISDriver *self = (AFREDISDriver *)s;
-/*
+
   afredis_dd_stop_thread(self);
   log_queue_reset_parallel_push(self->queue);
 
+  log_queue_set_counters(self->queue, NULL, NULL);
   stats_lock();
   stats_unregister_counter(SCS_REDIS | SCS_DESTINATION, self->super.super.id,
                            afredis_dd_format_stats_instance(self),
@@ -581,7 +461,9 @@ afredis_dd_deinit(LogPipe *s)
                            afredis_dd_format_stats_instance(self),
                            SC_TYPE_DROPPED, &self->dropped_messages);
   stats_unlock();
-*/
+  if (!log_dest_driver_deinit_method(s))
+    return FALSE;
+
   return TRUE;
 }
 
@@ -589,58 +471,31 @@ static void
 afredis_dd_free(LogPipe *d)
 {
   AFREDISDriver *self = (AFREDISDriver *)d;
-  GList *l;
-/*
+  gint i;
+
   g_mutex_free(self->suspend_mutex);
   g_cond_free(self->writer_thread_wakeup_cond);
 
   if (self->queue)
     log_queue_unref(self->queue);
-*/
-  g_free(self->host);
-  g_free(self->mail_from->phrase);
-  g_free(self->mail_from->address);
-  g_free(self->mail_from);
-  log_template_unref(self->subject_tmpl);
-  log_template_unref(self->body_tmpl);
-  g_free(self->body);
-  g_free(self->subject);
-  g_string_free(self->str, TRUE);
-
-  l = self->rcpt_tos;
-  while (l)
-    {
-      AFREDISRecipient *rcpt = (AFREDISRecipient *)l->data;
-      g_free(rcpt->address);
-      g_free(rcpt->phrase);
-      g_free(rcpt);
-      l = g_list_delete_link(l, l);
-    }
 
-  l = self->headers;
-  while (l)
-    {
-      AFREDISHeader *hdr = (AFREDISHeader *)l->data;
-      g_free(hdr->name);
-      g_free(hdr->template);
-      log_template_unref(hdr->value);
-      g_free(hdr);
-      l = g_list_delete_link(l, l);
-    }
+  log_template_options_destroy(&self->template_options);
+  for (i = 0; i < self->argc; i++)
+    log_template_unref(self->argv_tmpl[i]);
+  g_free(self->argv_tmpl);
+  string_list_free(self->command);
+  g_free(self->host);
 
   log_dest_driver_free(d);
 }
 
 static void
 afredis_dd_queue(LogPipe *s, LogMessage *msg,
-                const LogPathOptions *path_options, gpointer user_data)
+                 const LogPathOptions *path_options, gpointer user_data)
 {
   AFREDISDriver *self = (AFREDISDriver *)s;
-  redisReply *reply;
-  redisContext *c;
-  
   LogPathOptions local_options;
-/*
+
   if (!path_options->flow_control_requested)
     path_options = log_msg_break_ack(msg, path_options, &local_options);
 
@@ -648,20 +503,6 @@ afredis_dd_queue(LogPipe *s, LogMessage *msg,
   log_queue_push_tail(self->queue, log_msg_ref(msg), path_options);
 
   log_dest_driver_queue_method(s, msg, path_options, user_data);
-  */
-
-  
-  
-  c = redisConnect("127.0.0.1", 6379);
-    if (c->err)
-    {
-        printf("Connection error: %s\n", c->errstr);
-        exit(1);
-    }
-    reply = redisCommand(c,"PING");
-    printf("PING: %s\n", reply->str);
-   reply = redisCommand(c,"SET %s %s", "message", msg);
-    freeReplyObject(reply);
 }
 
 /*
@@ -674,24 +515,24 @@ afredis_dd_new(void)
   AFREDISDriver *self = g_new0(AFREDISDriver, 1);
 
   log_dest_driver_init_instance(&self->super);
-  //self->super.super.super.init = afredis_dd_init;
-  //self->super.super.super.deinit = afredis_dd_deinit;
-  //self->super.super.super.queue = afredis_dd_queue;
-  //self->super.super.super.free_fn = afredis_dd_free;
+  self->super.super.super.init = afredis_dd_init;
+  self->super.super.super.deinit = afredis_dd_deinit;
+  self->super.super.super.queue = afredis_dd_queue;
+  self->super.super.super.free_fn = afredis_dd_free;
 
   afredis_dd_set_host((LogDriver *)self, "127.0.0.1");
   afredis_dd_set_port((LogDriver *)self, 6379);
+  afredis_dd_set_flush_lines((LogDriver *)self, -1);
 
-  self->mail_from = g_new0(AFREDISRecipient, 1);
-
-  //init_sequence_number(&self->seq_num);
+  log_template_options_defaults(&self->template_options);
+  init_sequence_number(&self->seq_num);
 
-  //self->writer_thread_wakeup_cond = g_cond_new();
-  //self->suspend_mutex = g_mutex_new();
+  self->writer_thread_wakeup_cond = g_cond_new();
+  self->suspend_mutex = g_mutex_new();
 
   return (LogDriver *)self;
 }
- 
+
 extern CfgParser afredis_dd_parser;
 
 static Plugin afredis_plugin =
@@ -704,20 +545,7 @@ static Plugin afredis_plugin =
 gboolean
 afredis_module_init(GlobalConfig *cfg, CfgArgs *args)
 {
-  redisReply *reply;
-  redisContext *c;
-  plugin_register(cfg, &afredis_plugin, 1); 
-  c = redisConnect("127.0.0.1", 6379);
-    if (c->err)
-    {
-        printf("Connection error: %s\n", c->errstr);
-        exit(1);
-    }
-    reply = redisCommand(c,"PING");
-    printf("PING: %s\n", reply->str);
-    
-   reply = redisCommand(c,"SET %s %s", "testkey", "testmessage");
-    freeReplyObject(reply);
+  plugin_register(cfg, &afredis_plugin, 1);
   return TRUE;
 }
 
@@ -283,7 +283,7 @@ afsocket_dd_start_connect(AFSocketDestDriver *self)
   gchar buf1[MAX_SOCKADDR_STRING], buf2[MAX_SOCKADDR_STRING];
 
   main_loop_assert_main_thread();
-  if (!afsocket_open_socket(self->bind_addr, self->sock_type, self->sock_protocol, &sock))
+  if (!afsocket_open_socket(self->bind_addr, self->sock_type, self->sock_protocol, NULL, &sock))
     {
       return FALSE;
     }
@@ -74,6 +74,7 @@ static CfgLexerKeyword afsocket_keywords[] = {
   { "transport",          KW_TRANSPORT },
   { "ip_protocol",        KW_IP_PROTOCOL },
   { "max_connections",    KW_MAX_CONNECTIONS },
+  { "so_reuseport",       KW_SO_REUSEPORT, 0x0304 },
   { "keep_alive",         KW_KEEP_ALIVE },
   { NULL }
 };
@@ -52,6 +52,12 @@ typedef struct _AFSocketSourceConnection
   GSockAddr *peer_addr;
 } AFSocketSourceConnection;
 
+typedef struct _AFSocketListener
+{
+  struct iv_fd listen_fd;
+  AFSocketSourceDriver *owner;
+} AFSocketListener;
+
 static void afsocket_sd_close_connection(AFSocketSourceDriver *self, AFSocketSourceConnection *sc);
 
 static gint
@@ -135,7 +141,12 @@ afsocket_sc_init(LogPipe *s)
       else
 #endif
       if (self->owner->sock_type == SOCK_DGRAM)
-        transport = log_transport_dgram_socket_new(self->sock);
+        {
+          /* receive up to fetch_limit datagrams with a single syscall */
+          transport = log_transport_dgram_socket_batched_new(self->sock,
+                                                             self->owner->reader_options.fetch_limit,
+                                                             self->owner->reader_options.proto_options.super.init_buffer_size);
+        }
       else
         transport = log_transport_stream_socket_new(self->sock);
 
@@ -301,6 +312,15 @@ afsocket_sd_set_max_connections(LogDriver *s, gint max_connections)
   self->max_connections = max_connections;
 }
 
+void
+afsocket_sd_set_so_reuseport(LogDriver *s, gint num_listeners)
+{
+  AFSocketSourceDriver *self = (AFSocketSourceDriver *) s;
+
+  self->num_listeners = MAX(num_listeners, 1);
+  self->reuseport = TRUE;
+}
+
 #if BUILD_WITH_SSL
 void
 afsocket_sd_set_tls_context(LogDriver *s, TLSContext *tls_context)
@@ -324,6 +344,23 @@ afsocket_sd_format_persist_name(AFSocketSourceDriver *self, gboolean listener_na
   return persist_name;
 }
 
+static inline gchar *
+afsocket_sd_format_listener_persist_name(AFSocketSourceDriver *self, gint index)
+{
+  static gchar persist_name[128];
+  gchar buf[64];
+
+  /* the first listener keeps the name used before so-reuseport() was introduced */
+  if (index == 0)
+    return afsocket_sd_format_persist_name(self, TRUE);
+
+  g_snprintf(persist_name, sizeof(persist_name), "afsocket_sd_listen_fd(%s,%s,%d)",
+             (self->sock_type == SOCK_STREAM) ? "stream" : "dgram",
+             g_sockaddr_format(self->bind_addr, buf, sizeof(buf), GSA_FULL),
+             index);
+  return persist_name;
+}
+
 gboolean
 afsocket_sd_process_connection(AFSocketSourceDriver *self, GSockAddr *client_addr, GSockAddr *local_addr, gint fd)
 {
@@ -352,7 +389,8 @@ afsocket_sd_process_connection(AFSocketSourceDriver *self, GSockAddr *client_add
 
 #endif
 
-  if (self->num_connections >= self->max_connections)
+  /* NOTE: SOCK_DGRAM sources have one connection for each listening socket */
+  if (self->sock_type == SOCK_STREAM && self->num_connections >= self->max_connections)
     {
       msg_error("Number of allowed concurrent connections reached, rejecting connection",
                 evt_tag_str("client", g_sockaddr_format(client_addr, buf, sizeof(buf), GSA_FULL)),
@@ -386,7 +424,8 @@ afsocket_sd_process_connection(AFSocketSourceDriver *self, GSockAddr *client_add
 static void
 afsocket_sd_accept(gpointer s)
 {
-  AFSocketSourceDriver *self = (AFSocketSourceDriver *) s;
+  AFSocketListener *listener = (AFSocketListener *) s;
+  AFSocketSourceDriver *self = listener->owner;
   GSockAddr *peer_addr;
   gchar buf1[256], buf2[256];
   gint new_fd;
@@ -397,7 +436,7 @@ afsocket_sd_accept(gpointer s)
     {
       GIOStatus status;
 
-      status = g_accept(self->fd, &new_fd, &peer_addr);
+      status = g_accept(listener->listen_fd.fd, &new_fd, &peer_addr);
       if (status == G_IO_STATUS_AGAIN)
         {
           /* no more connections to accept */
@@ -473,18 +512,103 @@ afsocket_sd_close_connection(AFSocketSourceDriver *self, AFSocketSourceConnectio
 static void
 afsocket_sd_start_watches(AFSocketSourceDriver *self)
 {
-  IV_FD_INIT(&self->listen_fd);
-  self->listen_fd.fd = self->fd;
-  self->listen_fd.cookie = self;
-  self->listen_fd.handler_in = afsocket_sd_accept;
-  iv_fd_register(&self->listen_fd);
+  gint i;
+
+  for (i = 0; i < self->num_listeners; i++)
+    iv_fd_register(&self->listeners[i].listen_fd);
 }
 
 static void
 afsocket_sd_stop_watches(AFSocketSourceDriver *self)
 {
-  if (iv_fd_registered (&self->listen_fd))
-    iv_fd_unregister(&self->listen_fd);
+  gint i;
+
+  for (i = 0; i < self->num_listeners; i++)
+    {
+      if (iv_fd_registered(&self->listeners[i].listen_fd))
+        iv_fd_unregister(&self->listeners[i].listen_fd);
+    }
+}
+
+static void
+afsocket_sd_close_listeners(AFSocketSourceDriver *self, gint count)
+{
+  gint i;
+
+  for (i = 0; i < count; i++)
+    close(self->listeners[i].listen_fd.fd);
+  g_free(self->listeners);
+  self->listeners = NULL;
+}
+
+/*
+ * Opens the listening socket at @index. SO_REUSEPORT is requested whenever
+ * so-reuseport() is configured (even with a single socket), so that a
+ * later reload can add listeners next to this one.  If the kernel refuses
+ * it, we fall back to the sockets opened so far, which is a single one
+ * unless the option stopped working halfway.
+ */
+static gboolean
+afsocket_sd_open_socket(AFSocketSourceDriver *self, gint index, gint *sock)
+{
+  gboolean reuseport = self->reuseport;
+
+  if (!afsocket_open_socket(self->bind_addr, self->sock_type, self->sock_protocol, &reuseport, sock))
+    return FALSE;
+
+  if (self->reuseport && !reuseport)
+    {
+      self->reuseport = FALSE;
+      self->num_listeners = MIN(self->num_listeners, index + 1);
+    }
+  return TRUE;
+}
+
+/*
+ * Sockets inherited from a configuration that did not set SO_REUSEPORT
+ * would prevent us from binding the rest of the listeners, so they are
+ * closed and reopened.
+ */
+static gboolean
+afsocket_sd_can_reuse_socket(AFSocketSourceDriver *self, gint sock)
+{
+  if (!self->reuseport || afsocket_socket_has_reuseport(sock))
+    return TRUE;
+
+  msg_verbose("Reopening listener fd to enable so-reuseport()",
+              evt_tag_int("fd", sock),
+              NULL);
+  return FALSE;
+}
+
+/*
+ * Drops the SOCK_DGRAM sockets kept alive from the previous configuration
+ * that we don't need: surplus ones when the number of listeners was
+ * decreased and ones that cannot share the address with the others.
+ */
+static void
+afsocket_sd_drop_stale_dgram_listeners(AFSocketSourceDriver *self)
+{
+  GList *l, *next;
+  gint kept = 0;
+
+  for (l = self->connections; l; l = next)
+    {
+      AFSocketSourceConnection *connection = (AFSocketSourceConnection *) l->data;
+
+      next = l->next;
+      if (kept < self->num_listeners && afsocket_sd_can_reuse_socket(self, connection->sock))
+        {
+          kept++;
+          continue;
+        }
+
+      msg_verbose("Closing surplus listener fd",
+                  evt_tag_int("fd", connection->sock),
+                  NULL);
+      self->connections = g_list_delete_link(self->connections, l);
+      afsocket_sd_kill_connection(connection);
+    }
 }
 
 gboolean
@@ -534,12 +658,26 @@ afsocket_sd_init(LogPipe *s)
     }
   log_reader_options_init(&self->reader_options, cfg, self->super.super.group);
 
+#ifndef SO_REUSEPORT
+  if (self->reuseport)
+    {
+      if (self->num_listeners > 1)
+        msg_warning("WARNING: so-reuseport() is not supported on this platform, using a single socket",
+                    evt_tag_int("so_reuseport", self->num_listeners),
+                    NULL);
+      self->num_listeners = 1;
+      self->reuseport = FALSE;
+    }
+#endif
+
   /* fetch persistent connections first */
   if (self->connections_kept_alive_accross_reloads)
     {
       GList *p;
 
       self->connections = cfg_persist_config_fetch(cfg, afsocket_sd_format_persist_name(self, FALSE));
+      if (self->sock_type == SOCK_DGRAM)
+        afsocket_sd_drop_stale_dgram_listeners(self);
 
       self->num_connections = 0;
       for (p = self->connections; p; p = p->next)
@@ -551,51 +689,75 @@ afsocket_sd_init(LogPipe *s)
     }
 
   /* ok, we have connection list, check if we need to open a listener */
-  sock = -1;
   if (self->sock_type == SOCK_STREAM)
     {
-      if (self->connections_kept_alive_accross_reloads)
-        {
-          /* NOTE: this assumes that fd 0 will never be used for listening fds,
-           * main.c opens fd 0 so this assumption can hold */
-          sock = GPOINTER_TO_UINT(cfg_persist_config_fetch(cfg, afsocket_sd_format_persist_name(self, TRUE))) - 1;
-        }
+      gint i;
 
-      if (sock == -1)
+      self->listeners = g_new0(AFSocketListener, self->num_listeners);
+      for (i = 0; i < self->num_listeners; i++)
         {
-          if (!afsocket_sd_acquire_socket(self, &sock))
-            return self->super.super.optional;
-          if (sock == -1 && !afsocket_open_socket(self->bind_addr, self->sock_type, self->sock_protocol, &sock))
-            return self->super.super.optional;
-        }
+          sock = -1;
+          if (self->connections_kept_alive_accross_reloads)
+            {
+              /* NOTE: this assumes that fd 0 will never be used for listening fds,
+               * main.c opens fd 0 so this assumption can hold */
+              sock = GPOINTER_TO_UINT(cfg_persist_config_fetch(cfg, afsocket_sd_format_listener_persist_name(self, i))) - 1;
+              if (sock != -1 && !afsocket_sd_can_reuse_socket(self, sock))
+                {
+                  close(sock);
+                  sock = -1;
+                }
+            }
 
-      /* set up listening source */
-      if (listen(sock, self->listen_backlog) < 0)
-        {
-          msg_error("Error during listen()",
-                    evt_tag_errno(EVT_TAG_OSERROR, errno),
-                    NULL);
-          close(sock);
-          return FALSE;
-        }
+          if (sock == -1)
+            {
+              if (!afsocket_sd_acquire_socket(self, &sock) ||
+                  (sock == -1 && !afsocket_sd_open_socket(self, i, &sock)))
+                {
+                  afsocket_sd_close_listeners(self, i);
+                  return self->super.super.optional;
+                }
+            }
 
-      if (self->setup_socket && !self->setup_socket(self, sock))
-        {
-          close(sock);
-          return FALSE;
+          /* set up listening source */
+          if (listen(sock, self->listen_backlog) < 0)
+            {
+              msg_error("Error during listen()",
+                        evt_tag_errno(EVT_TAG_OSERROR, errno),
+                        NULL);
+              close(sock);
+              afsocket_sd_close_listeners(self, i);
+              return FALSE;
+            }
+
+          if (self->setup_socket && !self->setup_socket(self, sock))
+            {
+              close(sock);
+              afsocket_sd_close_listeners(self, i);
+              return FALSE;
+            }
+
+          IV_FD_INIT(&self->listeners[i].listen_fd);
+          self->listeners[i].listen_fd.fd = sock;
+          self->listeners[i].listen_fd.cookie = &self->listeners[i];
+          self->listeners[i].listen_fd.handler_in = afsocket_sd_accept;
+          self->listeners[i].owner = self;
         }
 
-      self->fd = sock;
       afsocket_sd_start_watches(self);
       res = TRUE;
     }
   else
     {
-      if (!self->connections)
+      /* we either have the connections kept alive from the previous
+       * configuration, or open a socket (and a LogReader) for each
+       * listener that is missing */
+      res = TRUE;
+      while (res && g_list_length(self->connections) < self->num_listeners)
         {
           if (!afsocket_sd_acquire_socket(self, &sock))
             return self->super.super.optional;
-          if (sock == -1 && !afsocket_open_socket(self->bind_addr, self->sock_type, self->sock_protocol, &sock))
+          if (sock == -1 && !afsocket_sd_open_socket(self, g_list_length(self->connections), &sock))
             return self->super.super.optional;
 
           if (!self->setup_socket(self, sock))
@@ -603,12 +765,9 @@ afsocket_sd_init(LogPipe *s)
               close(sock);
               return FALSE;
             }
-        }
-      self->fd = -1;
 
-      /* we either have self->connections != NULL, or sock contains a new fd */
-      if (self->connections || afsocket_sd_process_connection(self, NULL, self->bind_addr, sock))
-        res = TRUE;
+          res = afsocket_sd_process_connection(self, NULL, self->bind_addr, sock);
+        }
     }
   return res;
 }
@@ -647,26 +806,35 @@ afsocket_sd_deinit(LogPipe *s)
 
   if (self->sock_type == SOCK_STREAM)
     {
+      gint i;
+
       afsocket_sd_stop_watches(self);
-      if (!self->connections_kept_alive_accross_reloads)
-        {
-          msg_verbose("Closing listener fd",
-                      evt_tag_int("fd", self->fd),
-                      NULL);
-          close(self->fd);
-        }
-      else
+      for (i = 0; i < self->num_listeners; i++)
         {
-          /* NOTE: the fd is incremented by one when added to persistent config
-           * as persist config cannot store NULL */
+          gint fd = self->listeners[i].listen_fd.fd;
 
-          cfg_persist_config_add(cfg, afsocket_sd_format_persist_name(self, TRUE), GUINT_TO_POINTER(self->fd + 1), afsocket_sd_close_fd, FALSE);
+          if (!self->connections_kept_alive_accross_reloads)
+            {
+              msg_verbose("Closing listener fd",
+                          evt_tag_int("fd", fd),
+                          NULL);
+              close(fd);
+            }
+          else
+            {
+              /* NOTE: the fd is incremented by one when added to persistent config
+               * as persist config cannot store NULL */
+
+              cfg_persist_config_add(cfg, afsocket_sd_format_listener_persist_name(self, i), GUINT_TO_POINTER(fd + 1), afsocket_sd_close_fd, FALSE);
+            }
         }
+      g_free(self->listeners);
+      self->listeners = NULL;
     }
   else if (self->sock_type == SOCK_DGRAM)
     {
-      /* we don't need to close the listening fd here as we have a
-       * single connection which will close it */
+      /* we don't need to close the listening fds here as each of them
+       * is owned by a connection which will close it */
 
       ;
     }
@@ -730,6 +898,7 @@ afsocket_sd_init_instance(AFSocketSourceDriver *self, SocketOptions *sock_option
   self->setup_socket = afsocket_sd_setup_socket;
   self->address_family = family;
   self->max_connections = 10;
+  self->num_listeners = 1;
   self->listen_backlog = 255;
   self->sock_type = sock_type;
   self->connections_kept_alive_accross_reloads = TRUE;
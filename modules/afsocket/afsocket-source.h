@@ -44,9 +44,13 @@ struct _AFSocketSourceDriver
     syslog_protocol:1,
     connections_kept_alive_accross_reloads:1,
     require_tls:1,
-    window_size_initialized:1;
-  struct iv_fd listen_fd;
-  gint fd;
+    window_size_initialized:1,
+    reuseport:1;
+  /* listening sockets of SOCK_STREAM sources, one for each of num_listeners */
+  struct _AFSocketListener *listeners;
+  /* number of sockets opened with SO_REUSEPORT, one LogReader is
+   * created for each in case of SOCK_DGRAM */
+  gint num_listeners;
   /* SOCK_DGRAM or SOCK_STREAM or other SOCK_XXX values used by the socket() call */
   gint sock_type;
   /* protocol parameter for the socket() call, 0 for default or IPPROTO_XXX for specific transports */
@@ -91,6 +95,7 @@ struct _AFSocketSourceDriver
 void afsocket_sd_set_transport(LogDriver *s, const gchar *transport);
 void afsocket_sd_set_keep_alive(LogDriver *self, gint enable);
 void afsocket_sd_set_max_connections(LogDriver *self, gint max_connections);
+void afsocket_sd_set_so_reuseport(LogDriver *self, gint num_listeners);
 #if BUILD_WITH_SSL
 void afsocket_sd_set_tls_context(LogDriver *s, TLSContext *tls_context);
 #else
@@ -80,8 +80,33 @@ afsocket_setup_socket(gint fd, SocketOptions *sock_options, AFSocketDirection di
   return TRUE;
 }
 
+/*
+ * Returns whether SO_REUSEPORT is set on @fd, used to check whether a
+ * socket inherited from the previous configuration can share its
+ * address with the newly opened ones.
+ */
 gboolean
-afsocket_open_socket(GSockAddr *bind_addr, gint sock_type, gint sock_protocol, int *fd)
+afsocket_socket_has_reuseport(gint fd)
+{
+#ifdef SO_REUSEPORT
+  gint on = 0;
+  socklen_t sz = sizeof(on);
+
+  if (getsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, &sz) < 0)
+    return FALSE;
+  return on != 0;
+#else
+  return FALSE;
+#endif
+}
+
+/*
+ * @reuseport: if non-NULL and TRUE, SO_REUSEPORT is requested on the new
+ * socket; it is set to FALSE if the kernel refuses it, in which case the
+ * socket is still bound, but without the option.
+ */
+gboolean
+afsocket_open_socket(GSockAddr *bind_addr, gint sock_type, gint sock_protocol, gboolean *reuseport, int *fd)
 {
   gint sock;
 
@@ -93,6 +118,23 @@ afsocket_open_socket(GSockAddr *bind_addr, gint sock_type, gint sock_protocol, i
 
       g_fd_set_nonblock(sock, TRUE);
       g_fd_set_cloexec(sock, TRUE);
+      if (reuseport && *reuseport)
+        {
+#ifdef SO_REUSEPORT
+          gint on = 1;
+
+          /* lets the kernel distribute the load between the sockets bound to the same address */
+          if (setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) < 0)
+            {
+              msg_warning("WARNING: the kernel refused to set SO_REUSEPORT on the socket, using a single socket",
+                          evt_tag_errno(EVT_TAG_OSERROR, errno),
+                          NULL);
+              *reuseport = FALSE;
+            }
+#else
+          *reuseport = FALSE;
+#endif
+        }
       saved_caps = g_process_cap_save();
       g_process_cap_modify(CAP_NET_BIND_SERVICE, TRUE);
       g_process_cap_modify(CAP_DAC_OVERRIDE, TRUE);
@@ -51,6 +51,7 @@ enum
 {
   AFSQL_DDF_EXPLICIT_COMMITS = 0x0001,
   AFSQL_DDF_DONT_CREATE_TABLES = 0x0002,
+  AFSQL_DDF_BATCH_INSERTS = 0x0004,
 };
 
 typedef struct _AFSqlField
@@ -119,6 +120,14 @@ typedef struct _AFSqlDestDriver
   dbi_conn dbi_ctx;
   GHashTable *validated_tables;
   guint32 failed_message_counter;
+  /* multi-row INSERT being assembled in batch-inserts mode, the number
+   * of rows it contains is tracked in flush_lines_queued */
+  GString *batch_query;
+  GString *batch_table;
+  GTimeVal batch_flush_target;
+  /* messages popped from the queue in one go in batch-inserts mode */
+  LogMessage **batch;
+  LogPathOptions *batch_options;
 } AFSqlDestDriver;
 
 static gboolean dbi_initialized = FALSE;
@@ -126,6 +135,7 @@ static const char *s_oracle = "oracle";
 static const char *s_freetds = "freetds";
 
 #define MAX_FAILED_ATTEMPTS 3
+#define DEFAULT_BATCH_LINES 100
 
 void
 afsql_dd_add_dbd_option(LogDriver *s, const gchar *name, const gchar *value)
@@ -607,6 +617,20 @@ afsql_dd_commit_txn(AFSqlDestDriver *self)
   return success;
 }
 
+/**
+ * afsql_dd_rollback_txn:
+ *
+ * Roll back the current SQL transaction, so that the connection can be
+ * used again after a failed statement.
+ *
+ * NOTE: This function can only be called from the database thread.
+ **/
+static gboolean
+afsql_dd_rollback_txn(AFSqlDestDriver *self)
+{
+  return afsql_dd_run_query(self, "ROLLBACK", FALSE, NULL);
+}
+
 /**
  * afsql_dd_suspend:
  * timeout: in milliseconds
@@ -751,26 +775,28 @@ afsql_dd_insert_fail_handler(AFSqlDestDriver *self, LogMessage *msg,
   return TRUE;
 }
 
-static GString *
-afsql_dd_construct_query(AFSqlDestDriver *self, GString *table,
-                         LogMessage *msg)
+static void
+afsql_dd_append_query_header(AFSqlDestDriver *self, GString *query_string, GString *table)
 {
-  GString *value;
-  GString *query_string;
   gint i;
 
-  value = g_string_sized_new(256);
-  query_string = g_string_sized_new(512);
-
-  g_string_printf(query_string, "INSERT INTO %s (", table->str);
+  g_string_append_printf(query_string, "INSERT INTO %s (", table->str);
   for (i = 0; i < self->fields_len; i++)
     {
       g_string_append(query_string, self->fields[i].name);
       if (i != self->fields_len - 1)
         g_string_append(query_string, ", ");
     }
-  g_string_append(query_string, ") VALUES (");
+  g_string_append(query_string, ") VALUES ");
+}
 
+static void
+afsql_dd_append_query_values(AFSqlDestDriver *self, GString *query_string, GString *value,
+                             LogMessage *msg)
+{
+  gint i;
+
+  g_string_append_c(query_string, '(');
   for (i = 0; i < self->fields_len; i++)
     {
       gchar *quoted;
@@ -806,13 +832,196 @@ afsql_dd_construct_query(AFSqlDestDriver *self, GString *table,
       if (i != self->fields_len - 1)
         g_string_append(query_string, ", ");
     }
-  g_string_append(query_string, ")");
+  g_string_append_c(query_string, ')');
+}
+
+static GString *
+afsql_dd_construct_query(AFSqlDestDriver *self, GString *table,
+                         LogMessage *msg)
+{
+  GString *value;
+  GString *query_string;
+
+  value = g_string_sized_new(256);
+  query_string = g_string_sized_new(512);
+
+  afsql_dd_append_query_header(self, query_string, table);
+  afsql_dd_append_query_values(self, query_string, value, msg);
 
   g_string_free(value, TRUE);
 
   return query_string;
 }
 
+/**
+ * afsql_dd_flush_batch:
+ *
+ * Send the multi-row INSERT statement assembled so far to the database
+ * and acknowledge the messages it contains.
+ *
+ * This function is running in the database thread
+ *
+ * Returns: FALSE to indicate that the connection should be closed and
+ * this destination suspended for time_reopen() time.
+ **/
+static gboolean
+afsql_dd_flush_batch(AFSqlDestDriver *self)
+{
+  gint batch_len = self->flush_lines_queued;
+  gboolean success, connection_ok;
+
+  if (batch_len <= 0)
+    return TRUE;
+
+  success = (self->flags & AFSQL_DDF_EXPLICIT_COMMITS) == 0 || afsql_dd_begin_txn(self);
+  if (success)
+    success = afsql_dd_run_query(self, self->batch_query->str, FALSE, NULL);
+
+  g_string_truncate(self->batch_query, 0);
+  g_string_truncate(self->batch_table, 0);
+
+  if (success)
+    {
+      if (self->flags & AFSQL_DDF_EXPLICIT_COMMITS)
+        {
+          if (!afsql_dd_commit_txn(self))
+            return FALSE;
+        }
+      else
+        {
+          log_queue_ack_backlog(self->queue, batch_len);
+          self->flush_lines_queued = 0;
+        }
+      self->failed_message_counter = 0;
+      return TRUE;
+    }
+
+  /* the failed statement aborts the transaction, later statements would
+   * be rejected until it is rolled back. If even that fails, the
+   * connection is closed by returning FALSE. */
+  connection_ok = (self->flags & AFSQL_DDF_EXPLICIT_COMMITS) == 0 || afsql_dd_rollback_txn(self);
+
+  self->flush_lines_queued = 0;
+  if (self->failed_message_counter < self->num_retries - 1)
+    {
+      msg_notice("SQL batch insert failed, rewinding backlog and starting again",
+                 evt_tag_int("batch_lines", batch_len),
+                 NULL);
+      log_queue_rewind_backlog(self->queue);
+      self->failed_message_counter++;
+      return FALSE;
+    }
+
+  msg_error("Multiple failures while inserting this batch of records into the database, messages dropped",
+            evt_tag_int("attempts", self->num_retries),
+            evt_tag_int("batch_lines", batch_len),
+            NULL);
+  stats_counter_add(self->dropped_messages, batch_len);
+  log_queue_ack_backlog(self->queue, batch_len);
+  self->failed_message_counter = 0;
+  return connection_ok;
+}
+
+/*
+ * Appends @msg to the multi-row INSERT being assembled, sending it
+ * first if it targets a different table or after it is full. Returns
+ * FALSE if the connection should be closed.
+ */
+static gboolean
+afsql_dd_append_batch(AFSqlDestDriver *self, LogMessage *msg)
+{
+  GString *table, *value;
+
+  table = afsql_dd_validate_table(self, msg);
+  if (!table)
+    {
+      msg_error("Error checking table, disconnecting from database, trying again shortly",
+                evt_tag_int("time_reopen", self->time_reopen),
+                NULL);
+      g_string_truncate(self->batch_query, 0);
+      g_string_truncate(self->batch_table, 0);
+      self->flush_lines_queued = 0;
+      log_queue_rewind_backlog(self->queue);
+      return FALSE;
+    }
+
+  /* a single INSERT can only target one table: send the rows collected so
+   * far, the current message stays at the end of the backlog and starts
+   * a new batch */
+  if (self->flush_lines_queued > 0 && strcmp(self->batch_table->str, table->str) != 0 &&
+      !afsql_dd_flush_batch(self))
+    {
+      g_string_free(table, TRUE);
+      return FALSE;
+    }
+
+  if (self->flush_lines_queued == 0)
+    {
+      g_string_assign(self->batch_table, table->str);
+      afsql_dd_append_query_header(self, self->batch_query, table);
+      g_get_current_time(&self->batch_flush_target);
+      g_time_val_add(&self->batch_flush_target, self->flush_timeout * 1000);
+    }
+  else
+    {
+      g_string_append(self->batch_query, ", ");
+    }
+
+  value = g_string_sized_new(256);
+  afsql_dd_append_query_values(self, self->batch_query, value, msg);
+  g_string_free(value, TRUE);
+  g_string_free(table, TRUE);
+
+  step_sequence_number(&self->seq_num);
+  self->flush_lines_queued++;
+
+  if (self->flush_lines_queued >= self->flush_lines)
+    return afsql_dd_flush_batch(self);
+  return TRUE;
+}
+
+/**
+ * afsql_dd_insert_db_batch:
+ *
+ * Batch mode counterpart of afsql_dd_insert_db(): the messages popped
+ * from the queue in one go are appended to a multi-row INSERT
+ * statement, which is only sent to the database once flush_lines()
+ * rows are collected, the table name changes or the queue runs empty.
+ * Messages are kept in the backlog until the statement succeeds.
+ *
+ * This function is running in the database thread
+ *
+ * Returns: FALSE to indicate that the connection should be closed and
+ * this destination suspended for time_reopen() time.
+ **/
+static gboolean
+afsql_dd_insert_db_batch(AFSqlDestDriver *self)
+{
+  gboolean success = TRUE;
+  gint popped, i;
+
+  afsql_dd_connect(self);
+
+  popped = log_queue_pop_batch(self->queue, self->batch, self->batch_options,
+                               self->flush_lines - self->flush_lines_queued, TRUE, FALSE);
+  for (i = 0; i < popped; i++)
+    {
+      if (success)
+        {
+          msg_set_context(self->batch[i]);
+          success = afsql_dd_append_batch(self, self->batch[i]);
+          msg_set_context(NULL);
+        }
+      log_msg_unref(self->batch[i]);
+    }
+
+  /* no rows are pending after a failure, make sure that the messages
+   * not appended yet go back to the queue too */
+  if (!success)
+    log_queue_rewind_backlog(self->queue);
+  return success;
+}
+
 /**
  * afsql_dd_insert_db:
  *
@@ -829,6 +1038,9 @@ afsql_dd_insert_db(AFSqlDestDriver *self)
   gboolean success;
   LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
 
+  if (self->flags & AFSQL_DDF_BATCH_INSERTS)
+    return afsql_dd_insert_db_batch(self);
+
   afsql_dd_connect(self);
 
   success = log_queue_pop_head(self->queue, &msg, &path_options, (self->flags & AFSQL_DDF_EXPLICIT_COMMITS), FALSE);
@@ -881,6 +1093,32 @@ afsql_dd_insert_db(AFSqlDestDriver *self)
   return TRUE;
 }
 
+/**
+ * afsql_dd_flush_pending:
+ *
+ * Send out whatever is pending in the current transaction or batch.
+ *
+ * This function is running in the database thread
+ **/
+static gboolean
+afsql_dd_flush_pending(AFSqlDestDriver *self)
+{
+  if (self->flags & AFSQL_DDF_BATCH_INSERTS)
+    return afsql_dd_flush_batch(self);
+  return afsql_dd_commit_txn(self);
+}
+
+/* returns TRUE if the batch being assembled has waited flush_timeout() already */
+static gboolean
+afsql_dd_batch_timeout_expired(AFSqlDestDriver *self)
+{
+  GTimeVal now;
+
+  g_get_current_time(&now);
+  return now.tv_sec > self->batch_flush_target.tv_sec ||
+         (now.tv_sec == self->batch_flush_target.tv_sec && now.tv_usec >= self->batch_flush_target.tv_usec);
+}
+
 static void
 afsql_dd_message_became_available_in_the_queue(gpointer user_data)
 {
@@ -916,6 +1154,12 @@ afsql_dd_database_thread(gpointer arg)
   msg_verbose("Database thread started",
               evt_tag_str("driver", self->super.super.id),
               NULL);
+  if (self->flags & AFSQL_DDF_BATCH_INSERTS)
+    {
+      self->batch = g_new(LogMessage *, self->flush_lines);
+      self->batch_options = g_new(LogPathOptions, self->flush_lines);
+    }
+
   while (!self->db_thread_terminate)
     {
       g_mutex_lock(self->db_thread_mutex);
@@ -928,9 +1172,15 @@ afsql_dd_database_thread(gpointer arg)
         {
           /* we have nothing to INSERT into the database, let's wait we get some new stuff */
 
-          if (self->flush_lines_queued > 0)
+          if (self->flush_lines_queued > 0 && (self->flags & AFSQL_DDF_BATCH_INSERTS) &&
+              !self->db_thread_terminate && !afsql_dd_batch_timeout_expired(self))
+            {
+              /* give the batch a chance to fill up until flush_timeout() expires */
+              g_cond_timed_wait(self->db_thread_wakeup_cond, self->db_thread_mutex, &self->batch_flush_target);
+            }
+          else if (self->flush_lines_queued > 0)
             {
-              if (!afsql_dd_commit_txn(self))
+              if (!afsql_dd_flush_pending(self))
                 {
                   afsql_dd_disconnect(self);
                   afsql_dd_suspend(self);
@@ -972,12 +1222,17 @@ afsql_dd_database_thread(gpointer arg)
        * submitting that back to the SQL engine.
        */
 
-      afsql_dd_commit_txn(self);
+      afsql_dd_flush_pending(self);
     }
 
  exit:
   afsql_dd_disconnect(self);
 
+  g_free(self->batch);
+  g_free(self->batch_options);
+  self->batch = NULL;
+  self->batch_options = NULL;
+
   msg_verbose("Database thread finished",
               evt_tag_str("driver", self->super.super.id),
               NULL);
@@ -1126,6 +1381,23 @@ afsql_dd_init(LogPipe *s)
   if ((self->flags & AFSQL_DDF_EXPLICIT_COMMITS) && (self->flush_lines > 0 || self->flush_timeout > 0))
     self->flush_lines_queued = 0;
 
+  if (self->flags & AFSQL_DDF_BATCH_INSERTS)
+    {
+      if (strcmp(self->type, s_oracle) == 0)
+        {
+          msg_warning("WARNING: Oracle does not support multi-row INSERT statements, disabling batch-inserts",
+                      evt_tag_str("driver", self->super.super.id),
+                      NULL);
+          self->flags &= ~AFSQL_DDF_BATCH_INSERTS;
+        }
+      else
+        {
+          if (self->flush_lines <= 0)
+            self->flush_lines = DEFAULT_BATCH_LINES;
+          self->flush_lines_queued = 0;
+        }
+    }
+
   if (!dbi_initialized)
     {
       gint rc = dbi_initialize(NULL);
@@ -1234,6 +1506,8 @@ afsql_dd_free(LogPipe *s)
   g_hash_table_destroy(self->dbd_options_numeric);
   if (self->session_statements)
     string_list_free(self->session_statements);
+  g_string_free(self->batch_query, TRUE);
+  g_string_free(self->batch_table, TRUE);
   g_mutex_free(self->db_thread_mutex);
   g_cond_free(self->db_thread_wakeup_cond);
   log_dest_driver_free(s);
@@ -1267,6 +1541,8 @@ afsql_dd_new(void)
   self->flush_lines_queued = -1;
   self->session_statements = NULL;
   self->num_retries = MAX_FAILED_ATTEMPTS;
+  self->batch_query = g_string_sized_new(4096);
+  self->batch_table = g_string_sized_new(32);
 
   self->validated_tables = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
   self->dbd_options = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
@@ -1287,6 +1563,8 @@ afsql_dd_lookup_flag(const gchar *flag)
     return AFSQL_DDF_EXPLICIT_COMMITS;
   else if (strcmp(flag, "dont-create-tables") == 0 || strcmp(flag, "dont_create_tables") == 0)
     return AFSQL_DDF_DONT_CREATE_TABLES;
+  else if (strcmp(flag, "batch-inserts") == 0 || strcmp(flag, "batch_inserts") == 0)
+    return AFSQL_DDF_BATCH_INSERTS;
   else
     msg_warning("Unknown SQL flag",
                 evt_tag_str("flag", flag),
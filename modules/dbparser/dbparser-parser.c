@@ -33,6 +33,7 @@ static CfgLexerKeyword dbparser_keywords[] =
 {
   { "db_parser",          KW_DB_PARSER, 0x0300 },
   { "inject_mode",        KW_INJECT_MODE, 0x0303 },
+  { "compiled_file",      KW_COMPILED_FILE, 0x0304 },
   { NULL }
 };
 
@@ -43,6 +43,7 @@ struct _LogDBParser
   struct iv_timer tick;
   PatternDB *db;
   gchar *db_file;
+  gchar *compiled_file;
   time_t db_file_last_check;
   ino_t db_file_inode;
   time_t db_file_mtime;
@@ -95,7 +96,7 @@ log_db_parser_reload_database(LogDBParser *self)
   self->db_file_inode = st.st_ino;
   self->db_file_mtime = st.st_mtime;
 
-  if (!pattern_db_reload_ruleset(self->db, cfg, self->db_file))
+  if (!pattern_db_reload_compiled_ruleset(self->db, cfg, self->db_file, self->compiled_file))
     {
       msg_error("Error reloading pattern database, no automatic reload will be performed", NULL);
     }
@@ -247,6 +248,14 @@ log_db_parser_set_db_file(LogDBParser *self, const gchar *db_file)
   self->db_file = g_strdup(db_file);
 }
 
+void
+log_db_parser_set_compiled_file(LogDBParser *self, const gchar *compiled_file)
+{
+  if (self->compiled_file)
+    g_free(self->compiled_file);
+  self->compiled_file = g_strdup(compiled_file);
+}
+
 void
 log_db_parser_set_inject_mode(LogDBParser *self, const gchar *inject_mode)
 {
@@ -277,6 +286,7 @@ log_db_parser_clone(LogPipe *s)
 
   clone = (LogDBParser *) log_db_parser_new();
   log_db_parser_set_db_file(clone, self->db_file);
+  log_db_parser_set_compiled_file(clone, self->compiled_file);
   return &clone->super.super;
 }
 
@@ -290,6 +300,8 @@ log_db_parser_free(LogPipe *s)
 
   if (self->db_file)
     g_free(self->db_file);
+  if (self->compiled_file)
+    g_free(self->compiled_file);
   log_parser_free_method(s);
 }
 
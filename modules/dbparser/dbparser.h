@@ -30,6 +30,7 @@
 typedef struct _LogDBParser LogDBParser;
 
 void log_db_parser_set_db_file(LogDBParser *self, const gchar *db_file);
+void log_db_parser_set_compiled_file(LogDBParser *self, const gchar *compiled_file);
 void log_db_parser_set_inject_mode(LogDBParser *self, const gchar *inject_mode);
 LogParser *log_db_parser_new(void);
 
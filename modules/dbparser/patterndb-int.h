@@ -122,6 +122,8 @@ enum
 typedef struct _PDBAction
 {
   FilterExprNode *condition;
+  /* source of @condition, kept for the compiled ruleset */
+  gchar *condition_expr;
   guint8 trigger;
   guint8 content_type;
   guint16 rate;
@@ -175,29 +177,60 @@ typedef struct _PDBProgram
 {
   guint ref_cnt;
   RNode *rules;
+  /* compacted copy of @rules, created once the ruleset is loaded */
+  RFrozenTree *frozen_rules;
 } PDBProgram;
 
 /* rules loaded from a pdb file */
 typedef struct _PDBRuleSet
 {
   RNode *programs;
+  RFrozenTree *frozen_programs;
   gchar *version;
   gchar *pub_date;
 } PDBRuleSet;
 
 gboolean pdb_rule_set_load(PDBRuleSet *self, GlobalConfig *cfg, const gchar *config, GList **examples);
+gboolean pdb_rule_set_load_compiled(PDBRuleSet *self, GlobalConfig *cfg, const gchar *compiled_file, const gchar *source_file);
+gboolean pdb_rule_set_save_compiled(PDBRuleSet *self, const gchar *compiled_file, const gchar *source_file);
 PDBRule *pdb_rule_set_lookup(PDBRuleSet *self, PDBInput *input, GArray *dbg_list);
 
 PDBRuleSet *pdb_rule_set_new(void);
 void pdb_rule_set_free(PDBRuleSet *self);
 
-struct _PatternDB
+/* number of partitions of the correllation state */
+#define PDB_STATE_SHARDS 16
+
+/* A partition of the correllation state, contexts are assigned to shards
+ * by the hash of their key.  The timer wheel of a shard lags behind the
+ * clock of the PatternDB until the shard is locked next time. */
+typedef struct _PDBStateShard
 {
-  GStaticRWLock lock;
-  PDBRuleSet *ruleset;
+  GStaticMutex lock;
   GHashTable *state;
   TimerWheel *timer_wheel;
-  GTimeVal last_tick;
+} PDBStateShard;
+
+struct _PatternDB
+{
+  /* the ruleset is replaced without locking out readers: the lookup
+   * registers itself in ruleset_readers[ruleset_gen & 1], a reload
+   * publishes the new ruleset, flips ruleset_gen and waits for the
+   * readers of the previous generation before freeing the old one. */
+  PDBRuleSet *ruleset;
+  gint ruleset_gen;
+  gint ruleset_readers[2];
+  GStaticMutex ruleset_lock;
+
+  PDBStateShard shards[PDB_STATE_SHARDS];
+  /* rate limit states, only locked while a shard may be held */
+  GStaticMutex rate_limit_lock;
+  GHashTable *rate_limits;
+
+  /* the current time of the correllation engine and the system time of
+   * its last update in microseconds, both updated atomically */
+  volatile guint64 now;
+  volatile gint64 last_tick;
   PatternDBEmitFunc emit;
   gpointer emit_data;
 };
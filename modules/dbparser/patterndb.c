@@ -28,12 +28,17 @@
 #include "compat.h"
 #include "misc.h"
 #include "filter-expr-parser.h"
+#include "serialize.h"
 #include "patterndb-int.h"
 
 #include <string.h>
 #include <stdio.h>
 #include <errno.h>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 static NVHandle class_handle = 0;
 static NVHandle rule_id_handle = 0;
@@ -74,6 +79,12 @@ static LogTagId unknown_tag;
  */
 
 
+static inline guint64
+pattern_db_get_time(PatternDB *self)
+{
+  return __sync_fetch_and_add(&self->now, 0);
+}
+
 /**************************************************************************
  * PDBContext, represents a correllation state in the state hash table, is
  * marked with PSK_CONTEXT in the hash table key
@@ -342,6 +353,8 @@ pdb_action_set_condition(PDBAction *self, GlobalConfig *cfg, const gchar *filter
 {
   CfgLexer *lexer;
 
+  g_free(self->condition_expr);
+  self->condition_expr = g_strdup(filter_string);
   lexer = cfg_lexer_new_buffer(filter_string, strlen(filter_string));
   if (!cfg_run_parser(cfg, lexer, &filter_expr_parser, (gpointer *) &self->condition, NULL))
     {
@@ -419,6 +432,7 @@ pdb_action_free(PDBAction *self)
 {
   if (self->condition)
     filter_expr_unref(self->condition);
+  g_free(self->condition_expr);
   if (self->content_type == RAC_MESSAGE)
     pdb_message_clean(&self->content.message);
   g_free(self);
@@ -505,14 +519,15 @@ pdb_rule_check_rate_limit(PDBRule *self, PatternDB *db, PDBAction *action, LogMe
   g_string_printf(buffer, "%s:%d", self->rule_id, action->id);
   pdb_state_key_setup(&key, PSK_RATE_LIMIT, self, msg, buffer->str);
 
-  rl = g_hash_table_lookup(db->state, &key);
+  g_static_mutex_lock(&db->rate_limit_lock);
+  rl = g_hash_table_lookup(db->rate_limits, &key);
   if (!rl)
     {
       rl = pdb_rate_limit_new(&key);
-      g_hash_table_insert(db->state, &rl->key, rl);
+      g_hash_table_insert(db->rate_limits, &rl->key, rl);
       g_string_steal(buffer);
     }
-  now = timer_wheel_get_time(db->timer_wheel);
+  now = pattern_db_get_time(db);
   if (rl->last_check == 0)
     {
       rl->last_check = now;
@@ -536,8 +551,10 @@ pdb_rule_check_rate_limit(PDBRule *self, PatternDB *db, PDBAction *action, LogMe
   if (rl->buckets)
     {
       rl->buckets--;
+      g_static_mutex_unlock(&db->rate_limit_lock);
       return TRUE;
     }
+  g_static_mutex_unlock(&db->rate_limit_lock);
   return FALSE;
 }
 
@@ -752,6 +769,8 @@ pdb_program_unref(PDBProgram *s)
 
   if (--self->ref_cnt == 0)
     {
+      if (self->frozen_rules)
+        r_free_frozen_tree(self->frozen_rules);
       if (self->rules)
         r_free_node(self->rules, (void (*)(void *)) pdb_rule_unref);
 
@@ -1212,6 +1231,23 @@ GMarkupParser db_parser =
   .error = NULL
 };
 
+/* freezes the rule trees of the programs below @node, a program may be
+ * referenced from several nodes, it is frozen only once */
+static void
+pdb_rule_set_freeze_programs(RNode *node)
+{
+  PDBProgram *program = (PDBProgram *) node->value;
+  gint i;
+
+  if (program && program->rules && !program->frozen_rules)
+    program->frozen_rules = r_freeze_tree(program->rules);
+
+  for (i = 0; i < node->num_children; i++)
+    pdb_rule_set_freeze_programs(node->children[i]);
+  for (i = 0; i < node->num_pchildren; i++)
+    pdb_rule_set_freeze_programs(node->pchildren[i]);
+}
+
 gboolean
 pdb_rule_set_load(PDBRuleSet *self, GlobalConfig *cfg, const gchar *config, GList **examples)
 {
@@ -1269,6 +1305,11 @@ pdb_rule_set_load(PDBRuleSet *self, GlobalConfig *cfg, const gchar *config, GLis
   if (state.load_examples)
     *examples = state.examples;
 
+  /* the trees are not modified after this point, lookups use their
+   * compacted form */
+  pdb_rule_set_freeze_programs(self->programs);
+  self->frozen_programs = r_freeze_tree(self->programs);
+
   success = TRUE;
 
  error:
@@ -1332,7 +1373,10 @@ pdb_rule_set_lookup(PDBRuleSet *self, PDBInput *input, GArray *dbg_list)
 
   program = log_msg_get_value(msg, input->program_handle, &program_len);
   prg_matches = g_array_new(FALSE, TRUE, sizeof(RParserMatch));
-  node = r_find_node(self->programs, (gchar *) program, (gchar *) program, program_len, prg_matches);
+  if (self->frozen_programs)
+    node = r_find_frozen_node(self->frozen_programs, (gchar *) program, (gchar *) program, program_len, prg_matches);
+  else
+    node = r_find_node(self->programs, (gchar *) program, (gchar *) program, program_len, prg_matches);
 
   if (node)
     {
@@ -1366,6 +1410,8 @@ pdb_rule_set_lookup(PDBRuleSet *self, PDBInput *input, GArray *dbg_list)
 
           if (G_UNLIKELY(dbg_list))
             msg_node = r_find_node_dbg(program->rules, (gchar *) message, (gchar *) message, message_len, matches, dbg_list);
+          else if (program->frozen_rules)
+            msg_node = r_find_frozen_node(program->frozen_rules, (gchar *) message, (gchar *) message, message_len, matches);
           else
             msg_node = r_find_node(program->rules, (gchar *) message, (gchar *) message, message_len, matches);
 
@@ -1420,6 +1466,8 @@ pdb_rule_set_new(void)
 void
 pdb_rule_set_free(PDBRuleSet *self)
 {
+  if (self->frozen_programs)
+    r_free_frozen_tree(self->frozen_programs);
   if (self->programs)
     r_free_node(self->programs, (GDestroyNotify) pdb_program_unref);
   if (self->version)
@@ -1427,16 +1475,670 @@ pdb_rule_set_free(PDBRuleSet *self)
   if (self->pub_date)
     g_free(self->pub_date);
   self->programs = NULL;
+  self->frozen_programs = NULL;
   self->version = NULL;
   self->pub_date = NULL;
 
   g_free(self);
 }
 
+/*********************************************************
+ * Compiled PDBRuleSet
+ *********************************************************/
+
+/*
+ * The compiled form of a ruleset is produced by "pdbtool compile" and it
+ * lets us skip XML parsing and building the radix trees pattern by
+ * pattern. Its layout is:
+ *
+ *   - a header: magic, format version, size and checksum of the XML file
+ *     it was compiled from, size and checksum of the payload
+ *   - the payload: the version & pub_date of the ruleset, the rules, the
+ *     rule tree of each program and the program tree itself, radix tree
+ *     nodes refer to rules and programs by their index
+ *
+ * Templates and conditions are stored in source form and are compiled
+ * again while loading.  The file is only used if it was compiled from the
+ * same XML file that we would load otherwise.
+ */
+
+#define PDB_COMPILED_MAGIC   "PDBC"
+#define PDB_COMPILED_VERSION 1
+
+typedef struct _PDBCompiledHeader
+{
+  guint64 source_size;
+  guint64 source_checksum;
+  guint64 payload_size;
+  guint64 payload_checksum;
+} PDBCompiledHeader;
+
+/* 64 bit FNV-1a */
+static guint64
+pdb_compiled_checksum(const gchar *data, gsize len)
+{
+  guint64 hash = G_GUINT64_CONSTANT(14695981039346656037);
+  gsize i;
+
+  for (i = 0; i < len; i++)
+    {
+      hash ^= (guint8) data[i];
+      hash *= G_GUINT64_CONSTANT(1099511628211);
+    }
+  return hash;
+}
+
+static gboolean
+pdb_compiled_checksum_file(const gchar *filename, guint64 *size, guint64 *checksum)
+{
+  struct stat st;
+  gchar *map;
+  gint fd;
+
+  fd = open(filename, O_RDONLY);
+  if (fd < 0 || fstat(fd, &st) < 0)
+    {
+      msg_error("Error opening pattern database file",
+                evt_tag_str(EVT_TAG_FILENAME, filename),
+                evt_tag_errno(EVT_TAG_OSERROR, errno),
+                NULL);
+      if (fd >= 0)
+        close(fd);
+      return FALSE;
+    }
+
+  *size = st.st_size;
+  if (st.st_size == 0)
+    {
+      *checksum = pdb_compiled_checksum(NULL, 0);
+      close(fd);
+      return TRUE;
+    }
+
+  map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    {
+      msg_error("Error mapping pattern database file",
+                evt_tag_str(EVT_TAG_FILENAME, filename),
+                evt_tag_errno(EVT_TAG_OSERROR, errno),
+                NULL);
+      return FALSE;
+    }
+  *checksum = pdb_compiled_checksum(map, st.st_size);
+  munmap(map, st.st_size);
+  return TRUE;
+}
+
+static void
+pdb_compiled_write_opt_string(SerializeArchive *sa, const gchar *str)
+{
+  serialize_write_uint8(sa, str != NULL);
+  if (str)
+    serialize_write_cstring(sa, str, -1);
+}
+
+static gboolean
+pdb_compiled_read_string(SerializeArchive *sa, gchar **str)
+{
+  *str = NULL;
+  if (!serialize_read_cstring(sa, str, NULL))
+    {
+      g_free(*str);
+      *str = NULL;
+      return FALSE;
+    }
+  return TRUE;
+}
+
+static gboolean
+pdb_compiled_read_opt_string(SerializeArchive *sa, gchar **str)
+{
+  guint8 present;
+
+  *str = NULL;
+  if (!serialize_read_uint8(sa, &present))
+    return FALSE;
+  return !present || pdb_compiled_read_string(sa, str);
+}
+
+static LogTemplate *
+pdb_compiled_compile_template(GlobalConfig *cfg, const gchar *name, const gchar *source)
+{
+  LogTemplate *template;
+  GError *error = NULL;
+
+  template = log_template_new(cfg, name);
+  if (!log_template_compile(template, source, &error))
+    {
+      msg_error("Error compiling template in compiled pattern database",
+                evt_tag_str("template", source),
+                evt_tag_str("error", error->message),
+                NULL);
+      g_clear_error(&error);
+      log_template_unref(template);
+      return NULL;
+    }
+  return template;
+}
+
+static void
+pdb_message_serialize(PDBMessage *self, SerializeArchive *sa)
+{
+  gint i;
+
+  serialize_write_uint32(sa, self->tags ? self->tags->len : 0);
+  for (i = 0; self->tags && i < self->tags->len; i++)
+    serialize_write_cstring(sa, log_tags_get_by_id(g_array_index(self->tags, LogTagId, i)), -1);
+
+  serialize_write_uint32(sa, self->values ? self->values->len : 0);
+  for (i = 0; self->values && i < self->values->len; i++)
+    {
+      LogTemplate *value = (LogTemplate *) g_ptr_array_index(self->values, i);
+
+      serialize_write_cstring(sa, value->name, -1);
+      serialize_write_cstring(sa, value->template, -1);
+    }
+}
+
+static gboolean
+pdb_message_deserialize(PDBMessage *self, GlobalConfig *cfg, SerializeArchive *sa)
+{
+  guint32 count, i;
+  gchar *name, *source;
+  LogTemplate *value;
+
+  if (!serialize_read_uint32(sa, &count))
+    return FALSE;
+  for (i = 0; i < count; i++)
+    {
+      if (!pdb_compiled_read_string(sa, &name))
+        return FALSE;
+      pdb_message_add_tag(self, name);
+      g_free(name);
+    }
+
+  if (!serialize_read_uint32(sa, &count))
+    return FALSE;
+  for (i = 0; i < count; i++)
+    {
+      if (!pdb_compiled_read_string(sa, &name))
+        return FALSE;
+      if (!pdb_compiled_read_string(sa, &source))
+        {
+          g_free(name);
+          return FALSE;
+        }
+      value = pdb_compiled_compile_template(cfg, name, source);
+      g_free(name);
+      g_free(source);
+      if (!value)
+        return FALSE;
+
+      if (!self->values)
+        self->values = g_ptr_array_new();
+      g_ptr_array_add(self->values, value);
+    }
+  return TRUE;
+}
+
+static void
+pdb_action_serialize(PDBAction *self, SerializeArchive *sa)
+{
+  serialize_write_uint8(sa, self->id);
+  serialize_write_uint8(sa, self->trigger);
+  serialize_write_uint8(sa, self->content_type);
+  serialize_write_uint8(sa, self->inherit_properties);
+  serialize_write_uint16(sa, self->rate);
+  serialize_write_uint32(sa, self->rate_quantum);
+  pdb_compiled_write_opt_string(sa, self->condition_expr);
+  if (self->content_type == RAC_MESSAGE)
+    pdb_message_serialize(&self->content.message, sa);
+}
+
+static PDBAction *
+pdb_action_deserialize(GlobalConfig *cfg, SerializeArchive *sa)
+{
+  PDBAction *self;
+  guint8 id, trigger, content_type, inherit_properties;
+  guint16 rate;
+  guint32 rate_quantum;
+  gchar *condition;
+  GError *error = NULL;
+
+  if (!serialize_read_uint8(sa, &id) ||
+      !serialize_read_uint8(sa, &trigger) ||
+      !serialize_read_uint8(sa, &content_type) ||
+      !serialize_read_uint8(sa, &inherit_properties) ||
+      !serialize_read_uint16(sa, &rate) ||
+      !serialize_read_uint32(sa, &rate_quantum) ||
+      !pdb_compiled_read_opt_string(sa, &condition))
+    return NULL;
+
+  self = pdb_action_new(id);
+  self->trigger = trigger;
+  self->content_type = content_type;
+  self->inherit_properties = inherit_properties;
+  self->rate = rate;
+  self->rate_quantum = rate_quantum;
+  if (condition)
+    {
+      pdb_action_set_condition(self, cfg, condition, &error);
+      g_free(condition);
+      if (error)
+        {
+          g_clear_error(&error);
+          goto error;
+        }
+    }
+  if (content_type == RAC_MESSAGE && !pdb_message_deserialize(&self->content.message, cfg, sa))
+    goto error;
+  return self;
+
+ error:
+  pdb_action_free(self);
+  return NULL;
+}
+
+static void
+pdb_rule_serialize(PDBRule *self, SerializeArchive *sa)
+{
+  gint i;
+
+  serialize_write_cstring(sa, self->rule_id, -1);
+  pdb_compiled_write_opt_string(sa, self->class);
+  serialize_write_uint32(sa, self->context_timeout);
+  serialize_write_uint8(sa, self->context_scope);
+  pdb_compiled_write_opt_string(sa, self->context_id_template ? self->context_id_template->template : NULL);
+  pdb_message_serialize(&self->msg, sa);
+
+  serialize_write_uint32(sa, self->actions ? self->actions->len : 0);
+  for (i = 0; self->actions && i < self->actions->len; i++)
+    pdb_action_serialize((PDBAction *) g_ptr_array_index(self->actions, i), sa);
+}
+
+static PDBRule *
+pdb_rule_deserialize(GlobalConfig *cfg, SerializeArchive *sa)
+{
+  PDBRule *self = pdb_rule_new();
+  guint32 context_timeout, num_actions, i;
+  guint8 context_scope;
+  gchar *context_id;
+  PDBAction *action;
+
+  if (!pdb_compiled_read_string(sa, &self->rule_id) ||
+      !pdb_compiled_read_opt_string(sa, &self->class) ||
+      !serialize_read_uint32(sa, &context_timeout) ||
+      !serialize_read_uint8(sa, &context_scope) ||
+      !pdb_compiled_read_opt_string(sa, &context_id))
+    goto error;
+
+  self->context_timeout = context_timeout;
+  self->context_scope = context_scope;
+  if (context_id)
+    {
+      self->context_id_template = pdb_compiled_compile_template(cfg, NULL, context_id);
+      g_free(context_id);
+      if (!self->context_id_template)
+        goto error;
+    }
+
+  /* NOTE: the class tag is part of the stored tags */
+  if (!pdb_message_deserialize(&self->msg, cfg, sa) ||
+      !serialize_read_uint32(sa, &num_actions))
+    goto error;
+
+  for (i = 0; i < num_actions; i++)
+    {
+      if (!(action = pdb_action_deserialize(cfg, sa)))
+        goto error;
+      pdb_rule_add_action(self, action);
+    }
+  return self;
+
+ error:
+  pdb_rule_unref(self);
+  return NULL;
+}
+
+/* assigns 1 based indexes to the distinct values in a radix tree */
+static void
+pdb_compiled_collect_values(RNode *node, GHashTable *index, GPtrArray *values)
+{
+  gint i;
+
+  if (node->value && !g_hash_table_lookup(index, node->value))
+    {
+      g_ptr_array_add(values, node->value);
+      g_hash_table_insert(index, node->value, GUINT_TO_POINTER(values->len));
+    }
+
+  for (i = 0; i < node->num_children; i++)
+    pdb_compiled_collect_values(node->children[i], index, values);
+  for (i = 0; i < node->num_pchildren; i++)
+    pdb_compiled_collect_values(node->pchildren[i], index, values);
+}
+
+static guint32
+pdb_compiled_value_index(gpointer value, gpointer user_data)
+{
+  return GPOINTER_TO_UINT(g_hash_table_lookup((GHashTable *) user_data, value));
+}
+
+static gpointer
+pdb_compiled_rule_by_index(guint32 index, gpointer user_data)
+{
+  GPtrArray *rules = (GPtrArray *) user_data;
+
+  if (index > rules->len)
+    return NULL;
+  return pdb_rule_ref(g_ptr_array_index(rules, index - 1));
+}
+
+static gpointer
+pdb_compiled_program_by_index(guint32 index, gpointer user_data)
+{
+  GPtrArray *programs = (GPtrArray *) user_data;
+
+  if (index > programs->len)
+    return NULL;
+  return pdb_program_ref(g_ptr_array_index(programs, index - 1));
+}
+
+/*
+ * Writes the compiled form of @self to @compiled_file, @source_file is
+ * the XML file it was loaded from.
+ */
+gboolean
+pdb_rule_set_save_compiled(PDBRuleSet *self, const gchar *compiled_file, const gchar *source_file)
+{
+  PDBCompiledHeader header;
+  SerializeArchive *sa;
+  GHashTable *rule_index, *program_index;
+  GPtrArray *rules, *programs;
+  GString *payload;
+  gchar *temp_file;
+  FILE *f;
+  gint i;
+  gboolean success = FALSE;
+
+  if (!pdb_compiled_checksum_file(source_file, &header.source_size, &header.source_checksum))
+    return FALSE;
+
+  program_index = g_hash_table_new(g_direct_hash, g_direct_equal);
+  programs = g_ptr_array_new();
+  pdb_compiled_collect_values(self->programs, program_index, programs);
+
+  rule_index = g_hash_table_new(g_direct_hash, g_direct_equal);
+  rules = g_ptr_array_new();
+  for (i = 0; i < programs->len; i++)
+    pdb_compiled_collect_values(((PDBProgram *) g_ptr_array_index(programs, i))->rules, rule_index, rules);
+
+  payload = g_string_sized_new(65536);
+  sa = serialize_string_archive_new(payload);
+  pdb_compiled_write_opt_string(sa, self->version);
+  pdb_compiled_write_opt_string(sa, self->pub_date);
+
+  serialize_write_uint32(sa, rules->len);
+  for (i = 0; i < rules->len; i++)
+    pdb_rule_serialize((PDBRule *) g_ptr_array_index(rules, i), sa);
+
+  serialize_write_uint32(sa, programs->len);
+  for (i = 0; i < programs->len; i++)
+    r_serialize_tree(((PDBProgram *) g_ptr_array_index(programs, i))->rules, sa, pdb_compiled_value_index, rule_index);
+  r_serialize_tree(self->programs, sa, pdb_compiled_value_index, program_index);
+  serialize_archive_free(sa);
+
+  header.payload_size = payload->len;
+  header.payload_checksum = pdb_compiled_checksum(payload->str, payload->len);
+
+  /* write to a temporary file first, so that a running syslog-ng never
+   * sees a half-written file */
+  temp_file = g_strdup_printf("%s.tmp", compiled_file);
+  f = fopen(temp_file, "w");
+  if (!f)
+    {
+      msg_error("Error opening compiled pattern database file",
+                evt_tag_str(EVT_TAG_FILENAME, temp_file),
+                evt_tag_errno(EVT_TAG_OSERROR, errno),
+                NULL);
+      goto exit;
+    }
+
+  sa = serialize_file_archive_new(f);
+  serialize_write_blob(sa, PDB_COMPILED_MAGIC, 4);
+  serialize_write_uint32(sa, PDB_COMPILED_VERSION);
+  serialize_write_uint64(sa, header.source_size);
+  serialize_write_uint64(sa, header.source_checksum);
+  serialize_write_uint64(sa, header.payload_size);
+  serialize_write_uint64(sa, header.payload_checksum);
+  serialize_write_blob(sa, payload->str, payload->len);
+  success = (sa->error == NULL);
+  serialize_archive_free(sa);
+
+  if (fclose(f) != 0)
+    success = FALSE;
+  if (success && rename(temp_file, compiled_file) < 0)
+    {
+      msg_error("Error renaming compiled pattern database file",
+                evt_tag_str(EVT_TAG_FILENAME, compiled_file),
+                evt_tag_errno(EVT_TAG_OSERROR, errno),
+                NULL);
+      success = FALSE;
+    }
+  if (!success)
+    unlink(temp_file);
+
+ exit:
+  g_free(temp_file);
+  g_string_free(payload, TRUE);
+  g_ptr_array_free(rules, TRUE);
+  g_ptr_array_free(programs, TRUE);
+  g_hash_table_destroy(rule_index);
+  g_hash_table_destroy(program_index);
+  return success;
+}
+
+static gboolean
+pdb_rule_set_deserialize(PDBRuleSet *self, GlobalConfig *cfg, SerializeArchive *sa)
+{
+  GPtrArray *rules, *programs;
+  PDBRule *rule;
+  PDBProgram *program;
+  guint32 count, i;
+  gboolean success = FALSE;
+
+  rules = g_ptr_array_new();
+  programs = g_ptr_array_new();
+
+  if (!pdb_compiled_read_opt_string(sa, &self->version) ||
+      !pdb_compiled_read_opt_string(sa, &self->pub_date) ||
+      !serialize_read_uint32(sa, &count))
+    goto exit;
+
+  for (i = 0; i < count; i++)
+    {
+      if (!(rule = pdb_rule_deserialize(cfg, sa)))
+        goto exit;
+      g_ptr_array_add(rules, rule);
+    }
+
+  if (!serialize_read_uint32(sa, &count))
+    goto exit;
+  for (i = 0; i < count; i++)
+    {
+      program = g_new0(PDBProgram, 1);
+      program->ref_cnt = 1;
+      g_ptr_array_add(programs, program);
+
+      program->rules = r_deserialize_tree(sa, pdb_compiled_rule_by_index, rules, (GDestroyNotify) pdb_rule_unref);
+      if (!program->rules)
+        goto exit;
+    }
+
+  self->programs = r_deserialize_tree(sa, pdb_compiled_program_by_index, programs, (GDestroyNotify) pdb_program_unref);
+  success = (self->programs != NULL);
+
+ exit:
+  /* the trees hold their own references */
+  g_ptr_array_foreach(rules, (GFunc) pdb_rule_unref, NULL);
+  g_ptr_array_foreach(programs, (GFunc) pdb_program_unref, NULL);
+  g_ptr_array_free(rules, TRUE);
+  g_ptr_array_free(programs, TRUE);
+  return success;
+}
+
+/*
+ * Loads a ruleset compiled by pdb_rule_set_save_compiled(). Returns FALSE
+ * if the compiled file is unusable or was not compiled from the current
+ * contents of @source_file, in which case the caller should load
+ * @source_file instead.
+ */
+gboolean
+pdb_rule_set_load_compiled(PDBRuleSet *self, GlobalConfig *cfg, const gchar *compiled_file, const gchar *source_file)
+{
+  PDBCompiledHeader header;
+  SerializeArchive *sa = NULL;
+  guint64 source_size, source_checksum;
+  struct stat st;
+  gchar magic[4];
+  guint32 version;
+  gchar *map = MAP_FAILED;
+  gsize header_len;
+  gint fd;
+  gboolean success = FALSE;
+
+  fd = open(compiled_file, O_RDONLY);
+  if (fd < 0 || fstat(fd, &st) < 0)
+    {
+      msg_notice("Error opening compiled pattern database file",
+                 evt_tag_str(EVT_TAG_FILENAME, compiled_file),
+                 evt_tag_errno(EVT_TAG_OSERROR, errno),
+                 NULL);
+      if (fd >= 0)
+        close(fd);
+      return FALSE;
+    }
+
+  if (st.st_size > 0)
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    {
+      msg_notice("Error mapping compiled pattern database file",
+                 evt_tag_str(EVT_TAG_FILENAME, compiled_file),
+                 NULL);
+      return FALSE;
+    }
+
+  sa = serialize_buffer_archive_new(map, st.st_size);
+  sa->silent = TRUE;
+  if (!serialize_read_blob(sa, magic, 4) ||
+      memcmp(magic, PDB_COMPILED_MAGIC, 4) != 0 ||
+      !serialize_read_uint32(sa, &version) ||
+      version != PDB_COMPILED_VERSION ||
+      !serialize_read_uint64(sa, &header.source_size) ||
+      !serialize_read_uint64(sa, &header.source_checksum) ||
+      !serialize_read_uint64(sa, &header.payload_size) ||
+      !serialize_read_uint64(sa, &header.payload_checksum))
+    {
+      msg_notice("Compiled pattern database file has an unknown format",
+                 evt_tag_str(EVT_TAG_FILENAME, compiled_file),
+                 NULL);
+      goto exit;
+    }
+
+  header_len = serialize_buffer_archive_get_pos(sa);
+  if (header.payload_size != st.st_size - header_len ||
+      header.payload_checksum != pdb_compiled_checksum(map + header_len, header.payload_size))
+    {
+      msg_notice("Compiled pattern database file is corrupt",
+                 evt_tag_str(EVT_TAG_FILENAME, compiled_file),
+                 NULL);
+      goto exit;
+    }
+
+  if (!pdb_compiled_checksum_file(source_file, &source_size, &source_checksum))
+    goto exit;
+  if (source_size != header.source_size || source_checksum != header.source_checksum)
+    {
+      msg_notice("Compiled pattern database file is out of date",
+                 evt_tag_str(EVT_TAG_FILENAME, compiled_file),
+                 evt_tag_str("source", source_file),
+                 NULL);
+      goto exit;
+    }
+
+  if (!pdb_rule_set_deserialize(self, cfg, sa))
+    {
+      msg_error("Error loading compiled pattern database file",
+                evt_tag_str(EVT_TAG_FILENAME, compiled_file),
+                NULL);
+      goto exit;
+    }
+
+  pdb_rule_set_freeze_programs(self->programs);
+  self->frozen_programs = r_freeze_tree(self->programs);
+  success = TRUE;
+
+ exit:
+  serialize_archive_free(sa);
+  munmap(map, st.st_size);
+  return success;
+}
+
 /*********************************************************
  * PatternDB
  *********************************************************/
 
+static inline PDBStateShard *
+pattern_db_get_shard(PatternDB *self, PDBStateKey *key)
+{
+  return &self->shards[pdb_state_key_hash(key) % PDB_STATE_SHARDS];
+}
+
+/* locks a shard and catches its timer wheel up with the current time */
+static void
+pattern_db_lock_shard(PatternDB *self, PDBStateShard *shard)
+{
+  g_static_mutex_lock(&shard->lock);
+  timer_wheel_set_time(shard->timer_wheel, pattern_db_get_time(self));
+}
+
+static void
+pattern_db_unlock_shard(PatternDB *self, PDBStateShard *shard)
+{
+  g_static_mutex_unlock(&shard->lock);
+}
+
+/* expires the contexts in all shards that timed out by the current time */
+static void
+pattern_db_expire_shards(PatternDB *self)
+{
+  gint i;
+
+  for (i = 0; i < PDB_STATE_SHARDS; i++)
+    {
+      pattern_db_lock_shard(self, &self->shards[i]);
+      pattern_db_unlock_shard(self, &self->shards[i]);
+    }
+}
+
+/* moves the current time forward, it never goes backwards */
+static void
+pattern_db_advance_clock(PatternDB *self, guint64 new_now)
+{
+  guint64 now;
+
+  do
+    {
+      now = pattern_db_get_time(self);
+      if (now >= new_now)
+        return;
+    }
+  while (!__sync_bool_compare_and_swap(&self->now, now, new_now));
+}
+
 static void
 pattern_db_expire_entry(guint64 now, gpointer user_data)
 {
@@ -1446,11 +2148,12 @@ pattern_db_expire_entry(guint64 now, gpointer user_data)
 
   msg_debug("Expiring patterndb correllation context",
             evt_tag_str("last_rule", context->rule->rule_id),
-            evt_tag_long("utc", timer_wheel_get_time(context->db->timer_wheel)),
+            evt_tag_long("utc", now),
             NULL);
   if (pdb->emit)
     pdb_rule_run_actions(context->rule, RAT_TIMEOUT, context->db, context, g_ptr_array_index(context->messages, context->messages->len - 1), pdb->emit, pdb->emit_data, buffer);
-  g_hash_table_remove(context->db->state, &context->key);
+  /* the timer wheel of the shard is being advanced, so the shard is locked */
+  g_hash_table_remove(pattern_db_get_shard(pdb, &context->key)->state, &context->key);
   g_string_free(buffer, TRUE);
 
   /* pdb_context_free is automatically called when returning from
@@ -1458,6 +2161,17 @@ pattern_db_expire_entry(guint64 now, gpointer user_data)
      callback. */
 }
 
+/*
+ * Moves the current time forward by timeout seconds and expires the
+ * contexts that timed out meanwhile.
+ */
+void
+pattern_db_advance_time(PatternDB *self, gint timeout)
+{
+  pattern_db_advance_clock(self, pattern_db_get_time(self) + timeout);
+  pattern_db_expire_shards(self);
+}
+
 /*
  * This function can be called any time when pattern-db is not processing
  * messages, but we expect the correllation timer to move forward.  It
@@ -1465,35 +2179,36 @@ pattern_db_expire_entry(guint64 now, gpointer user_data)
  * system time to determine how much time has passed since the last
  * invocation.  See the timing comment at pattern_db_process() for more
  * information.
+ *
+ * Messages only advance the time without expiring the contexts of the
+ * shards they don't touch, it is the tick that expires those.
  */
 void
 pattern_db_timer_tick(PatternDB *self)
 {
   GTimeVal now;
-  glong diff;
+  gint64 now_usec, last_tick, diff;
 
-  g_static_rw_lock_writer_lock(&self->lock);
   cached_g_current_time(&now);
-  diff = g_time_val_diff(&now, &self->last_tick);
-
-  if (diff > 1e6)
+  now_usec = (gint64) now.tv_sec * G_USEC_PER_SEC + now.tv_usec;
+  last_tick = __sync_fetch_and_add(&self->last_tick, 0);
+  diff = now_usec - last_tick;
+
+  /* update last_tick, take the fraction of the seconds not calculated
+   * into this update into account; if an incoming message updated it in
+   * the meantime, the time was advanced by that message */
+  if (diff > G_USEC_PER_SEC &&
+      __sync_bool_compare_and_swap(&self->last_tick, last_tick, now_usec - diff % G_USEC_PER_SEC))
     {
-      glong diff_sec = diff / 1e6;
-
-      timer_wheel_set_time(self->timer_wheel, timer_wheel_get_time(self->timer_wheel) + diff_sec);
+      pattern_db_advance_clock(self, pattern_db_get_time(self) + diff / G_USEC_PER_SEC);
       msg_debug("Advancing patterndb current time because of timer tick",
-                evt_tag_long("utc", timer_wheel_get_time(self->timer_wheel)),
+                evt_tag_long("utc", pattern_db_get_time(self)),
                 NULL);
-      /* update last_tick, take the fraction of the seconds not calculated into this update into account */
-
-      self->last_tick = now;
-      g_time_val_add(&self->last_tick, -(diff - diff_sec * 1e6));
     }
-  g_static_rw_lock_writer_unlock(&self->lock);
+  pattern_db_expire_shards(self);
 }
 
-/* NOTE: lock should be acquired for writing before calling this function. */
-void
+static void
 pattern_db_set_time(PatternDB *self, const LogStamp *ls)
 {
   GTimeVal now;
@@ -1504,59 +2219,147 @@ pattern_db_set_time(PatternDB *self, const LogStamp *ls)
    * correllation engine too much. */
 
   cached_g_current_time(&now);
-  self->last_tick = now;
+  (void) __sync_lock_test_and_set(&self->last_tick, (gint64) now.tv_sec * G_USEC_PER_SEC + now.tv_usec);
 
   if (ls->tv_sec < now.tv_sec)
     now.tv_sec = ls->tv_sec;
 
-  timer_wheel_set_time(self->timer_wheel, now.tv_sec);
+  pattern_db_advance_clock(self, now.tv_sec);
   msg_debug("Advancing patterndb current time because of an incoming message",
-            evt_tag_long("utc", timer_wheel_get_time(self->timer_wheel)),
+            evt_tag_long("utc", pattern_db_get_time(self)),
             NULL);
 }
 
+/* looks up the rule matching input without locking out a parallel reload */
+static PDBRule *
+pattern_db_lookup_rule(PatternDB *self, PDBInput *input)
+{
+  PDBRule *rule;
+  gint gen;
+
+  /* register as a reader of the current generation, retry if a reload
+   * started a new one meanwhile, as that may already wait for our
+   * generation to drain */
+  while (1)
+    {
+      gen = g_atomic_int_get(&self->ruleset_gen);
+      g_atomic_int_inc(&self->ruleset_readers[gen & 1]);
+      if (g_atomic_int_get(&self->ruleset_gen) == gen)
+        break;
+      g_atomic_int_add(&self->ruleset_readers[gen & 1], -1);
+    }
+  rule = pdb_rule_set_lookup((PDBRuleSet *) g_atomic_pointer_get(&self->ruleset), input, NULL);
+  g_atomic_int_add(&self->ruleset_readers[gen & 1], -1);
+  return rule;
+}
+
+/*
+ * Loads @pdb_file and replaces the current ruleset with it. If
+ * @compiled_file is non-NULL, it is tried first and @pdb_file is only
+ * parsed if @compiled_file was not compiled from its current contents.
+ */
 gboolean
-pattern_db_reload_ruleset(PatternDB *self, GlobalConfig *cfg, const gchar *pdb_file)
+pattern_db_reload_compiled_ruleset(PatternDB *self, GlobalConfig *cfg, const gchar *pdb_file, const gchar *compiled_file)
 {
-  PDBRuleSet *new_ruleset;
+  PDBRuleSet *new_ruleset, *old_ruleset;
+  gint gen;
 
   new_ruleset = pdb_rule_set_new();
-  if (!pdb_rule_set_load(new_ruleset, cfg, pdb_file, NULL))
+  if (compiled_file && !pdb_rule_set_load_compiled(new_ruleset, cfg, compiled_file, pdb_file))
+    {
+      msg_notice("Falling back to loading the pattern database from its source",
+                 evt_tag_str("file", pdb_file),
+                 NULL);
+      pdb_rule_set_free(new_ruleset);
+      new_ruleset = pdb_rule_set_new();
+      compiled_file = NULL;
+    }
+
+  if (!compiled_file && !pdb_rule_set_load(new_ruleset, cfg, pdb_file, NULL))
     {
       pdb_rule_set_free(new_ruleset);
       return FALSE;
     }
   else
     {
-      g_static_rw_lock_writer_lock(&self->lock);
-      if (self->ruleset)
-        pdb_rule_set_free(self->ruleset);
-      self->ruleset = new_ruleset;
-      g_static_rw_lock_writer_unlock(&self->lock);
+      g_static_mutex_lock(&self->ruleset_lock);
+      old_ruleset = self->ruleset;
+      g_atomic_pointer_set(&self->ruleset, new_ruleset);
+
+      /* readers registered from now on see the new ruleset, wait for the
+       * ones that may still use the old one */
+      gen = g_atomic_int_get(&self->ruleset_gen);
+      g_atomic_int_inc(&self->ruleset_gen);
+      while (g_atomic_int_get(&self->ruleset_readers[gen & 1]) > 0)
+        g_thread_yield();
+      g_static_mutex_unlock(&self->ruleset_lock);
+
+      if (old_ruleset)
+        pdb_rule_set_free(old_ruleset);
       return TRUE;
     }
 }
 
+gboolean
+pattern_db_reload_ruleset(PatternDB *self, GlobalConfig *cfg, const gchar *pdb_file)
+{
+  return pattern_db_reload_compiled_ruleset(self, cfg, pdb_file, NULL);
+}
+
 void
 pattern_db_expire_state(PatternDB *self)
 {
-  g_static_rw_lock_writer_lock(&self->lock);
-  timer_wheel_expire_all(self->timer_wheel);
-  g_static_rw_lock_writer_unlock(&self->lock);
+  gint i;
+
+  for (i = 0; i < PDB_STATE_SHARDS; i++)
+    {
+      pattern_db_lock_shard(self, &self->shards[i]);
+      timer_wheel_expire_all(self->shards[i].timer_wheel);
+      pattern_db_unlock_shard(self, &self->shards[i]);
+    }
+}
+
+static void
+pattern_db_init_state(PatternDB *self)
+{
+  gint i;
+
+  for (i = 0; i < PDB_STATE_SHARDS; i++)
+    {
+      self->shards[i].state = g_hash_table_new_full(pdb_state_key_hash, pdb_state_key_equal, NULL, (GDestroyNotify) pdb_state_entry_free);
+      self->shards[i].timer_wheel = timer_wheel_new();
+    }
+  self->rate_limits = g_hash_table_new_full(pdb_state_key_hash, pdb_state_key_equal, NULL, (GDestroyNotify) pdb_state_entry_free);
+}
+
+static void
+pattern_db_free_state(PatternDB *self)
+{
+  gint i;
+
+  for (i = 0; i < PDB_STATE_SHARDS; i++)
+    {
+      timer_wheel_free(self->shards[i].timer_wheel);
+      g_hash_table_destroy(self->shards[i].state);
+    }
+  g_hash_table_destroy(self->rate_limits);
 }
 
 void
 pattern_db_forget_state(PatternDB *self)
 {
-  g_static_rw_lock_writer_lock(&self->lock);
-  if (self->timer_wheel)
-    timer_wheel_free(self->timer_wheel);
+  gint i;
 
-  if (self->state)
-    g_hash_table_destroy(self->state);
-  self->state = g_hash_table_new_full(pdb_state_key_hash, pdb_state_key_equal, NULL, (GDestroyNotify) pdb_state_entry_free);
-  self->timer_wheel = timer_wheel_new();
-  g_static_rw_lock_writer_unlock(&self->lock);
+  for (i = 0; i < PDB_STATE_SHARDS; i++)
+    g_static_mutex_lock(&self->shards[i].lock);
+  g_static_mutex_lock(&self->rate_limit_lock);
+
+  pattern_db_free_state(self);
+  pattern_db_init_state(self);
+
+  g_static_mutex_unlock(&self->rate_limit_lock);
+  for (i = PDB_STATE_SHARDS - 1; i >= 0; i--)
+    g_static_mutex_unlock(&self->shards[i].lock);
 }
 
 void
@@ -1587,16 +2390,14 @@ pattern_db_process(PatternDB *self, PDBInput *input)
   if (G_UNLIKELY(!self->ruleset))
     return FALSE;
 
-  g_static_rw_lock_reader_lock(&self->lock);
-  rule = pdb_rule_set_lookup(self->ruleset, input, NULL);
-  g_static_rw_lock_reader_unlock(&self->lock);
+  rule = pattern_db_lookup_rule(self, input);
+  pattern_db_set_time(self, &msg->timestamps[LM_TS_STAMP]);
   if (rule)
     {
       PDBContext *context = NULL;
+      PDBStateShard *shard = NULL;
       GString *buffer = g_string_sized_new(32);
 
-      g_static_rw_lock_writer_lock(&self->lock);
-      pattern_db_set_time(self, &msg->timestamps[LM_TS_STAMP]);
       if (rule->context_id_template)
         {
           PDBStateKey key;
@@ -1604,17 +2405,19 @@ pattern_db_process(PatternDB *self, PDBInput *input)
           log_template_format(rule->context_id_template, msg, NULL, LTZ_LOCAL, 0, NULL, buffer);
 
           pdb_state_key_setup(&key, PSK_CONTEXT, rule, msg, buffer->str);
-          context = g_hash_table_lookup(self->state, &key);
+          shard = pattern_db_get_shard(self, &key);
+          pattern_db_lock_shard(self, shard);
+          context = g_hash_table_lookup(shard->state, &key);
           if (!context)
             {
               msg_debug("Correllation context lookup failure, starting a new context",
                         evt_tag_str("rule", rule->rule_id),
                         evt_tag_str("context", buffer->str),
                         evt_tag_int("context_timeout", rule->context_timeout),
-                        evt_tag_int("context_expiration", timer_wheel_get_time(self->timer_wheel) + rule->context_timeout),
+                        evt_tag_int("context_expiration", timer_wheel_get_time(shard->timer_wheel) + rule->context_timeout),
                         NULL);
               context = pdb_context_new(self, &key);
-              g_hash_table_insert(self->state, &context->key, context);
+              g_hash_table_insert(shard->state, &context->key, context);
               g_string_steal(buffer);
             }
           else
@@ -1623,7 +2426,7 @@ pattern_db_process(PatternDB *self, PDBInput *input)
                         evt_tag_str("rule", rule->rule_id),
                         evt_tag_str("context", buffer->str),
                         evt_tag_int("context_timeout", rule->context_timeout),
-                        evt_tag_int("context_expiration", timer_wheel_get_time(self->timer_wheel) + rule->context_timeout),
+                        evt_tag_int("context_expiration", timer_wheel_get_time(shard->timer_wheel) + rule->context_timeout),
                         evt_tag_int("num_messages", context->messages->len),
                         NULL);
             }
@@ -1632,11 +2435,11 @@ pattern_db_process(PatternDB *self, PDBInput *input)
 
           if (context->timer)
             {
-              timer_wheel_mod_timer(self->timer_wheel, context->timer, rule->context_timeout);
+              timer_wheel_mod_timer(shard->timer_wheel, context->timer, rule->context_timeout);
             }
           else
             {
-              context->timer = timer_wheel_add_timer(self->timer_wheel, rule->context_timeout, pattern_db_expire_entry, pdb_context_ref(context), (GDestroyNotify) pdb_context_unref);
+              context->timer = timer_wheel_add_timer(shard->timer_wheel, rule->context_timeout, pattern_db_expire_entry, pdb_context_ref(context), (GDestroyNotify) pdb_context_unref);
             }
           if (context->rule != rule)
             {
@@ -1645,11 +2448,8 @@ pattern_db_process(PatternDB *self, PDBInput *input)
               context->rule = pdb_rule_ref(rule);
             }
         }
-      else
-        {
-          context = NULL;
-        }
 
+      /* rules without a context don't touch the correllation state */
       pdb_message_apply(&rule->msg, context, msg, buffer);
       if (self->emit)
         {
@@ -1657,7 +2457,8 @@ pattern_db_process(PatternDB *self, PDBInput *input)
           pdb_rule_run_actions(rule, RAT_MATCH, self, context, msg, self->emit, self->emit_data, buffer);
         }
       pdb_rule_unref(rule);
-      g_static_rw_lock_writer_unlock(&self->lock);
+      if (shard)
+        pattern_db_unlock_shard(self, shard);
 
       if (context)
         log_msg_write_protect(msg);
@@ -1666,9 +2467,6 @@ pattern_db_process(PatternDB *self, PDBInput *input)
     }
   else
     {
-      g_static_rw_lock_writer_lock(&self->lock);
-      pattern_db_set_time(self, &msg->timestamps[LM_TS_STAMP]);
-      g_static_rw_lock_writer_unlock(&self->lock);
       if (self->emit)
         self->emit(msg, FALSE, self->emit_data);
     }
@@ -1680,25 +2478,33 @@ PatternDB *
 pattern_db_new(void)
 {
   PatternDB *self = g_new0(PatternDB, 1);
+  GTimeVal now;
+  gint i;
 
   self->ruleset = pdb_rule_set_new();
-  self->state = g_hash_table_new_full(pdb_state_key_hash, pdb_state_key_equal, NULL, (GDestroyNotify) pdb_state_entry_free);
-  self->timer_wheel = timer_wheel_new();
-  cached_g_current_time(&self->last_tick);
-  g_static_rw_lock_init(&self->lock);
+  g_static_mutex_init(&self->ruleset_lock);
+  for (i = 0; i < PDB_STATE_SHARDS; i++)
+    g_static_mutex_init(&self->shards[i].lock);
+  g_static_mutex_init(&self->rate_limit_lock);
+  pattern_db_init_state(self);
+  cached_g_current_time(&now);
+  self->last_tick = (gint64) now.tv_sec * G_USEC_PER_SEC + now.tv_usec;
   return self;
 }
 
 void
 pattern_db_free(PatternDB *self)
 {
+  gint i;
+
   if (self->ruleset)
     pdb_rule_set_free(self->ruleset);
 
-  if (self->state)
-    g_hash_table_destroy(self->state);
-  if (self->timer_wheel)
-    timer_wheel_free(self->timer_wheel);
+  pattern_db_free_state(self);
+  for (i = 0; i < PDB_STATE_SHARDS; i++)
+    g_static_mutex_free(&self->shards[i].lock);
+  g_static_mutex_free(&self->rate_limit_lock);
+  g_static_mutex_free(&self->ruleset_lock);
   g_free(self);
 }
 
@@ -963,6 +963,37 @@ pdbtool_dictionary(int argc, char *argv[])
   return 0;
 }
 
+static gchar *compiled_file = NULL;
+
+static gint
+pdbtool_compile(int argc, char *argv[])
+{
+  PDBRuleSet *rule_set;
+  gint ret = 0;
+
+  if (!compiled_file)
+    {
+      fprintf(stderr, "No output file was specified, use --output\n");
+      return 1;
+    }
+
+  rule_set = pdb_rule_set_new();
+  if (!pdb_rule_set_load(rule_set, configuration, patterndb_file, NULL) ||
+      !pdb_rule_set_save_compiled(rule_set, compiled_file, patterndb_file))
+    ret = 1;
+  pdb_rule_set_free(rule_set);
+  return ret;
+}
+
+static GOptionEntry compile_options[] =
+{
+  { "pdb",       'p', 0, G_OPTION_ARG_STRING, &patterndb_file,
+    "Name of the patterndb file", "<patterndb_file>" },
+  { "output",    'o', 0, G_OPTION_ARG_STRING, &compiled_file,
+    "Name of the compiled patterndb file", "<compiled_file>" },
+  { NULL, 0, 0, G_OPTION_ARG_NONE, NULL, NULL }
+};
+
 static gboolean
 pdbtool_load_module(const gchar *option_name, const gchar *value, gpointer data, GError **error)
 {
@@ -1091,6 +1122,7 @@ static struct
   { "test", test_options, "Test pattern databases", pdbtool_test },
   { "patternize", patternize_options, "Create a pattern database from logs", pdbtool_patternize },
   { "dictionary", dictionary_options, "Dump pattern dictionary", pdbtool_dictionary },
+  { "compile", compile_options, "Compile a pattern database for faster loading", pdbtool_compile },
   { NULL, NULL },
 };
 
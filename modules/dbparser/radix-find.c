@@ -223,6 +223,8 @@ r_find_node_dbg(RNode *root, guint8 *whole_key, guint8 *key, gint keylen, GArray
                             }
                         }
                     }
+                  else if (ret)
+                    break;
                 }
             }
           if (!ret && matches)
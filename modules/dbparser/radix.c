@@ -22,6 +22,7 @@
  */
 
 #include "radix.h"
+#include "logmatcher.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -124,9 +125,10 @@ r_parser_pcre(guint8 *str, gint *len, const gchar *param, gpointer state, RParse
 {
   RParserPCREState *self = (RParserPCREState *) state;
   gint rc;
-  gint matches[2];
+  /* only the extent of the whole match is needed, pcre needs a multiple of three */
+  gint matches[3];
 
-  rc = pcre_exec(self->re, self->extra, str, strlen(str), 0, 0, matches, 2);
+  rc = pcre_exec(self->re, self->extra, str, strlen(str), 0, 0, matches, 3);
   if (rc <= 0)
     return FALSE;
   *len = matches[1] - matches[0];
@@ -154,7 +156,7 @@ r_parser_pcre_compile_state(const gchar *expr)
       g_free(self);
       return NULL;
     }
-  self->extra = pcre_study(self->re, 0, &errptr);
+  self->extra = log_matcher_pcre_study(self->re, &errptr);
   if (errptr)
     {
       msg_error("Error while optimizing regular expression",
@@ -162,8 +164,7 @@ r_parser_pcre_compile_state(const gchar *expr)
                 evt_tag_str("error_message", errptr),
                 NULL);
       pcre_free(self->re);
-      if (self->extra)
-        pcre_free(self->extra);
+      log_matcher_pcre_free_study(self->extra);
       g_free(self);
       return NULL;
     }
@@ -177,8 +178,7 @@ r_parser_pcre_free_state(gpointer s)
 
   if (self->re)
     pcre_free(self->re);
-  if (self->extra)
-    pcre_free(self->extra);
+  log_matcher_pcre_free_study(self->extra);
   g_free(self);
 }
 #endif
@@ -849,10 +849,10 @@ r_find_pchild(RNode *parent, RParserNode *parser_node)
 }
 
 RNode *
-r_find_child(RNode *root, char key)
+r_find_child(RNode *root, guint8 key)
 {
   register gint l, u, idx;
-  register char k = key;
+  register guint8 k = key;
 
   l = 0;
   u = root->num_children;
@@ -1119,3 +1119,407 @@ r_free_node(RNode *node, void (*free_fn)(gpointer data))
 
   g_free(node);
 }
+
+/**************************************************************
+ * Serialization
+ **************************************************************/
+
+/* the keyword r_new_pnode() recognizes for a parser type */
+static const gchar *
+r_parser_type_keyword(guint8 type)
+{
+  switch (type)
+    {
+      case RPT_IP:
+        return "IPvANY";
+      case RPT_PCRE:
+        return "PCRE";
+      default:
+        return r_parser_type_name(type);
+    }
+}
+
+static gboolean
+r_serialize_node(RNode *node, SerializeArchive *sa, RNodeValueIndexFunc value_index, gpointer user_data)
+{
+  gint i;
+
+  if (node->parser)
+    {
+      RParserNode *parser = node->parser;
+      gchar *spec;
+
+      spec = g_strdup_printf("%s:%s%s%s",
+                             r_parser_type_keyword(parser->type),
+                             parser->handle ? log_msg_get_value_name(parser->handle, NULL) : "",
+                             parser->param ? ":" : "",
+                             parser->param ? parser->param : "");
+      serialize_write_uint8(sa, 1);
+      serialize_write_cstring(sa, spec, -1);
+      g_free(spec);
+    }
+  else
+    {
+      serialize_write_uint8(sa, 0);
+      serialize_write_cstring(sa, node->key, node->keylen);
+    }
+  serialize_write_uint32(sa, node->value ? value_index(node->value, user_data) : 0);
+
+  serialize_write_uint32(sa, node->num_children);
+  for (i = 0; i < node->num_children; i++)
+    r_serialize_node(node->children[i], sa, value_index, user_data);
+
+  serialize_write_uint32(sa, node->num_pchildren);
+  for (i = 0; i < node->num_pchildren; i++)
+    r_serialize_node(node->pchildren[i], sa, value_index, user_data);
+
+  return sa->error == NULL;
+}
+
+/**
+ * r_serialize_tree:
+ *
+ * Writes the tree at @root to @sa, node values are stored as the indexes
+ * returned by @value_index.
+ */
+gboolean
+r_serialize_tree(RNode *root, SerializeArchive *sa, RNodeValueIndexFunc value_index, gpointer user_data)
+{
+  return r_serialize_node(root, sa, value_index, user_data);
+}
+
+/**
+ * r_deserialize_tree:
+ *
+ * Reads back a tree written by r_serialize_tree(), @index_value is used to
+ * turn the stored indexes back to node values.  The values already
+ * acquired are freed using @free_fn if the archive turns out to be
+ * invalid.
+ */
+RNode *
+r_deserialize_tree(SerializeArchive *sa, RNodeIndexValueFunc index_value, gpointer user_data, void (*free_fn)(gpointer data))
+{
+  RNode *node;
+  guint8 is_parser;
+  gchar *key = NULL;
+  guint32 value, num_children, i;
+
+  if (!serialize_read_uint8(sa, &is_parser) ||
+      !serialize_read_cstring(sa, &key, NULL) ||
+      !serialize_read_uint32(sa, &value))
+    {
+      g_free(key);
+      return NULL;
+    }
+
+  if (is_parser)
+    {
+      RParserNode *parser = r_new_pnode(key);
+
+      g_free(key);
+      if (!parser)
+        return NULL;
+      node = r_new_node(NULL, NULL);
+      node->parser = parser;
+    }
+  else
+    {
+      node = r_new_node(key, NULL);
+      g_free(key);
+    }
+
+  if (value)
+    {
+      node->value = index_value(value, user_data);
+      if (!node->value)
+        goto error;
+    }
+
+  if (!serialize_read_uint32(sa, &num_children))
+    goto error;
+  node->children = g_new0(RNode *, num_children);
+  for (i = 0; i < num_children; i++)
+    {
+      if (!(node->children[i] = r_deserialize_tree(sa, index_value, user_data, free_fn)))
+        goto error;
+      node->num_children++;
+    }
+
+  if (!serialize_read_uint32(sa, &num_children))
+    goto error;
+  node->pchildren = g_new0(RNode *, num_children);
+  for (i = 0; i < num_children; i++)
+    {
+      if (!(node->pchildren[i] = r_deserialize_tree(sa, index_value, user_data, free_fn)))
+        goto error;
+      node->num_pchildren++;
+    }
+
+  return node;
+
+ error:
+  if (node->parser)
+    r_free_pnode(node, free_fn);
+  else
+    r_free_node(node, free_fn);
+  return NULL;
+}
+
+/**************************************************************
+ * Frozen trees
+ **************************************************************/
+
+/* nodes with at least this many literal children get a dispatch table */
+#define R_FROZEN_DISPATCH_MIN 8
+
+static void
+r_frozen_tree_count(RNode *node, guint *num_nodes, gsize *keys_len, guint *num_dispatch)
+{
+  gint i;
+
+  (*num_nodes)++;
+  if (node->keylen > 0)
+    *keys_len += node->keylen;
+  if (node->num_children >= R_FROZEN_DISPATCH_MIN)
+    (*num_dispatch)++;
+
+  for (i = 0; i < node->num_children; i++)
+    r_frozen_tree_count(node->children[i], num_nodes, keys_len, num_dispatch);
+  for (i = 0; i < node->num_pchildren; i++)
+    r_frozen_tree_count(node->pchildren[i], num_nodes, keys_len, num_dispatch);
+}
+
+/**
+ * r_freeze_tree:
+ *
+ * Creates the compacted representation of the tree at @root.  It has to
+ * be called after all the nodes were inserted.
+ */
+RFrozenTree *
+r_freeze_tree(RNode *root)
+{
+  RFrozenTree *self = g_new0(RFrozenTree, 1);
+  RNode **order;
+  guint num_dispatch = 0, next_dispatch = 0, tail = 1, idx;
+  gsize keys_len = 0, key_ofs = 0;
+  gint i;
+
+  r_frozen_tree_count(root, &self->num_nodes, &keys_len, &num_dispatch);
+
+  self->nodes = g_new0(RFrozenNode, self->num_nodes);
+  self->first_chars = g_new0(guint8, self->num_nodes);
+  self->keys = g_malloc(keys_len + 1);
+  self->dispatch = g_new0(guint16, num_dispatch * 256);
+
+  /* breadth first order, so that siblings are adjacent */
+  order = g_new(RNode *, self->num_nodes);
+  order[0] = root;
+
+  for (idx = 0; idx < self->num_nodes; idx++)
+    {
+      RNode *node = order[idx];
+      RFrozenNode *frozen = &self->nodes[idx];
+
+      frozen->node = node;
+      frozen->value = node->value;
+      frozen->keylen = node->keylen;
+      frozen->key_ofs = key_ofs;
+      if (node->keylen > 0)
+        {
+          memcpy(&self->keys[key_ofs], node->key, node->keylen);
+          key_ofs += node->keylen;
+          self->first_chars[idx] = node->key[0];
+        }
+      frozen->parser = node->parser;
+      if (node->parser)
+        {
+          frozen->first = node->parser->first;
+          frozen->last = node->parser->last;
+        }
+
+      frozen->children = tail;
+      frozen->num_children = node->num_children;
+      frozen->num_pchildren = node->num_pchildren;
+      frozen->dispatch = -1;
+
+      for (i = 0; i < node->num_children; i++)
+        order[tail++] = node->children[i];
+      for (i = 0; i < node->num_pchildren; i++)
+        order[tail++] = node->pchildren[i];
+
+      if (node->num_children >= R_FROZEN_DISPATCH_MIN)
+        {
+          guint16 *table = &self->dispatch[next_dispatch * 256];
+
+          for (i = 0; i < node->num_children; i++)
+            table[node->children[i]->key[0]] = i + 1;
+          frozen->dispatch = next_dispatch++;
+        }
+    }
+  g_free(order);
+  return self;
+}
+
+void
+r_free_frozen_tree(RFrozenTree *self)
+{
+  g_free(self->nodes);
+  g_free(self->first_chars);
+  g_free(self->keys);
+  g_free(self->dispatch);
+  g_free(self);
+}
+
+static inline RFrozenNode *
+r_find_frozen_child(RFrozenTree *self, RFrozenNode *root, guint8 key)
+{
+  register gint l, u, idx;
+  guint8 *first_chars;
+
+  if (root->dispatch >= 0)
+    {
+      idx = self->dispatch[(root->dispatch << 8) + key];
+      return idx ? &self->nodes[root->children + idx - 1] : NULL;
+    }
+
+  first_chars = &self->first_chars[root->children];
+  l = 0;
+  u = root->num_children;
+
+  while (l < u)
+    {
+      idx = (l + u) / 2;
+
+      if (first_chars[idx] > key)
+        u = idx;
+      else if (first_chars[idx] < key)
+        l = idx + 1;
+      else
+        return &self->nodes[root->children + idx];
+    }
+
+  return NULL;
+}
+
+/* NOTE: this follows the algorithm in radix-find.c, see the comments
+ * there, the two have to be kept in sync. */
+static RFrozenNode *
+r_find_frozen(RFrozenTree *self, RFrozenNode *root, guint8 *whole_key, guint8 *key, gint keylen, GArray *matches)
+{
+  RFrozenNode *node, *ret;
+  gint nodelen = root->keylen;
+  gint j, m;
+  register gint i;
+
+  if (nodelen < 1)
+    i = 0;
+  else if (nodelen == 1)
+    i = 1;
+  else
+    {
+      guint8 *root_key = &self->keys[root->key_ofs];
+
+      m = MIN(keylen, nodelen);
+      i = 1;
+      while (i < m)
+        {
+          if (key[i] != root_key[i])
+            break;
+
+          i++;
+        }
+    }
+
+  if (i == keylen && (i == nodelen || nodelen == -1))
+    {
+      if (root->value)
+        return root;
+    }
+  else if ((nodelen < 1) || (i < keylen && i >= nodelen))
+    {
+      ret = NULL;
+      node = r_find_frozen_child(self, root, key[i]);
+
+      if (node)
+        ret = r_find_frozen(self, node, whole_key, key + i, keylen - i, matches);
+
+      if (!ret && root->num_pchildren)
+        {
+          gint len;
+          RFrozenNode *pchildren = &self->nodes[root->children + root->num_children];
+          RParserNode *parser_node;
+          gint match_ofs = 0;
+          RParserMatch *match = NULL;
+
+          if (matches)
+            {
+              match_ofs = matches->len;
+
+              g_array_set_size(matches, match_ofs + 1);
+            }
+          for (j = 0; j < root->num_pchildren; j++)
+            {
+              if (key[i] < pchildren[j].first || key[i] > pchildren[j].last)
+                continue;
+
+              parser_node = pchildren[j].parser;
+              if (matches)
+                {
+                  match = &g_array_index(matches, RParserMatch, match_ofs);
+                  memset(match, 0, sizeof(*match));
+                }
+              if (parser_node->parse(key + i, &len, parser_node->param, parser_node->state, match))
+                {
+                  ret = r_find_frozen(self, &pchildren[j], whole_key, key + i + len, keylen - (i + len), matches);
+                  if (matches)
+                    {
+                      match = &g_array_index(matches, RParserMatch, match_ofs);
+
+                      if (ret)
+                        {
+                          if (!(match->match))
+                            {
+                              match->type = parser_node->type;
+                              match->ofs = match->ofs + (key + i) - whole_key;
+                              match->len = (gint16) match->len + len;
+                              match->handle = parser_node->handle;
+                            }
+                          break;
+                        }
+                      else if (match->match)
+                        {
+                          g_free(match->match);
+                          match->match = NULL;
+                        }
+                    }
+                  else if (ret)
+                    break;
+                }
+            }
+          if (!ret && matches)
+            g_array_set_size(matches, match_ofs);
+        }
+
+      if (ret)
+        return ret;
+      else if (root->value)
+        return root;
+    }
+
+  return NULL;
+}
+
+/**
+ * r_find_frozen_node:
+ *
+ * Looks up @key in a frozen tree, returns the matching node of the
+ * original tree, the same as r_find_node() would.
+ */
+RNode *
+r_find_frozen_node(RFrozenTree *self, guint8 *whole_key, guint8 *key, gint keylen, GArray *matches)
+{
+  RFrozenNode *ret;
+
+  ret = r_find_frozen(self, &self->nodes[0], whole_key, key, keylen, matches);
+  return ret ? ret->node : NULL;
+}
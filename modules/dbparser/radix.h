@@ -26,6 +26,7 @@
 
 #include "logmsg.h"
 #include "messages.h"
+#include "serialize.h"
 
 /* parser types, these are saved in the serialized log message along with
  * the match information thus they have to remain the same in order to keep
@@ -83,6 +84,11 @@ typedef struct _RParserNode
 
 typedef gchar *(*RNodeGetValueFunc) (gpointer value);
 
+/* map node values to and from indexes when serializing a tree, index 0
+ * stands for a NULL value */
+typedef guint32 (*RNodeValueIndexFunc) (gpointer value, gpointer user_data);
+typedef gpointer (*RNodeIndexValueFunc) (guint32 index, gpointer user_data);
+
 typedef struct _RNode RNode;
 
 struct _RNode
@@ -98,6 +104,41 @@ struct _RNode
   RNode **pchildren;
 };
 
+/* A read-only, compacted copy of a fully built RNode tree, used to speed up
+ * lookups.  Nodes are laid out breadth first in a single array, so the
+ * children of a node (literal ones first, then the parsers) occupy a
+ * contiguous range, literal prefixes live in a single string pool and
+ * nodes with many literal children get a first-byte dispatch table.  Each
+ * frozen node refers back to the RNode it was created from, the tree it
+ * was built from must not be modified or freed while it is in use. */
+typedef struct _RFrozenNode
+{
+  gint32 keylen;
+  guint32 key_ofs;
+  /* index of the first child, literal children come first */
+  guint32 children;
+  guint32 num_children;
+  guint32 num_pchildren;
+  /* index into the dispatch pool, -1 if the children are searched */
+  gint32 dispatch;
+  guint8 first;
+  guint8 last;
+  RParserNode *parser;
+  gpointer value;
+  RNode *node;
+} RFrozenNode;
+
+typedef struct _RFrozenTree
+{
+  RFrozenNode *nodes;
+  /* the first character of each node's key, indexed the same as nodes */
+  guint8 *first_chars;
+  guint8 *keys;
+  /* 256 entries per table, child index + 1 or 0 if there's no such child */
+  guint16 *dispatch;
+  guint num_nodes;
+} RFrozenTree;
+
 typedef struct _RDebugInfo
 {
   RNode *node;
@@ -151,5 +192,12 @@ void r_insert_node(RNode *root, guint8 *key, gpointer value, gboolean parser, RN
 RNode *r_find_node(RNode *root, guint8 *whole_key, guint8 *key, gint keylen, GArray *matches);
 RNode *r_find_node_dbg(RNode *root, guint8 *whole_key, guint8 *key, gint keylen, GArray *matches, GArray *dbg_list);
 
+gboolean r_serialize_tree(RNode *root, SerializeArchive *sa, RNodeValueIndexFunc value_index, gpointer user_data);
+RNode *r_deserialize_tree(SerializeArchive *sa, RNodeIndexValueFunc index_value, gpointer user_data, void (*free_fn)(gpointer data));
+
+RFrozenTree *r_freeze_tree(RNode *root);
+void r_free_frozen_tree(RFrozenTree *self);
+RNode *r_find_frozen_node(RFrozenTree *self, guint8 *whole_key, guint8 *key, gint keylen, GArray *matches);
+
 #endif
 
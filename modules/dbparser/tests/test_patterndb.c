@@ -33,7 +33,10 @@ do { \
 
 PatternDB *patterndb;
 gchar *filename;
+gchar *compiled_filename;
 GPtrArray *messages;
+/* load the pattern databases through their compiled form */
+gboolean use_compiled = FALSE;
 
 void
 test_emit_func(LogMessage *msg, gboolean synthetic, gpointer user_data)
@@ -41,6 +44,26 @@ test_emit_func(LogMessage *msg, gboolean synthetic, gpointer user_data)
   g_ptr_array_add(messages, log_msg_ref(msg));
 }
 
+void
+compile_pattern_db(void)
+{
+  PDBRuleSet *rule_set;
+
+  compiled_filename = g_strdup_printf("%s.compiled", filename);
+
+  rule_set = pdb_rule_set_new();
+  if (!pdb_rule_set_load(rule_set, configuration, filename, NULL) ||
+      !pdb_rule_set_save_compiled(rule_set, compiled_filename, filename))
+    test_fail("Error compiling pattern database\n");
+  pdb_rule_set_free(rule_set);
+
+  /* make sure that the compiled file is used and we don't fall back to the XML */
+  rule_set = pdb_rule_set_new();
+  if (!pdb_rule_set_load_compiled(rule_set, configuration, compiled_filename, filename))
+    test_fail("Error loading compiled pattern database\n");
+  pdb_rule_set_free(rule_set);
+}
+
 void
 create_pattern_db(gchar *pdb)
 {
@@ -52,7 +75,10 @@ create_pattern_db(gchar *pdb)
   g_file_open_tmp("patterndbXXXXXX.xml", &filename, NULL);
   g_file_set_contents(filename, pdb, strlen(pdb), NULL);
 
-  if (pattern_db_reload_ruleset(patterndb, configuration, filename))
+  if (use_compiled)
+    compile_pattern_db();
+
+  if (pattern_db_reload_compiled_ruleset(patterndb, configuration, filename, compiled_filename))
     {
       if (!g_str_equal(pattern_db_get_ruleset_version(patterndb), "3"))
         test_fail("Invalid version '%s'\n", pattern_db_get_ruleset_version(patterndb));
@@ -76,6 +102,13 @@ clean_pattern_db(void)
   g_unlink(filename);
   g_free(filename);
   filename = NULL;
+
+  if (compiled_filename)
+    {
+      g_unlink(compiled_filename);
+      g_free(compiled_filename);
+      compiled_filename = NULL;
+    }
 }
 
 /* pdb skeleton used to test patterndb rule actions. E.g. whenever a rule
@@ -213,7 +246,7 @@ test_rule_action_message_value(const gchar *pattern, gint timeout, gint ndx, con
 
   result = pattern_db_process(patterndb, PDB_INPUT_WRAP_MESSAGE(&input, msg));
   if (timeout)
-    timer_wheel_set_time(patterndb->timer_wheel, timer_wheel_get_time(patterndb->timer_wheel) + timeout + 1);
+    pattern_db_advance_time(patterndb, timeout + 1);
 
   if (ndx >= messages->len)
     {
@@ -248,7 +281,7 @@ test_rule_action_message_tag(const gchar *pattern, gint timeout, gint ndx, const
 
   result = pattern_db_process(patterndb, PDB_INPUT_WRAP_MESSAGE(&input, msg));
   if (timeout)
-    timer_wheel_set_time(patterndb->timer_wheel, timer_wheel_get_time(patterndb->timer_wheel) + timeout + 5);
+    pattern_db_advance_time(patterndb, timeout + 5);
   if (ndx >= messages->len)
     {
       test_fail("Expected the %d. message, but no such message was returned by patterndb\n", ndx);
@@ -719,6 +752,32 @@ test_patterndb_tags_outside_of_rule()
   clean_pattern_db();
 }
 
+void
+test_patterndb_compiled_out_of_date()
+{
+  PDBRuleSet *rule_set;
+
+  use_compiled = TRUE;
+  create_pattern_db(pdb_ruletest_skeleton);
+  use_compiled = FALSE;
+
+  /* the XML changes after compilation, it has to be loaded instead */
+  g_file_set_contents(filename, pdb_msg_count_skeleton, strlen(pdb_msg_count_skeleton), NULL);
+
+  rule_set = pdb_rule_set_new();
+  if (pdb_rule_set_load_compiled(rule_set, configuration, compiled_filename, filename))
+    test_fail("Out of date compiled pattern database was loaded\n");
+  pdb_rule_set_free(rule_set);
+
+  if (!pattern_db_reload_compiled_ruleset(patterndb, configuration, filename, compiled_filename))
+    test_fail("Falling back to the XML pattern database failed\n");
+
+  test_rule_value("pattern13", "n13-1", "v13-1");
+  test_rule_value("pattern11", "n11-1", NULL);
+
+  clean_pattern_db();
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -742,6 +801,15 @@ main(int argc, char *argv[])
   test_patterndb_context_length();
   test_patterndb_tags_outside_of_rule();
 
+  use_compiled = TRUE;
+  test_patterndb_rule();
+  test_patterndb_parsers();
+  test_patterndb_message_property_inheritance();
+  test_patterndb_context_length();
+  use_compiled = FALSE;
+
+  test_patterndb_compiled_out_of_date();
+
   app_shutdown();
   return  (fail ? 1 : 0);
 }
@@ -59,11 +59,68 @@ insert_node(RNode *root, gchar *key)
   g_free(dup);
 }
 
+/* checks that the frozen form of the tree returns the same node and matches */
+void
+test_frozen_search(RNode *root, gchar *key, RNode *expected, GArray *expected_matches)
+{
+  RFrozenTree *frozen = r_freeze_tree(root);
+  GArray *matches = NULL;
+  RNode *ret;
+  gint i;
+
+  if (expected_matches)
+    {
+      matches = g_array_new(FALSE, TRUE, sizeof(RParserMatch));
+      g_array_set_size(matches, 1);
+    }
+
+  ret = r_find_frozen_node(frozen, key, key, strlen(key), matches);
+  if (ret != expected)
+    {
+      printf("FAIL: frozen tree returned a different node: '%s'\n", key);
+      fail = TRUE;
+    }
+  else if (matches)
+    {
+      if (matches->len != expected_matches->len)
+        {
+          printf("FAIL: frozen tree returned a different number of matches: '%s' => %d <> %d\n", key, matches->len, expected_matches->len);
+          fail = TRUE;
+        }
+      else
+        {
+          for (i = 0; i < matches->len; i++)
+            {
+              RParserMatch *match = &g_array_index(matches, RParserMatch, i);
+              RParserMatch *expected_match = &g_array_index(expected_matches, RParserMatch, i);
+
+              if (match->handle != expected_match->handle || match->ofs != expected_match->ofs ||
+                  match->len != expected_match->len || !match->match != !expected_match->match ||
+                  (match->match && strcmp(match->match, expected_match->match) != 0))
+                {
+                  printf("FAIL: frozen tree returned a different match: '%s' => %d. match\n", key, i);
+                  fail = TRUE;
+                }
+            }
+        }
+    }
+
+  if (matches)
+    {
+      for (i = 0; i < matches->len; i++)
+        g_free(g_array_index(matches, RParserMatch, i).match);
+      g_array_free(matches, TRUE);
+    }
+  r_free_frozen_tree(frozen);
+}
+
 void
 test_search_value(RNode *root, gchar *key, gchar *expected_value)
 {
   RNode *ret = r_find_node(root, key, key, strlen(key), NULL);
 
+  test_frozen_search(root, key, ret, NULL);
+
   if (ret && expected_value)
     {
       if (strcmp(ret->value, expected_value) != 0)
@@ -108,6 +165,7 @@ test_search_matches(RNode *root, gchar *key, gchar *name1, ...)
   va_start(args, name1);
 
   ret = r_find_node(root, key, key, strlen(key), matches);
+  test_frozen_search(root, key, ret, matches);
   if (ret && !name1)
     {
       printf("FAIL: found unexpected: '%s' => '%s' matches: ", key, (gchar *) ret->value);
@@ -30,10 +30,14 @@
 #include "value-pairs.h"
 #include "vptransform.h"
 
+#include <string.h>
+
 typedef struct _TFJsonState
 {
   TFSimpleFuncState super;
   ValuePairs *vp;
+  /* expected length of the output, to preallocate the result buffer */
+  gsize size_hint;
 } TFJsonState;
 
 static gboolean
@@ -56,143 +60,212 @@ tf_json_prepare(LogTemplateFunction *self, gpointer s, LogTemplate *parent,
   return TRUE;
 }
 
-typedef struct
-{
-  gboolean need_comma;
-  GString *buffer;
-} json_state_t;
+/*
+ * JSON string escaping
+ *
+ * Most values and keys contain nothing that needs escaping, so the input
+ * is scanned a machine word at a time and the safe runs are copied to the
+ * output in one go, only the offending characters are dealt with one by
+ * one.
+ */
 
-static inline void
-g_string_append_escaped(GString *dest, const char *str)
+#define JSON_ONES   G_GUINT64_CONSTANT(0x0101010101010101)
+#define JSON_HIGHS  G_GUINT64_CONSTANT(0x8080808080808080)
+
+/* true if any of the bytes in the word is less than n (n <= 128) */
+#define JSON_HAS_LESS(w, n)   (((w) - JSON_ONES * (n)) & ~(w) & JSON_HIGHS)
+/* true if any of the bytes in the word equals c */
+#define JSON_HAS_BYTE(w, c)   JSON_HAS_LESS((w) ^ (JSON_ONES * (c)), 1)
+
+static inline gboolean
+tf_json_word_needs_escaping(const gchar *p)
 {
-  /* Assumes ASCII!  Keep in sync with the switch! */
-  static const unsigned char json_exceptions[UCHAR_MAX + 1] =
-    {
-      [0x01] = 1, [0x02] = 1, [0x03] = 1, [0x04] = 1, [0x05] = 1, [0x06] = 1,
-      [0x07] = 1, [0x08] = 1, [0x09] = 1, [0x0a] = 1, [0x0b] = 1, [0x0c] = 1,
-      [0x0d] = 1, [0x0e] = 1, [0x0f] = 1, [0x10] = 1, [0x11] = 1, [0x12] = 1,
-      [0x13] = 1, [0x14] = 1, [0x15] = 1, [0x16] = 1, [0x17] = 1, [0x18] = 1,
-      [0x19] = 1, [0x1a] = 1, [0x1b] = 1, [0x1c] = 1, [0x1d] = 1, [0x1e] = 1,
-      [0x1f] = 1, ['\\'] = 1, ['"'] = 1
-    };
+  guint64 w;
 
-  const unsigned char *p;
+  memcpy(&w, p, sizeof(w));
+  return (JSON_HAS_LESS(w, 0x20) | JSON_HAS_BYTE(w, '"') | JSON_HAS_BYTE(w, '\\')) != 0;
+}
+
+static inline gboolean
+tf_json_char_needs_escaping(guchar c)
+{
+  return c < 0x20 || c == '"' || c == '\\';
+}
 
-  p = (unsigned char *)str;
+static void
+tf_json_append_escaped_char(GString *dest, guchar c)
+{
+  static const char json_hex_chars[16] = "0123456789abcdef";
 
-  while (*p)
+  switch (c)
     {
-      if (json_exceptions[*p] == 0)
-        g_string_append_c(dest, *p);
-      else
-        {
-          /* Keep in sync with json_exceptions! */
-          switch (*p)
-            {
-            case '\b':
-              g_string_append(dest, "\\b");
-              break;
-            case '\n':
-              g_string_append(dest, "\\n");
-              break;
-            case '\r':
-              g_string_append(dest, "\\r");
-              break;
-            case '\t':
-              g_string_append(dest, "\\t");
-              break;
-            case '\\':
-              g_string_append(dest, "\\\\");
-              break;
-            case '"':
-              g_string_append(dest, "\\\"");
-              break;
-            default:
-              {
-                static const char json_hex_chars[16] = "0123456789abcdef";
-
-                g_string_append(dest, "\\u00");
-                g_string_append_c(dest, json_hex_chars[(*p) >> 4]);
-                g_string_append_c(dest, json_hex_chars[(*p) & 0xf]);
-                break;
-              }
-            }
-        }
-      p++;
+    case '\b':
+      g_string_append_len(dest, "\\b", 2);
+      break;
+    case '\n':
+      g_string_append_len(dest, "\\n", 2);
+      break;
+    case '\r':
+      g_string_append_len(dest, "\\r", 2);
+      break;
+    case '\t':
+      g_string_append_len(dest, "\\t", 2);
+      break;
+    case '\\':
+      g_string_append_len(dest, "\\\\", 2);
+      break;
+    case '"':
+      g_string_append_len(dest, "\\\"", 2);
+      break;
+    default:
+      g_string_append_len(dest, "\\u00", 4);
+      g_string_append_c(dest, json_hex_chars[c >> 4]);
+      g_string_append_c(dest, json_hex_chars[c & 0xf]);
+      break;
     }
 }
 
-static gboolean
-tf_json_obj_start(const gchar *name,
-                  const gchar *prefix, gpointer *prefix_data,
-                  const gchar *prev, gpointer *prev_data,
-                  gpointer user_data)
+static void
+tf_json_append_escaped(GString *dest, const gchar *str, gsize len)
 {
-  json_state_t *state = (json_state_t *)user_data;
+  const gchar *p = str, *end = str + len;
+  const gchar *run = str;
 
-  if (state->need_comma)
-    g_string_append_c(state->buffer, ',');
-
-  if (name)
+  while (p < end)
     {
-      g_string_append_c(state->buffer, '"');
-      g_string_append_escaped(state->buffer, name);
-      g_string_append(state->buffer, "\":{");
-    }
-  else
-    g_string_append_c(state->buffer, '{');
+      if (end - p >= sizeof(guint64) && !tf_json_word_needs_escaping(p))
+        {
+          p += sizeof(guint64);
+          continue;
+        }
 
-  state->need_comma = FALSE;
+      if (!tf_json_char_needs_escaping(*p))
+        {
+          p++;
+          continue;
+        }
 
-  return FALSE;
+      if (p > run)
+        g_string_append_len(dest, run, p - run);
+      tf_json_append_escaped_char(dest, *p);
+      p++;
+      run = p;
+    }
+  if (p > run)
+    g_string_append_len(dest, run, p - run);
 }
 
-static gboolean
-tf_json_obj_end(const gchar *name,
-                const gchar *prefix, gpointer *prefix_data,
-                const gchar *prev, gpointer *prev_data,
-                gpointer user_data)
+/*
+ * The serializer
+ *
+ * Value-pairs are iterated in the same (reverse) order as
+ * value_pairs_walk() would do, so names sharing a dotted prefix come one
+ * after the other.  Instead of splitting the names and maintaining a stack
+ * of the open objects, the previous name is kept around: the objects open
+ * at any time are the first "depth" components of that name.
+ */
+typedef struct
 {
-  json_state_t *state = (json_state_t *)user_data;
-
-  g_string_append_c(state->buffer, '}');
+  GString *buffer;
+  gboolean need_comma;
+  const gchar *prev_name;
+  gint depth;
+} TFJsonSerializer;
 
-  state->need_comma = TRUE;
+static inline void
+tf_json_append_key(TFJsonSerializer *serializer, const gchar *key, gsize key_len)
+{
+  if (serializer->need_comma)
+    g_string_append_c(serializer->buffer, ',');
 
-  return FALSE;
+  g_string_append_c(serializer->buffer, '"');
+  tf_json_append_escaped(serializer->buffer, key, key_len);
+  g_string_append_len(serializer->buffer, "\":", 2);
 }
 
 static gboolean
-tf_json_value(const gchar *name, const gchar *prefix, const gchar *value,
-              gpointer *prefix_data, gpointer user_data)
+tf_json_serialize_value(const gchar *name, const gchar *value, gpointer user_data)
 {
-  json_state_t *state = (json_state_t *)user_data;
+  TFJsonSerializer *serializer = (TFJsonSerializer *) user_data;
+  const gchar *component, *dot;
+  gint matched = 0;
+
+  /* find how many of the open objects are shared with the previous name */
+  component = name;
+  if (serializer->prev_name)
+    {
+      const gchar *prev = serializer->prev_name;
 
-  if (state->need_comma)
-    g_string_append_c(state->buffer, ',');
+      while (matched < serializer->depth)
+        {
+          dot = strchr(component, '.');
+          if (!dot || strncmp(component, prev, dot - component + 1) != 0)
+            break;
+          prev += dot - component + 1;
+          component = dot + 1;
+          matched++;
+        }
+    }
+
+  for (; serializer->depth > matched; serializer->depth--)
+    {
+      g_string_append_c(serializer->buffer, '}');
+      serializer->need_comma = TRUE;
+    }
 
-  g_string_append_c(state->buffer, '"');
-  g_string_append_escaped(state->buffer, name);
-  g_string_append(state->buffer, "\":\"");
-  g_string_append_escaped(state->buffer, value);
-  g_string_append_c(state->buffer, '"');
+  /* open the new objects, the last component is the key of the value */
+  while ((dot = strchr(component, '.')) != NULL)
+    {
+      tf_json_append_key(serializer, component, dot - component);
+      g_string_append_c(serializer->buffer, '{');
+      serializer->need_comma = FALSE;
+      serializer->depth++;
+      component = dot + 1;
+    }
 
-  state->need_comma = TRUE;
+  tf_json_append_key(serializer, component, strlen(component));
+  g_string_append_c(serializer->buffer, '"');
+  tf_json_append_escaped(serializer->buffer, value, strlen(value));
+  g_string_append_c(serializer->buffer, '"');
+  serializer->need_comma = TRUE;
+  serializer->prev_name = name;
 
   return FALSE;
 }
 
+static gint
+tf_json_name_cmp(const gchar *s1, const gchar *s2)
+{
+  return strcmp(s2, s1);
+}
+
 static void
-tf_json_append(GString *result, ValuePairs *vp, LogMessage *msg)
+tf_json_append(GString *result, TFJsonState *state, LogMessage *msg)
 {
-  json_state_t state;
+  TFJsonSerializer serializer;
+  gsize start_len = result->len;
+
+  /* make room for the expected output in one step, based on the earlier
+   * invocations */
+  if (result->allocated_len <= start_len + state->size_hint)
+    {
+      g_string_set_size(result, start_len + state->size_hint);
+      g_string_truncate(result, start_len);
+    }
+
+  serializer.buffer = result;
+  serializer.need_comma = FALSE;
+  serializer.prev_name = NULL;
+  serializer.depth = 0;
 
-  state.need_comma = FALSE;
-  state.buffer = result;
+  g_string_append_c(result, '{');
+  value_pairs_foreach_sorted(state->vp, tf_json_serialize_value,
+                             (GCompareDataFunc) tf_json_name_cmp, msg, 0, &serializer);
+  for (; serializer.depth > 0; serializer.depth--)
+    g_string_append_c(result, '}');
+  g_string_append_c(result, '}');
 
-  value_pairs_walk(vp,
-                   tf_json_obj_start, tf_json_value, tf_json_obj_end,
-                   msg, 0, &state);
+  log_template_update_size_hint(&state->size_hint, result->len - start_len);
 }
 
 static void
@@ -203,7 +276,7 @@ tf_json_call(LogTemplateFunction *self, gpointer s,
   gint i;
 
   for (i = 0; i < args->num_messages; i++)
-    tf_json_append(result, state->vp, args->messages[i]);
+    tf_json_append(result, state, args->messages[i]);
 }
 
 static void
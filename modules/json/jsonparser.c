@@ -22,12 +22,13 @@
 
 #include "jsonparser.h"
 #include "scratch-buffers.h"
+#include "misc.h"
 
 #include <string.h>
 #include <ctype.h>
 
-#include <json.h>
-#include <json_object_private.h>
+/* the maximum nesting of objects and arrays, deeper documents are refused */
+#define JSON_PARSER_MAX_DEPTH 64
 
 struct _LogJSONParser
 {
@@ -35,6 +36,7 @@ struct _LogJSONParser
   gchar *prefix;
   gchar *marker;
   gint marker_len;
+  GList *keys;
 };
 
 void
@@ -56,108 +58,474 @@ log_json_parser_set_marker (LogParser *p, const gchar *marker)
   self->marker_len = strlen(marker);
 }
 
-static void
-log_json_parser_process_object (struct json_object *jso,
-                                const gchar *prefix,
-                                LogMessage *msg);
+/* NOTE: consumes keys */
+void
+log_json_parser_set_keys (LogParser *p, GList *keys)
+{
+  LogJSONParser *self = (LogJSONParser *)p;
+
+  string_list_free (self->keys);
+  self->keys = keys;
+}
+
+/*
+ * The JSON document is tokenized in a single pass and the name-value
+ * pairs are stored into the LogMessage as soon as they are encountered,
+ * without building a tree of the document first.
+ *
+ * Values that appear in the input as-is (strings without escapes, numbers
+ * and booleans) are stored as indirect references into the value we are
+ * parsing, provided that it is $MESSAGE and not the output of a template.
+ */
+
+enum
+{
+  /* extract every value in the subtree */
+  JSON_EXTRACT_ALL,
+  /* only some of the keys below this one were requested */
+  JSON_EXTRACT_SOME,
+  /* skip the subtree */
+  JSON_EXTRACT_NONE,
+};
+
+typedef struct
+{
+  LogJSONParser *parser;
+  LogMessage *msg;
+
+  const gchar *input;
+  const gchar *pos;
+  const gchar *end;
+  /* the value being parsed is stored in this handle, or LM_V_NONE */
+  NVHandle ref_handle;
+
+  /* prefix + the name of the current value */
+  GString *key;
+  gsize path_ofs;
+  /* unescaped strings */
+  GString *value;
+
+  /* a new value for ref_handle is only stored at the end, as storing it
+   * right away would invalidate the references into it */
+  GString *ref_value;
+  gboolean ref_value_set;
+
+  const gchar *error;
+} LogJSONParserState;
+
+static gboolean log_json_parser_parse_value (LogJSONParserState *state, gint extract, gint depth);
+
+static inline void
+log_json_parser_skip_whitespace (LogJSONParserState *state)
+{
+  while (state->pos < state->end &&
+         (*state->pos == ' ' || *state->pos == '\t' || *state->pos == '\n' || *state->pos == '\r'))
+    state->pos++;
+}
+
+static inline gboolean
+log_json_parser_expect (LogJSONParserState *state, gchar c, const gchar *error)
+{
+  log_json_parser_skip_whitespace (state);
+  if (state->pos >= state->end || *state->pos != c)
+    {
+      state->error = error;
+      return FALSE;
+    }
+  state->pos++;
+  return TRUE;
+}
+
+static gint
+log_json_parser_key_extract (LogJSONParserState *state)
+{
+  const gchar *path = state->key->str + state->path_ofs;
+  gsize path_len = state->key->len - state->path_ofs;
+  gint extract = JSON_EXTRACT_NONE;
+  GList *l;
+
+  for (l = state->parser->keys; l; l = l->next)
+    {
+      const gchar *k = (const gchar *) l->data;
+      gsize k_len = strlen (k);
+
+      if (path_len >= k_len && strncmp (path, k, k_len) == 0 &&
+          (path_len == k_len || path[k_len] == '.' || path[k_len] == '['))
+        return JSON_EXTRACT_ALL;
+
+      if (k_len > path_len && strncmp (path, k, path_len) == 0 &&
+          (k[path_len] == '.' || k[path_len] == '['))
+        extract = JSON_EXTRACT_SOME;
+    }
+  return extract;
+}
 
 static void
-log_json_parser_process_single (struct json_object *jso,
-                                const gchar *prefix,
-                                const gchar *obj_key,
-                                LogMessage *msg)
+log_json_parser_store_value (LogJSONParserState *state, const gchar *value, gsize value_len, gboolean in_input)
 {
-  ScratchBuffer *key, *value;
-  gboolean parsed = FALSE;
+  NVHandle handle;
+  gsize ofs;
 
-  key = scratch_buffer_acquire ();
-  value = scratch_buffer_acquire ();
+  handle = log_msg_get_value_handle (state->key->str);
+  if (handle == state->ref_handle && handle != LM_V_NONE)
+    {
+      g_string_truncate (state->ref_value, 0);
+      g_string_append_len (state->ref_value, value, value_len);
+      state->ref_value_set = TRUE;
+      return;
+    }
+
+  ofs = value - state->input;
+  if (in_input && state->ref_handle != LM_V_NONE &&
+      log_msg_is_handle_settable_with_an_indirect_value (handle) &&
+      ofs <= G_MAXUINT16 && value_len <= G_MAXUINT16)
+    log_msg_set_value_indirect (state->msg, handle, state->ref_handle, 0, ofs, value_len);
+  else
+    log_msg_set_value (state->msg, handle, value, value_len);
+}
 
-  switch (json_object_get_type (jso))
-    {
-    case json_type_boolean:
-      parsed = TRUE;
-      if (json_object_get_boolean (jso))
-        g_string_assign (sb_string (value), "true");
-      else
-        g_string_assign (sb_string (value), "false");
-      break;
-    case json_type_double:
-      parsed = TRUE;
-      g_string_printf (sb_string (value), "%f",
-                       json_object_get_double (jso));
-      break;
-    case json_type_int:
-      parsed = TRUE;
-      g_string_printf (sb_string (value), "%i",
-                       json_object_get_int (jso));
-      break;
-    case json_type_string:
-      parsed = TRUE;
-      g_string_assign (sb_string (value),
-                       json_object_get_string (jso));
-      break;
-    case json_type_object:
-      if (prefix)
-        g_string_assign (sb_string (key), prefix);
-      g_string_append (sb_string (key), obj_key);
-      g_string_append_c (sb_string (key), '.');
-      log_json_parser_process_object (jso, sb_string (key)->str, msg);
-      break;
-    case json_type_array:
-      {
-        gint i, plen;
-
-        g_string_assign (sb_string (key), obj_key);
-
-        plen = sb_string (key)->len;
-
-        for (i = 0; i < json_object_array_length (jso); i++)
-          {
-            g_string_truncate (sb_string (key), plen);
-            g_string_append_printf (sb_string (key), "[%d]", i);
-            log_json_parser_process_single (json_object_array_get_idx (jso, i),
-                                            prefix,
-                                            sb_string (key)->str, msg);
-          }
+static gboolean
+log_json_parser_parse_hex4 (LogJSONParserState *state, gunichar *result)
+{
+  gint i;
+
+  if (state->end - state->pos < 4)
+    return FALSE;
+
+  *result = 0;
+  for (i = 0; i < 4; i++)
+    {
+      gint digit = g_ascii_xdigit_value (state->pos[i]);
+
+      if (digit < 0)
+        return FALSE;
+      *result = (*result << 4) | digit;
+    }
+  state->pos += 4;
+  return TRUE;
+}
+
+/*
+ * Parses a string literal, the position is right after the opening
+ * quote. If the string contains no escapes, it is returned as a pointer
+ * into the input (*unescaped is set to FALSE), otherwise it is unescaped
+ * into state->value.
+ */
+static gboolean
+log_json_parser_parse_string (LogJSONParserState *state, const gchar **str, gsize *str_len, gboolean *unescaped)
+{
+  const gchar *start = state->pos;
+  GString *value = state->value;
+
+  while (state->pos < state->end && *state->pos != '"' && *state->pos != '\\')
+    state->pos++;
+
+  if (state->pos < state->end && *state->pos == '"')
+    {
+      *str = start;
+      *str_len = state->pos - start;
+      *unescaped = FALSE;
+      state->pos++;
+      return TRUE;
+    }
+
+  g_string_truncate (value, 0);
+  g_string_append_len (value, start, state->pos - start);
+  while (state->pos < state->end && *state->pos != '"')
+    {
+      const gchar *run = state->pos;
+      gunichar uc, low;
+      gchar utf8[6];
+
+      while (state->pos < state->end && *state->pos != '"' && *state->pos != '\\')
+        state->pos++;
+      g_string_append_len (value, run, state->pos - run);
+
+      if (state->pos >= state->end || *state->pos == '"')
         break;
-      }
-    default:
-      msg_error ("JSON parser encountered an unknown type, skipping",
-                 evt_tag_str ("key", obj_key), NULL);
-      break;
+
+      /* backslash */
+      state->pos++;
+      if (state->pos >= state->end)
+        break;
+
+      switch (*state->pos++)
+        {
+        case '"':
+          g_string_append_c (value, '"');
+          break;
+        case '\\':
+          g_string_append_c (value, '\\');
+          break;
+        case '/':
+          g_string_append_c (value, '/');
+          break;
+        case 'b':
+          g_string_append_c (value, '\b');
+          break;
+        case 'f':
+          g_string_append_c (value, '\f');
+          break;
+        case 'n':
+          g_string_append_c (value, '\n');
+          break;
+        case 'r':
+          g_string_append_c (value, '\r');
+          break;
+        case 't':
+          g_string_append_c (value, '\t');
+          break;
+        case 'u':
+          if (!log_json_parser_parse_hex4 (state, &uc))
+            {
+              state->error = "invalid \\u escape";
+              return FALSE;
+            }
+          if (uc >= 0xd800 && uc < 0xdc00)
+            {
+              /* high surrogate, combine it with the low one that follows */
+              if (state->end - state->pos >= 6 && state->pos[0] == '\\' && state->pos[1] == 'u')
+                {
+                  state->pos += 2;
+                  if (!log_json_parser_parse_hex4 (state, &low))
+                    {
+                      state->error = "invalid \\u escape";
+                      return FALSE;
+                    }
+                  if (low >= 0xdc00 && low < 0xe000)
+                    uc = 0x10000 + ((uc - 0xd800) << 10) + (low - 0xdc00);
+                  else
+                    uc = 0xfffd;
+                }
+              else
+                uc = 0xfffd;
+            }
+          else if (uc >= 0xdc00 && uc < 0xe000)
+            uc = 0xfffd;
+          g_string_append_len (value, utf8, g_unichar_to_utf8 (uc, utf8));
+          break;
+        default:
+          state->error = "invalid escape sequence in string";
+          return FALSE;
+        }
+    }
+
+  if (state->pos >= state->end)
+    {
+      state->error = "unterminated string";
+      return FALSE;
+    }
+  state->pos++;
+
+  *str = value->str;
+  *str_len = value->len;
+  *unescaped = TRUE;
+  return TRUE;
+}
+
+static gboolean
+log_json_parser_parse_number (LogJSONParserState *state, gint extract)
+{
+  const gchar *start = state->pos;
+  const gchar *digits;
+
+  if (state->pos < state->end && *state->pos == '-')
+    state->pos++;
+
+  digits = state->pos;
+  while (state->pos < state->end && g_ascii_isdigit (*state->pos))
+    state->pos++;
+  if (state->pos == digits)
+    {
+      state->error = "invalid value";
+      return FALSE;
     }
 
-  if (parsed)
+  if (state->pos < state->end && *state->pos == '.')
     {
-      if (prefix)
+      state->pos++;
+      digits = state->pos;
+      while (state->pos < state->end && g_ascii_isdigit (*state->pos))
+        state->pos++;
+      if (state->pos == digits)
         {
-          g_string_assign (sb_string (key), prefix);
-          g_string_append (sb_string (key), obj_key);
-          log_msg_set_value (msg,
-                             log_msg_get_value_handle (sb_string (key)->str),
-                             sb_string (value)->str, sb_string (value)->len);
+          state->error = "invalid number";
+          return FALSE;
         }
-      else
-        log_msg_set_value (msg,
-                           log_msg_get_value_handle (obj_key),
-                           sb_string (value)->str, sb_string (value)->len);
     }
 
-  scratch_buffer_release (key);
-  scratch_buffer_release (value);
+  if (state->pos < state->end && (*state->pos == 'e' || *state->pos == 'E'))
+    {
+      state->pos++;
+      if (state->pos < state->end && (*state->pos == '+' || *state->pos == '-'))
+        state->pos++;
+      digits = state->pos;
+      while (state->pos < state->end && g_ascii_isdigit (*state->pos))
+        state->pos++;
+      if (state->pos == digits)
+        {
+          state->error = "invalid number";
+          return FALSE;
+        }
+    }
+
+  if (extract == JSON_EXTRACT_ALL)
+    log_json_parser_store_value (state, start, state->pos - start, TRUE);
+  return TRUE;
 }
 
-static void
-log_json_parser_process_object (struct json_object *jso,
-                                const gchar *prefix,
-                                LogMessage *msg)
+static gboolean
+log_json_parser_parse_literal (LogJSONParserState *state, const gchar *literal, gint extract)
 {
-  struct json_object_iter itr;
+  gsize len = strlen (literal);
+
+  if (state->end - state->pos < len || strncmp (state->pos, literal, len) != 0)
+    {
+      state->error = "invalid value";
+      return FALSE;
+    }
+
+  /* null values are not stored */
+  if (extract == JSON_EXTRACT_ALL && literal[0] != 'n')
+    log_json_parser_store_value (state, state->pos, len, TRUE);
+  state->pos += len;
+  return TRUE;
+}
+
+static gboolean
+log_json_parser_parse_object (LogJSONParserState *state, gint extract, gint depth)
+{
+  gsize key_len = state->key->len;
+
+  if (depth > JSON_PARSER_MAX_DEPTH)
+    {
+      state->error = "nesting too deep";
+      return FALSE;
+    }
+
+  log_json_parser_skip_whitespace (state);
+  if (state->pos < state->end && *state->pos == '}')
+    {
+      state->pos++;
+      return TRUE;
+    }
 
-  json_object_object_foreachC (jso, itr)
+  while (1)
     {
-      log_json_parser_process_single (itr.val, prefix, itr.key, msg);
+      const gchar *name;
+      gsize name_len;
+      gboolean unescaped;
+      gint member_extract = extract;
+
+      if (!log_json_parser_expect (state, '"', "object member name expected"))
+        return FALSE;
+      if (!log_json_parser_parse_string (state, &name, &name_len, &unescaped))
+        return FALSE;
+
+      g_string_append_len (state->key, name, name_len);
+      if (extract == JSON_EXTRACT_SOME)
+        member_extract = log_json_parser_key_extract (state);
+
+      if (!log_json_parser_expect (state, ':', "':' expected after object member name") ||
+          !log_json_parser_parse_value (state, member_extract, depth))
+        return FALSE;
+      g_string_truncate (state->key, key_len);
+
+      log_json_parser_skip_whitespace (state);
+      if (state->pos < state->end && *state->pos == ',')
+        {
+          state->pos++;
+          log_json_parser_skip_whitespace (state);
+          continue;
+        }
+      return log_json_parser_expect (state, '}', "',' or '}' expected in object");
+    }
+}
+
+static gboolean
+log_json_parser_parse_array (LogJSONParserState *state, gint extract, gint depth)
+{
+  gsize key_len = state->key->len;
+  gint i;
+
+  if (depth > JSON_PARSER_MAX_DEPTH)
+    {
+      state->error = "nesting too deep";
+      return FALSE;
+    }
+
+  log_json_parser_skip_whitespace (state);
+  if (state->pos < state->end && *state->pos == ']')
+    {
+      state->pos++;
+      return TRUE;
+    }
+
+  for (i = 0; ; i++)
+    {
+      gint element_extract = extract;
+
+      if (extract != JSON_EXTRACT_NONE)
+        {
+          g_string_append_printf (state->key, "[%d]", i);
+          if (extract == JSON_EXTRACT_SOME)
+            element_extract = log_json_parser_key_extract (state);
+        }
+
+      if (!log_json_parser_parse_value (state, element_extract, depth))
+        return FALSE;
+      g_string_truncate (state->key, key_len);
+
+      log_json_parser_skip_whitespace (state);
+      if (state->pos < state->end && *state->pos == ',')
+        {
+          state->pos++;
+          continue;
+        }
+      return log_json_parser_expect (state, ']', "',' or ']' expected in array");
+    }
+}
+
+static gboolean
+log_json_parser_parse_value (LogJSONParserState *state, gint extract, gint depth)
+{
+  const gchar *str;
+  gsize str_len;
+  gboolean unescaped;
+
+  log_json_parser_skip_whitespace (state);
+  if (state->pos >= state->end)
+    {
+      state->error = "unexpected end of input";
+      return FALSE;
+    }
+
+  switch (*state->pos)
+    {
+    case '{':
+      state->pos++;
+      /* members of nested objects are named as prefix + "key.member" */
+      if (extract != JSON_EXTRACT_NONE)
+        g_string_append_c (state->key, '.');
+      return log_json_parser_parse_object (state, extract, depth + 1);
+    case '[':
+      state->pos++;
+      return log_json_parser_parse_array (state, extract, depth + 1);
+    case '"':
+      state->pos++;
+      if (!log_json_parser_parse_string (state, &str, &str_len, &unescaped))
+        return FALSE;
+      if (extract == JSON_EXTRACT_ALL)
+        log_json_parser_store_value (state, str, str_len, !unescaped);
+      return TRUE;
+    case 't':
+      return log_json_parser_parse_literal (state, "true", extract);
+    case 'f':
+      return log_json_parser_parse_literal (state, "false", extract);
+    case 'n':
+      return log_json_parser_parse_literal (state, "null", extract);
+    default:
+      return log_json_parser_parse_number (state, extract);
     }
 }
 
@@ -165,8 +533,12 @@ static gboolean
 log_json_parser_process (LogParser *s, LogMessage **pmsg, const LogPathOptions *path_options, const gchar *input, gsize input_len)
 {
   LogJSONParser *self = (LogJSONParser *) s;
-  struct json_object *jso;
-  struct json_tokener *tok;
+  LogJSONParserState state;
+  ScratchBuffer *key, *value, *ref_value;
+  gboolean success;
+
+  state.input = input;
+  state.end = input + input_len;
 
   if (self->marker)
     {
@@ -178,29 +550,53 @@ log_json_parser_process (LogParser *s, LogMessage **pmsg, const LogPathOptions *
         input++;
     }
 
-  tok = json_tokener_new ();
-  jso = json_tokener_parse_ex (tok, input, input_len);
-  if (tok->err != json_tokener_success)
+  state.pos = input;
+  if (!log_json_parser_expect (&state, '{', "JSON object expected"))
     {
       msg_error ("Unparsable JSON stream encountered",
-                 evt_tag_str ("error", json_tokener_errors[tok->err]), NULL);
-      json_tokener_free (tok);
-      return FALSE;
-    }
-  json_tokener_free (tok);
-
-  if (!jso)
-    {
-      msg_error ("Unparsable JSON stream encountered", NULL);
+                 evt_tag_str ("error", state.error), NULL);
       return FALSE;
     }
 
   log_msg_make_writable(pmsg, path_options);
-  log_json_parser_process_object (jso, self->prefix, *pmsg);
 
-  json_object_put (jso);
+  key = scratch_buffer_acquire ();
+  value = scratch_buffer_acquire ();
+  ref_value = scratch_buffer_acquire ();
+
+  state.parser = self;
+  state.msg = *pmsg;
+  /* without a template, we are parsing $MESSAGE */
+  state.ref_handle = self->super.template ? LM_V_NONE : LM_V_MESSAGE;
+  state.key = sb_string (key);
+  state.value = sb_string (value);
+  state.ref_value = sb_string (ref_value);
+  state.ref_value_set = FALSE;
+  state.error = NULL;
+
+  g_string_truncate (state.key, 0);
+  if (self->prefix)
+    g_string_append (state.key, self->prefix);
+  state.path_ofs = state.key->len;
+
+  success = log_json_parser_parse_object (&state, self->keys ? JSON_EXTRACT_SOME : JSON_EXTRACT_ALL, 1);
+  if (success)
+    {
+      if (state.ref_value_set)
+        log_msg_set_value (*pmsg, state.ref_handle, state.ref_value->str, state.ref_value->len);
+    }
+  else
+    {
+      msg_error ("Unparsable JSON stream encountered",
+                 evt_tag_str ("error", state.error),
+                 evt_tag_int ("offset", state.pos - state.input),
+                 NULL);
+    }
 
-  return TRUE;
+  scratch_buffer_release (ref_value);
+  scratch_buffer_release (value);
+  scratch_buffer_release (key);
+  return success;
 }
 
 static LogPipe *
@@ -208,10 +604,13 @@ log_json_parser_clone (LogPipe *s)
 {
   LogJSONParser *self = (LogJSONParser *) s;
   LogJSONParser *cloned;
+  GList *l;
 
   cloned = (LogJSONParser *) log_json_parser_new ();
   log_json_parser_set_prefix ((LogParser *)cloned, self->prefix);
   log_json_parser_set_marker ((LogParser *)cloned, self->marker);
+  for (l = self->keys; l; l = l->next)
+    cloned->keys = g_list_append (cloned->keys, g_strdup (l->data));
 
   return &cloned->super.super;
 }
@@ -223,6 +622,7 @@ log_json_parser_free (LogPipe *s)
 
   g_free (self->prefix);
   g_free (self->marker);
+  string_list_free (self->keys);
   log_parser_free_method (s);
 }
 
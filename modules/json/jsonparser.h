@@ -29,6 +29,7 @@ typedef struct _LogJSONParser LogJSONParser;
 
 void log_json_parser_set_prefix(LogParser *p, const gchar *prefix);
 void log_json_parser_set_marker(LogParser *p, const gchar *marker);
+void log_json_parser_set_keys(LogParser *p, GList *keys);
 LogJSONParser *log_json_parser_new(void);
 
 #endif
@@ -1,6 +1,11 @@
 #include "template_lib.h"
+#include "testutils.h"
 #include "apphook.h"
 #include "plugin.h"
+#include "jsonparser.h"
+#include "misc.h"
+
+#include <string.h>
 
 void
 test_format_json(void)
@@ -14,6 +19,29 @@ test_format_json(void)
   assert_template_format("$(format-json kernel.SUBSYSTEM=pci kernel.DEVICE.type=pci kernel.DEVICE.name=0000:02:00.0 MSGID=801 MESSAGE=test)",
                          "{\"kernel\":{\"SUBSYSTEM\":\"pci\",\"DEVICE\":{\"type\":\"pci\",\"name\":\"0000:02:00.0\"}},\"MSGID\":\"801\",\"MESSAGE\":\"test\"}");
   assert_template_format("$(format-json .foo=bar)", "{\"_foo\":\"bar\"}");
+  assert_template_format("$(format-json a.b=1 a.c.d=2 a.c.e=3 b.c=4 c=5)",
+                         "{\"c\":\"5\",\"b\":{\"c\":\"4\"},\"a\":{\"c\":{\"e\":\"3\",\"d\":\"2\"},\"b\":\"1\"}}");
+}
+
+void
+test_format_json_escaping(void)
+{
+  /* NOTE: backslashes are unescaped both when splitting the arguments and
+   * when compiling the value template */
+  assert_template_format("$(format-json k=a\\\"b)", "{\"k\":\"a\\\"b\"}");
+  assert_template_format("$(format-json k=a\\\\\\\\b)", "{\"k\":\"a\\\\b\"}");
+  assert_template_format("$(format-json k=a\nb\bc\rd)", "{\"k\":\"a\\nb\\bc\\rd\"}");
+  assert_template_format("$(format-json k=a\x01" "b\x1f" "c)", "{\"k\":\"a\\u0001b\\u001fc\"}");
+
+  /* escaped characters at the word boundaries of the escaper */
+  assert_template_format("$(format-json k=\\\"abcdef\\\\\\\\\x01" "ghijkl\nmn)",
+                         "{\"k\":\"\\\"abcdef\\\\\\u0001ghijkl\\nmn\"}");
+  assert_template_format("$(format-json k=abcdefgh\x02" "jklmnopqr)", "{\"k\":\"abcdefgh\\u0002jklmnopqr\"}");
+  assert_template_format("$(format-json k=abcdefghijklmno\\\"pq)", "{\"k\":\"abcdefghijklmno\\\"pq\"}");
+
+  /* bytes above 0x7f are copied as they are */
+  assert_template_format("$(format-json k=\x80\x9f\xa0\xa2\xdc\xff" "abcdefgh\xc3\xa1)",
+                         "{\"k\":\"\x80\x9f\xa0\xa2\xdc\xff" "abcdefgh\xc3\xa1\"}");
 }
 
 void
@@ -23,6 +51,79 @@ test_format_json_rekey(void)
                          "{\"_msg\":{\"text\":\"dotted\"}}");
 }
 
+static LogMessage *
+parse_json_into_log_message(const gchar *json, const gchar *prefix, const gchar *keys[], gboolean expected_success)
+{
+  LogParser *p;
+  LogMessage *msg;
+  LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
+  NVTable *nvtable;
+  gboolean success;
+
+  p = (LogParser *) log_json_parser_new();
+  if (prefix)
+    log_json_parser_set_prefix(p, prefix);
+  if (keys)
+    log_json_parser_set_keys(p, string_array_to_list(keys));
+
+  msg = log_msg_new_empty();
+  log_msg_set_value(msg, LM_V_MESSAGE, json, -1);
+
+  nvtable = nv_table_ref(msg->payload);
+  success = log_parser_process(p, &msg, &path_options, log_msg_get_value(msg, LM_V_MESSAGE, NULL), -1);
+  nv_table_unref(nvtable);
+  assert_gboolean(success, expected_success, "Unexpected json-parser() result; json=%s", json);
+
+  log_pipe_unref(&p->super);
+  return msg;
+}
+
+static void
+assert_json_value(LogMessage *msg, const gchar *name, const gchar *expected_value)
+{
+  const gchar *value = log_msg_get_value(msg, log_msg_get_value_handle(name), NULL);
+
+  assert_string(value, expected_value, "json-parser() value mismatch; name=%s", name);
+}
+
+void
+test_json_parser(void)
+{
+  LogMessage *msg;
+  const gchar *keys[] = { "user", "request.headers.host", NULL };
+
+  msg = parse_json_into_log_message("{\"msg\": \"hello\", \"num\": -1.5e3, \"ok\": true, \"none\": null,"
+                                    " \"esc\": \"a\\\"b\\u00e1\", \"obj\": {\"arr\": [1, [2, 3], {\"k\": \"v\"}]}}",
+                                    NULL, NULL, TRUE);
+  assert_json_value(msg, "msg", "hello");
+  assert_json_value(msg, "num", "-1.5e3");
+  assert_json_value(msg, "ok", "true");
+  assert_json_value(msg, "none", "");
+  assert_json_value(msg, "esc", "a\"b\xc3\xa1");
+  assert_json_value(msg, "obj.arr[0]", "1");
+  assert_json_value(msg, "obj.arr[1][1]", "3");
+  assert_json_value(msg, "obj.arr[2].k", "v");
+  log_msg_unref(msg);
+
+  /* the referenced values must survive $MESSAGE being overwritten */
+  msg = parse_json_into_log_message("{\"foo\": \"bar\", \"MESSAGE\": \"replaced\"}", NULL, NULL, TRUE);
+  assert_json_value(msg, "foo", "bar");
+  assert_json_value(msg, "MESSAGE", "replaced");
+  log_msg_unref(msg);
+
+  msg = parse_json_into_log_message("{\"user\": {\"name\": \"joe\"}, \"request\": {\"headers\": {\"host\": \"h\", \"agent\": \"a\"}, \"path\": \"/\"}}",
+                                    ".json.", keys, TRUE);
+  assert_json_value(msg, ".json.user.name", "joe");
+  assert_json_value(msg, ".json.request.headers.host", "h");
+  assert_json_value(msg, ".json.request.headers.agent", "");
+  assert_json_value(msg, ".json.request.path", "");
+  log_msg_unref(msg);
+
+  log_msg_unref(parse_json_into_log_message("{\"foo\": }", NULL, NULL, FALSE));
+  log_msg_unref(parse_json_into_log_message("[1, 2]", NULL, NULL, FALSE));
+  log_msg_unref(parse_json_into_log_message("{\"foo\": \"unterminated}", NULL, NULL, FALSE));
+}
+
 int
 main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
 {
@@ -33,7 +134,9 @@ main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
   plugin_load_module("json-plugin", configuration, NULL);
 
   test_format_json();
+  test_format_json_escaping();
   test_format_json_rekey();
+  test_json_parser();
 
   deinit_template_tests();
   app_shutdown();
@@ -64,6 +64,26 @@ def stop_syslogng():
     print_user("syslog-ng exited with a non-zero value")
     return False
 
+def reload_syslogng(conf, settle_time=3):
+    global syslogng_pid
+
+    if not logstore_store_supported:
+        conf = re.sub('logstore\(.*\);', '', conf)
+
+    f = open('test.conf', 'w')
+    f.write(conf)
+    f.close()
+
+    try:
+        print_user("Reloading syslog-ng configuration (pid: %d)" % syslogng_pid)
+        os.kill(syslogng_pid, signal.SIGHUP)
+    except OSError:
+        print_user("Error sending HUP signal to syslog-ng")
+        raise
+    time.sleep(settle_time)
+    messagegen.need_to_flush = False
+    return True
+
 def flush_files(settle_time=3):
     global syslogng_pid
 
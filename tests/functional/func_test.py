@@ -18,11 +18,12 @@ def init_env():
         except OSError:
             pass
         os.mkfifo(pipe)
-    try:
-        os.mkdir("wildcard")
-    except OSError, e:
-        if e.errno != errno.EEXIST:
-            raise
+    for dir in ('wildcard', 'wildcard-restart'):
+        try:
+            os.mkdir(dir)
+        except OSError, e:
+            if e.errno != errno.EEXIST:
+                raise
 
 
 def seed_rnd():
@@ -63,8 +64,10 @@ import test_filters
 import test_input_drivers
 import test_performance
 import test_sql
+import test_redis
+import test_reuseport
 
-tests = (test_input_drivers, test_sql, test_file_source, test_filters, test_performance)
+tests = (test_input_drivers, test_sql, test_redis, test_file_source, test_filters, test_reuseport, test_performance)
 
 init_env()
 seed_rnd()
@@ -81,27 +84,32 @@ try:
             continue
 
 
-        contents = dir(test_module)
-        contents.sort()
-        for obj in contents:
-            if obj[:5] != 'test_':
-                continue
-            test_case = getattr(test_module, obj)
-            test_name = test_module.__name__ + '.' + obj
-            print_start(test_name)
-
-
-            if not start_syslogng(test_module.config, verbose):
-                sys.exit(1)
-
-            print_user("Starting test case...")
-            success = test_case()
-            if not stop_syslogng():
-                sys.exit(1)
-            print_end(test_name, success)
-
-            if not success:
-                rc = 1
+        try:
+            contents = dir(test_module)
+            contents.sort()
+            for obj in contents:
+                if obj[:5] != 'test_':
+                    continue
+                test_case = getattr(test_module, obj)
+                test_name = test_module.__name__ + '.' + obj
+                print_start(test_name)
+
+
+                if not start_syslogng(test_module.config, verbose):
+                    sys.exit(1)
+
+                print_user("Starting test case...")
+                success = test_case()
+                if not stop_syslogng():
+                    sys.exit(1)
+                print_end(test_name, success)
+
+                if not success:
+                    rc = 1
+        finally:
+            # release whatever check_env() set up for the module
+            if hasattr(test_module, "teardown_env"):
+                test_module.teardown_env()
 finally:
     stop_syslogng()
 
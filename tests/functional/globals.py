@@ -16,15 +16,16 @@ def has_module(module):
 is_premium_edition = is_premium()
 if is_premium_edition:
     logstore_store_supported = True
-    wildcard_file_source_supported = True
 else:
     logstore_store_supported = False
-    wildcard_file_source_supported = False
+wildcard_file_source_supported = True
 
 port_number = os.getpid() % 30000 + 33000
 ssl_port_number = port_number + 1
 port_number_syslog = port_number + 2
 port_number_network = port_number + 3
+redis_port_number = port_number + 4
+port_number_reuseport = port_number + 5
 
 current_dir = os.getcwd()
 try:
@@ -2,6 +2,7 @@ from globals import *
 from log import *
 from messagegen import *
 from messagecheck import *
+import control
 
 config = """@version: 3.4
 
@@ -9,10 +10,22 @@ options { ts_format(iso); chain_hostnames(no); keep_hostname(yes); threaded(yes)
 
 source s_int { internal(); };
 source s_wildcard { file("wildcard/*.log"); };
+source s_wildcard_max { file("wildcard/*.mlog" max-files(2)); };
+source s_wildcard_del { file("wildcard/*.dlog"); };
+source s_wildcard_rot { file("wildcard/*.rlog"); };
+source s_wildcard_restart { file("wildcard-restart/*.log"); };
 
 destination d_wildcard { file("test-wildcard.log"); logstore("test-wildcard.lgs"); };
+destination d_wildcard_max { file("test-wildcard-max.log"); };
+destination d_wildcard_del { file("test-wildcard-del.log"); };
+destination d_wildcard_rot { file("test-wildcard-rot.log"); };
+destination d_wildcard_restart { file("test-wildcard-restart.log"); };
 
 log { source(s_wildcard); destination(d_wildcard); };
+log { source(s_wildcard_max); destination(d_wildcard_max); };
+log { source(s_wildcard_del); destination(d_wildcard_del); };
+log { source(s_wildcard_rot); destination(d_wildcard_rot); };
+log { source(s_wildcard_restart); destination(d_wildcard_restart); };
 
 """ % locals()
 
@@ -44,3 +57,110 @@ def test_wildcard_files():
     if not check_file_expected('test-wildcard', expected, settle_time=12):
         return False
     return True
+
+def test_wildcard_max_files():
+    if not wildcard_file_source_supported:
+        print_user("Not testing a Premium version, skipping wild card source tests")
+        return True
+    expected = []
+
+    # three times as many files as max-files(), each of them has to be read
+    for ndx in range(0, 6):
+        s = FileSender('wildcard/%d.mlog' % ndx, repeat=100)
+        expected.extend(s.sendMessages('wildcardmax%d' % ndx))
+
+    if not check_file_expected('test-wildcard-max', expected, settle_time=12):
+        return False
+    return True
+
+def deleted_file_still_open(filename):
+    fd_dir = '/proc/%d/fd' % control.syslogng_pid
+    if not os.path.isdir(fd_dir):
+        print_user("%s is not available, not checking the descriptors of syslog-ng" % fd_dir)
+        return False
+    for fd in os.listdir(fd_dir):
+        try:
+            target = os.readlink(os.path.join(fd_dir, fd))
+        except OSError:
+            continue
+        if target.endswith(filename + ' (deleted)'):
+            return True
+    return False
+
+def test_wildcard_deleted_file():
+    if not wildcard_file_source_supported:
+        print_user("Not testing a Premium version, skipping wild card source tests")
+        return True
+    expected = []
+
+    s = FileSender('wildcard/deleted.dlog', repeat=100)
+    expected.extend(s.sendMessages('wildcarddel0'))
+    del s
+    # let syslog-ng open the file
+    time.sleep(3)
+
+    # the rest of the data is only accessible via the open reader
+    s = FileSender('wildcard/deleted.dlog', repeat=1000)
+    expected.extend(s.sendMessages('wildcarddel1'))
+    del s
+    os.unlink('wildcard/deleted.dlog')
+
+    if not check_file_expected('test-wildcard-del', expected, settle_time=5):
+        return False
+    if deleted_file_still_open('deleted.dlog'):
+        print_user("the reader of the deleted file was not closed")
+        return False
+    return True
+
+def test_wildcard_rotated_file():
+    if not wildcard_file_source_supported:
+        print_user("Not testing a Premium version, skipping wild card source tests")
+        return True
+    expected = []
+
+    s = FileSender('wildcard/rotated.rlog', repeat=100)
+    expected.extend(s.sendMessages('wildcardrot0'))
+    del s
+    time.sleep(3)
+
+    # the new file has the same name as the one being followed
+    os.rename('wildcard/rotated.rlog', 'wildcard/rotated.rlog.1')
+    s = FileSender('wildcard/rotated.rlog', repeat=100)
+    expected.extend(s.sendMessages('wildcardrot1'))
+    del s
+
+    if not check_file_expected('test-wildcard-rot', expected, settle_time=5):
+        return False
+    return True
+
+def test_wildcard_restart():
+    if not wildcard_file_source_supported:
+        print_user("Not testing a Premium version, skipping wild card source tests")
+        return True
+
+    os.system('rm -f wildcard-restart/*')
+    s = FileSender('wildcard-restart/restart.log', repeat=100)
+    expected = s.sendMessages('wildcardrestart0')
+    del s
+    if not check_file_expected('test-wildcard-restart', expected, settle_time=3):
+        return False
+
+    # messages written while syslog-ng is down are read from the
+    # position saved at shutdown, nothing is read twice
+    if not stop_syslogng():
+        return False
+    s = FileSender('wildcard-restart/restart.log', repeat=100)
+    expected = s.sendMessages('wildcardrestart1')
+    del s
+    if not start_syslogng(config, keep_persist=True):
+        return False
+
+    if not check_file_expected('test-wildcard-restart', expected, settle_time=3):
+        return False
+    f = open('test-wildcard-restart.log', 'r')
+    contents = f.read()
+    f.close()
+    if contents.find('wildcardrestart0') != -1:
+        print_user("messages read before the restart were read again")
+        return False
+    return True
@@ -0,0 +1,113 @@
+from globals import *
+from log import *
+from messagegen import *
+from messagecheck import *
+from control import flush_files, stop_syslogng
+
+import threading
+import StringIO
+
+config = """@version: 3.4
+
+options { ts_format(iso); chain_hostnames(no); keep_hostname(yes); threaded(yes); };
+
+source s_tcp { tcp(port(%(port_number)d)); };
+
+destination d_redis {
+    redis(host("127.0.0.1") port(%(redis_port_number)d)
+          command("RPUSH" "syslog" "${MSGHDR}${MSG}")
+          flush_lines(50));
+};
+
+log { source(s_tcp); destination(d_redis); };
+
+""" % locals()
+
+class RedisStandIn(threading.Thread):
+    """A minimal server speaking the REDIS protocol, which stores
+    the values of RPUSH commands and answers every command with an
+    integer reply."""
+
+    def __init__(self, port):
+        threading.Thread.__init__(self)
+        self.setDaemon(True)
+        self.values = []
+        self.sock = socket(AF_INET, SOCK_STREAM)
+        self.sock.setsockopt(SOL_SOCKET, SO_REUSEADDR, 1)
+        self.sock.bind(('127.0.0.1', port))
+        self.sock.listen(5)
+        self.stopped = False
+
+    def read_command(self, f):
+        line = f.readline()
+        if not line or line[0] != '*':
+            return None
+        argv = []
+        for i in range(int(line[1:])):
+            length = int(f.readline()[1:])
+            argv.append(f.read(length))
+            f.read(2)
+        return argv
+
+    def serve(self, conn):
+        f = conn.makefile('rb')
+        while True:
+            argv = self.read_command(f)
+            if argv is None:
+                break
+            if argv[0].upper() == 'RPUSH':
+                self.values.extend(argv[2:])
+            conn.sendall(':%d\r\n' % len(self.values))
+        conn.close()
+
+    def run(self):
+        while not self.stopped:
+            try:
+                (conn, addr) = self.sock.accept()
+            except error:
+                break
+            self.serve(conn)
+
+    def stop(self):
+        self.stopped = True
+        # shutdown() wakes up the accept() call blocking in run()
+        try:
+            self.sock.shutdown(SHUT_RDWR)
+        except error:
+            pass
+        self.sock.close()
+        self.join(5)
+
+redis_server = None
+
+def check_env():
+    global redis_server
+
+    if not has_module('afredis'):
+        print 'afredis module is not available, skipping REDIS test'
+        return False
+    redis_server = RedisStandIn(redis_port_number)
+    redis_server.start()
+    return True
+
+def teardown_env():
+    global redis_server
+
+    redis_server.stop()
+    redis_server = None
+
+def test_redis():
+
+    messages = (
+        'redis1',
+        'redis2'
+    )
+    s = SocketSender(AF_INET, ('localhost', port_number), dgram=0)
+
+    expected = []
+    for msg in messages:
+        expected.extend(s.sendMessages(msg, pri=7))
+    print_user("Waiting for 5 seconds until syslog-ng sends all records to the REDIS server")
+    time.sleep(5)
+    stop_syslogng()
+    return check_contents(StringIO.StringIO('\n'.join(redis_server.values) + '\n'), expected, "prog[12345]:", 0)
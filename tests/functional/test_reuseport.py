@@ -0,0 +1,55 @@
+from globals import *
+from log import *
+from messagegen import *
+from messagecheck import *
+
+config_template = """@version: 3.4
+
+options { ts_format(iso); chain_hostnames(no); keep_hostname(yes); threaded(yes); };
+
+source s_int { internal(); };
+source s_inet { tcp(port(%(port_number_reuseport)d) %(reuseport)s); udp(port(%(port_number_reuseport)d) %(reuseport)s); };
+
+destination d_reuseport { file("test-reuseport.log"); logstore("test-reuseport.lgs"); };
+
+log { source(s_inet); destination(d_reuseport); };
+"""
+
+def reuseport_config(num_listeners=0):
+    if num_listeners:
+        reuseport = 'so-reuseport(%d)' % num_listeners
+    else:
+        reuseport = ''
+    return config_template % { 'port_number_reuseport': port_number_reuseport, 'reuseport': reuseport }
+
+config = reuseport_config()
+
+def send_messages(message):
+    senders = (
+        SocketSender(AF_INET, ('localhost', port_number_reuseport), dgram=1),
+        SocketSender(AF_INET, ('localhost', port_number_reuseport), dgram=0),
+    )
+
+    expected = []
+    for s in senders:
+        expected.extend(s.sendMessages(message))
+    return expected
+
+def test_reuseport_increase():
+    # the listener kept from a configuration without so-reuseport() must
+    # not prevent binding the new ones
+    expected = send_messages('reuseport_before')
+    reload_syslogng(reuseport_config(4))
+    expected.extend(send_messages('reuseport_after'))
+
+    return check_file_expected('test-reuseport', expected, settle_time=6)
+
+def test_reuseport_decrease():
+    # surplus listeners must be closed on reload, otherwise the kernel
+    # keeps distributing datagrams to sockets nobody reads
+    reload_syslogng(reuseport_config(4))
+    expected = send_messages('reuseport_before')
+    reload_syslogng(reuseport_config(1))
+    expected.extend(send_messages('reuseport_after'))
+
+    return check_file_expected('test-reuseport', expected, settle_time=6)
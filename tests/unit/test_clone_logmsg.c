@@ -75,6 +75,38 @@ test_cloning_with_log_message(gchar *msg)
   testcase_end();
 }
 
+void
+test_log_message_blocks_are_recycled(gchar *msg)
+{
+  LogMessage *log_message, *cloned_log_message;
+  gpointer first_block, clone_block;
+  LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
+
+  testcase_begin("Testing that freed log messages are reused; msg='%s'", msg);
+
+  parse_options.flags = LP_SYSLOG_PROTOCOL;
+
+  log_message = log_msg_new(msg, strlen(msg), NULL, &parse_options);
+  first_block = log_message;
+  log_msg_unref(log_message);
+
+  log_message = log_msg_new(msg, strlen(msg), NULL, &parse_options);
+  assert_true(log_message == first_block, "Freed LogMessage block was not reused by the next allocation");
+
+  cloned_log_message = log_msg_clone_cow(log_message, &path_options);
+  clone_block = cloned_log_message;
+  log_msg_unref(cloned_log_message);
+
+  cloned_log_message = log_msg_clone_cow(log_message, &path_options);
+  assert_true(cloned_log_message == clone_block, "Freed clone block was not reused by the next clone");
+  assert_log_message_value(cloned_log_message, LM_V_HOST, "mymachine");
+
+  log_msg_unref(cloned_log_message);
+  log_msg_unref(log_message);
+
+  testcase_end();
+}
+
 int
 main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
 {
@@ -87,6 +119,9 @@ main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
   test_cloning_with_log_message(
       "<132>1 2006-10-29T01:59:59.156+01:00 mymachine evntslog - - [exampleSDID@0 iut=\"3\"] [eventSource=\"Application\" eventID=\"1011\"][examplePriority@0 class=\"high\"] BOMAn application event log entry...");
 
+  test_log_message_blocks_are_recycled(
+      "<132>1 2006-10-29T01:59:59.156+01:00 mymachine evntslog - - [exampleSDID@0 iut=\"3\"] An application event log entry...");
+
   deinit_syslogformat_module();
   app_shutdown();
   return 0;
@@ -4,12 +4,15 @@
 #include "logmsg.h"
 #include "apphook.h"
 #include "plugin.h"
+#include "cfg.h"
 #include "filter-expr-grammar.h"
 
 #include <time.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <stdio.h>
+#include <unistd.h>
 
 int debug = 1;
 GSockAddr *sender_saddr;
@@ -101,6 +104,39 @@ create_pcre_regexp_match(gchar* regexp, gint flags)
 }
 #endif
 
+FilterExprNode *
+create_netmask_set(const gchar *network, ...)
+{
+  FilterExprNode *f = filter_netmask_set_new();
+  va_list va;
+
+  va_start(va, network);
+  while (network)
+    {
+      TEST_ASSERT(filter_netmask_set_add(f, network));
+      network = va_arg(va, const gchar *);
+    }
+  va_end(va);
+  return f;
+}
+
+FilterExprNode *
+create_netmask_set_from_file(const gchar *contents, gboolean expected_result)
+{
+  FilterExprNode *f = filter_netmask_set_new();
+  gchar *filename;
+  gint fd;
+
+  fd = g_file_open_tmp("test_filters_XXXXXX", &filename, NULL);
+  TEST_ASSERT(fd >= 0);
+  TEST_ASSERT(write(fd, contents, strlen(contents)) == strlen(contents));
+  close(fd);
+  TEST_ASSERT(filter_netmask_set_load(f, filename) == expected_result);
+  unlink(filename);
+  g_free(filename);
+  return f;
+}
+
 void
 testcase(gchar *msg,
          FilterExprNode *f,
@@ -209,9 +245,116 @@ testcase_with_backref_chk(gchar *msg,
       exit(1);                                                  \
     }
 
+static void
+test_filter_optimizer(void)
+{
+  FilterExprNode *re, *level, *fac, *f;
+
+  /* the cheap level check is moved before the regexp */
+  re = create_posix_regexp_match("PTHREAD", 0);
+  level = filter_level_new(level_bits("emerg"));
+  f = filter_expr_optimize(fop_and_new(filter_expr_ref(re), filter_expr_ref(level)));
+  debug_flag = 1;
+  testcase("<15> openvpn[2499]: PTHREAD support initialized", f, 0);
+  debug_flag = 0;
+  TEST_ASSERT(level->eval_count == 2);
+  TEST_ASSERT(re->eval_count == 0);
+  filter_expr_unref(re);
+  filter_expr_unref(level);
+
+  /* a regexp storing matches keeps its position */
+  re = create_posix_regexp_filter(LM_V_MESSAGE, "(PTHREAD)", LMF_STORE_MATCHES);
+  level = filter_level_new(level_bits("emerg"));
+  f = filter_expr_optimize(fop_and_new(filter_expr_ref(re), filter_expr_ref(level)));
+  debug_flag = 1;
+  testcase("<15> openvpn[2499]: PTHREAD support initialized", f, 0);
+  debug_flag = 0;
+  TEST_ASSERT(re->eval_count == 2);
+  filter_expr_unref(re);
+  filter_expr_unref(level);
+
+  /* constant operands are dropped */
+  fac = filter_facility_new(facility_bits("user"));
+  f = filter_expr_optimize(fop_and_new(filter_level_new(0xFF), filter_expr_ref(fac)));
+  TEST_ASSERT(f == fac);
+  testcase("<15> openvpn[2499]: PTHREAD support initialized", f, 1);
+  filter_expr_unref(fac);
+
+  /* constant subexpressions are folded */
+  f = filter_expr_optimize(fop_or_new(create_posix_regexp_match("PTHREAD", 0), filter_level_new(0xFF)));
+  TEST_ASSERT(strcmp(f->type, "true") == 0);
+  testcase("<15> openvpn[2499]: foo", f, 1);
+
+  f = filter_expr_optimize(fop_and_new(filter_facility_new(facility_bits("user")), filter_tags_new(NULL)));
+  TEST_ASSERT(strcmp(f->type, "false") == 0);
+  testcase("<15> openvpn[2499]: foo", f, 0);
+
+  /* longer chains are reordered as a whole */
+  f = filter_expr_optimize(fop_or_new(fop_or_new(create_posix_regexp_match("foo", 0),
+                                                 create_posix_regexp_match("bar", 0)),
+                                      filter_level_new(level_bits("debug"))));
+  testcase("<15> openvpn[2499]: PTHREAD support initialized", f, 1);
+}
+
+static LogPipe *
+add_filter_rule(const gchar *name, FilterExprNode *expr)
+{
+  LogPipe *p = log_filter_pipe_new(expr);
+  LogExprNode *node = log_expr_node_new_pipe(p, NULL);
+
+  p->expr_node = node;
+  cfg_tree_add_object(&configuration->tree, log_expr_node_new_filter(name, node, NULL));
+  return p;
+}
+
+static FilterExprNode *
+negate(FilterExprNode *f)
+{
+  f->comp = !f->comp;
+  return f;
+}
+
+void
+test_filter_call_reference(void)
+{
+  LogPipe *f_a, *f_b, *f_c;
+  LogMessage *logmsg;
+  gchar *msg_user = "<15> openvpn[2499]: PTHREAD support initialized";
+  gchar *msg_daemon = "<30> openvpn[2499]: PTHREAD support initialized";
+
+  /* filter f_c { facility(user); };
+   * filter f_a { filter(f_c); };
+   * filter f_b { not filter(f_a); };
+   *
+   * f_b is initialized first, the negated call keeps pointing to the
+   * root of f_a, which is replaced when f_a itself is optimized. */
+  f_c = add_filter_rule("f_c", filter_facility_new(facility_bits("user")));
+  f_a = add_filter_rule("f_a", filter_call_new("f_c", configuration));
+  f_b = add_filter_rule("f_b", negate(filter_call_new("f_a", configuration)));
+
+  TEST_ASSERT(log_pipe_init(f_b, configuration));
+  TEST_ASSERT(log_pipe_init(f_a, configuration));
+  TEST_ASSERT(log_pipe_init(f_c, configuration));
+
+  logmsg = log_msg_new(msg_user, strlen(msg_user), NULL, &parse_options);
+  TEST_ASSERT(filter_expr_eval(((LogFilterPipe *) f_a)->expr, logmsg));
+  TEST_ASSERT(!filter_expr_eval(((LogFilterPipe *) f_b)->expr, logmsg));
+  log_msg_unref(logmsg);
+
+  logmsg = log_msg_new(msg_daemon, strlen(msg_daemon), NULL, &parse_options);
+  TEST_ASSERT(!filter_expr_eval(((LogFilterPipe *) f_a)->expr, logmsg));
+  TEST_ASSERT(filter_expr_eval(((LogFilterPipe *) f_b)->expr, logmsg));
+  log_msg_unref(logmsg);
+
+  log_pipe_deinit(f_b);
+  log_pipe_deinit(f_a);
+  log_pipe_deinit(f_c);
+}
+
 int
 main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
 {
+  FilterExprNode *f;
   gint i;
 
   app_startup();
@@ -308,10 +451,48 @@ main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
   testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", filter_netmask_new("10.10.0.0/24"), 1);
   testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", filter_netmask_new("10.10.10.0/24"), 0);
   testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", filter_netmask_new("0.0.10.10/24"), 0);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set("192.168.0.0/16", "10.10.0.0/16", NULL), 1);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set("10.10.0.0/255.255.255.0", "10.10.10.0/24", NULL), 1);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set("10.10.10.0/24", "10.10.0.2", "2001:db8::/32", NULL), 0);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set("10.10.0.0/24", "10.0.0.0/8", NULL), 1);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set(NULL), 0);
+
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set_from_file("# trusted networks\n\n192.168.0.0/16\n  10.10.0.0/16  \n", TRUE), 1);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set_from_file("10.10.10.0/24\n# 10.10.0.0/16\n2001:db8::/32", TRUE), 0);
+
+  fprintf(stderr, "Three \"Error parsing network\" messages are to be expected\n");
+  f = filter_netmask_set_new();
+  TEST_ASSERT(!filter_netmask_set_add(f, "10.10.0.0/33"));
+  TEST_ASSERT(!filter_netmask_set_add(f, "10.10.0.0/255.0.255.0"));
+  filter_expr_unref(f);
+  filter_expr_unref(create_netmask_set_from_file("10.10.0.0/16\n10.10.0.0/33\n", FALSE));
+
+  fprintf(stderr, "One \"Error opening network list\" message is to be expected\n");
+  f = filter_netmask_set_new();
+  TEST_ASSERT(!filter_netmask_set_load(f, "/nonexistent/netmask-set.list"));
+  filter_expr_unref(f);
   g_sockaddr_unref(sender_saddr);
   sender_saddr = NULL;
   testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", filter_netmask_new("127.0.0.1/32"), 1);
   testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", filter_netmask_new("127.0.0.2/32"), 0);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set("127.0.0.0/8", NULL), 1);
+
+#if ENABLE_IPV6
+  sender_saddr = g_sockaddr_inet6_new("2001:db8:10::1", 5000);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", filter_netmask_new("2001:db8::/32"), 1);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", filter_netmask_new("2001:db8:11::/48"), 0);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set("10.0.0.0/8", "2001:db8:10::/48", NULL), 1);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set("10.0.0.0/8", "2001:db8:11::/48", "2001:db9::/32", NULL), 0);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set_from_file("10.10.0.0/16\n2001:db8:10::/48\n", TRUE), 1);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set_from_file("2001:db8:11::/48\n", TRUE), 0);
+  g_sockaddr_unref(sender_saddr);
+  sender_saddr = g_sockaddr_inet6_new("::ffff:10.10.0.1", 5000);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set("10.10.0.0/16", NULL), 1);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set("10.10.10.0/24", "2001:db8::/32", NULL), 0);
+  testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", create_netmask_set_from_file("10.10.0.0/16\n", TRUE), 1);
+  g_sockaddr_unref(sender_saddr);
+  sender_saddr = NULL;
+#endif
 
   testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", fop_or_new(create_posix_regexp_match(" PTHREAD ", 0), create_posix_regexp_match("PTHREAD", 0)), 1);
   testcase("<15>Oct 15 16:17:01 host openvpn[2499]: PTHREAD support initialized", fop_or_new(create_posix_regexp_match(" PTHREAD ", 0), create_posix_regexp_match("^PTHREAD$", 0)), 1);
@@ -404,6 +585,9 @@ main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
   testcase_with_backref_chk("<15>Oct 15 16:17:01 host openvpn[2499]: al fa", create_pcre_regexp_filter(LM_V_MESSAGE, "(a)(l) (fa)", LMF_STORE_MATCHES), 1, "233",NULL);
 #endif
 
+  test_filter_optimizer();
+  test_filter_call_reference();
+
   app_shutdown();
   return 0;
 }
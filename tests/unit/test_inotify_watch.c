@@ -0,0 +1,170 @@
+#include "inotify-watch.h"
+#include "apphook.h"
+#include "testutils.h"
+#include "timeutils.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <iv.h>
+
+#if HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+
+#define FILE_A "test_inotify_watch_a.log"
+#define FILE_B "test_inotify_watch_b.log"
+
+typedef struct _TestWatch
+{
+  InotifyWatch super;
+  guint32 events;
+  gboolean stop_on_event;
+} TestWatch;
+
+static void
+test_watch_handler(gpointer s, guint32 mask, const gchar *name)
+{
+  TestWatch *self = (TestWatch *) s;
+
+  self->events |= mask;
+  if (self->stop_on_event)
+    inotify_watch_stop(&self->super);
+}
+
+static void
+test_watch_init(TestWatch *self, const gchar *filename)
+{
+  inotify_watch_init(&self->super, self, test_watch_handler);
+  self->events = 0;
+  self->stop_on_event = FALSE;
+  assert_true(inotify_watch_start(&self->super, filename, IN_MODIFY | IN_ATTRIB | IN_DELETE_SELF),
+              "unable to start inotify watch; filename=%s", filename);
+}
+
+static void
+append_to_file(const gchar *filename)
+{
+  FILE *f = fopen(filename, "a");
+
+  assert_not_null(f, "unable to open file; filename=%s", filename);
+  fputs("foobar\n", f);
+  fclose(f);
+}
+
+static void
+quit_main_loop(gpointer s)
+{
+  iv_quit();
+}
+
+/* deliver the pending inotify events */
+static void
+run_main_loop(void)
+{
+  struct iv_timer timer;
+
+  IV_TIMER_INIT(&timer);
+  timer.handler = quit_main_loop;
+  iv_validate_now();
+  timer.expires = iv_now;
+  timespec_add_msec(&timer.expires, 100);
+  iv_timer_register(&timer);
+  iv_main();
+}
+
+static void
+test_events_are_dispatched_to_the_watches_of_the_file(void)
+{
+  TestWatch a1, a2, b;
+
+  testcase_begin("%s", __FUNCTION__);
+
+  append_to_file(FILE_A);
+  append_to_file(FILE_B);
+  test_watch_init(&a1, FILE_A);
+  test_watch_init(&a2, FILE_A);
+  test_watch_init(&b, FILE_B);
+  assert_gint(a1.super.wd, a2.super.wd, "watches of the same file should share the watch descriptor");
+
+  append_to_file(FILE_A);
+  run_main_loop();
+  assert_true(a1.events & IN_MODIFY, "first watch of the modified file was not notified");
+  assert_true(a2.events & IN_MODIFY, "second watch of the modified file was not notified");
+  assert_guint32(b.events, 0, "watch of another file was notified");
+
+  /* the kernel watch is kept while a2 still needs it */
+  a1.events = a2.events = 0;
+  inotify_watch_stop(&a1.super);
+  append_to_file(FILE_A);
+  run_main_loop();
+  assert_guint32(a1.events, 0, "stopped watch was notified");
+  assert_true(a2.events & IN_MODIFY, "remaining watch of the modified file was not notified");
+
+  inotify_watch_stop(&a2.super);
+  inotify_watch_stop(&b.super);
+  assert_false(inotify_watch_started(&b.super), "watch is still started after stopping it");
+
+  unlink(FILE_A);
+  unlink(FILE_B);
+  testcase_end();
+}
+
+static void
+test_handler_may_stop_its_own_watch(void)
+{
+  TestWatch a, b;
+
+  testcase_begin("%s", __FUNCTION__);
+
+  append_to_file(FILE_A);
+  append_to_file(FILE_B);
+  test_watch_init(&a, FILE_A);
+  test_watch_init(&b, FILE_B);
+  a.stop_on_event = TRUE;
+
+  append_to_file(FILE_A);
+  append_to_file(FILE_A);
+  append_to_file(FILE_B);
+  run_main_loop();
+  assert_true(a.events & IN_MODIFY, "watch was not notified");
+  assert_false(inotify_watch_started(&a.super), "watch was not stopped by its handler");
+  assert_true(b.events & IN_MODIFY, "events following a stopped watch were lost");
+
+  /* stopping the last watch closes the shared instance, the next one reopens it */
+  b.stop_on_event = TRUE;
+  unlink(FILE_B);
+  run_main_loop();
+  assert_true(b.events & (IN_ATTRIB | IN_DELETE_SELF), "deleting the file was not reported");
+  assert_false(inotify_watch_started(&b.super), "watch was not stopped by its handler");
+  test_watch_init(&a, FILE_A);
+  append_to_file(FILE_A);
+  run_main_loop();
+  assert_true(a.events & IN_MODIFY, "watch added after reopening the inotify instance was not notified");
+  inotify_watch_stop(&a.super);
+
+  unlink(FILE_A);
+  testcase_end();
+}
+
+int
+main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
+{
+  app_startup();
+  iv_init();
+
+  test_events_are_dispatched_to_the_watches_of_the_file();
+  test_handler_may_stop_its_own_watch();
+
+  iv_deinit();
+  app_shutdown();
+  return 0;
+}
+
+#else
+
+int
+main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
+{
+  return 0;
+}
+
+#endif
@@ -5,9 +5,15 @@
 #include "logproto-framed-server.h"
 #include "logproto-dgram-server.h"
 #include "logproto-record-server.h"
+#include "logproto-framed-client.h"
 
 #include "apphook.h"
 
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/socket.h>
+
 static void
 test_log_proto_server_options_limits(void)
 {
@@ -855,6 +861,104 @@ test_log_proto_framed_server(void)
   test_log_proto_framed_server_multi_read();
 }
 
+/****************************************************************************************
+ * LogProtoFramedClient
+ ****************************************************************************************/
+
+static void
+assert_pipe_contents(gint fd, const gchar *expected)
+{
+  gchar buf[256];
+  gssize rc;
+
+  rc = read(fd, buf, sizeof(buf));
+  if (rc < 0)
+    rc = 0;
+  assert_nstring(buf, rc, expected, -1, "pipe contents mismatch");
+}
+
+static void
+test_log_proto_framed_client_batches_writes(void)
+{
+  LogProtoClientOptions client_options = { 0 };
+  LogProtoClient *proto;
+  gboolean consumed;
+  gint fds[2];
+
+  log_proto_testcase_begin("test_log_proto_framed_client_batches_writes");
+  assert_gint(pipe(fds), 0, "pipe() failed");
+  fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+  client_options.flush_lines = 2;
+  proto = log_proto_framed_client_new(log_transport_pipe_new(fds[1]), &client_options);
+
+  assert_gint(log_proto_client_post(proto, (guchar *) g_strdup("foo"), 3, &consumed), LPS_SUCCESS, "post failed");
+  assert_true(consumed, "message was not consumed");
+  assert_pipe_contents(fds[0], "");
+
+  /* the second message fills the batch, which is written in one go */
+  assert_gint(log_proto_client_post(proto, (guchar *) g_strdup("bar"), 3, &consumed), LPS_SUCCESS, "post failed");
+  assert_pipe_contents(fds[0], "3 foo3 bar");
+
+  assert_gint(log_proto_client_post(proto, (guchar *) g_strdup("bazz"), 4, &consumed), LPS_SUCCESS, "post failed");
+  assert_pipe_contents(fds[0], "");
+  assert_gint(log_proto_client_flush(proto), LPS_SUCCESS, "flush failed");
+  assert_pipe_contents(fds[0], "4 bazz");
+
+  log_proto_client_free(proto);
+  close(fds[0]);
+  log_proto_testcase_end();
+}
+
+static void
+test_log_proto_framed_client(void)
+{
+  test_log_proto_framed_client_batches_writes();
+}
+
+/****************************************************************************************
+ * batched datagram transport
+ ****************************************************************************************/
+
+static void
+assert_transport_read(LogTransport *transport, const gchar *expected)
+{
+  gchar buf[64];
+  gssize rc;
+
+  rc = log_transport_read(transport, buf, sizeof(buf), NULL);
+  assert_nstring(buf, rc, expected, -1, "datagram contents mismatch");
+}
+
+static void
+test_log_transport_dgram_batched_read(void)
+{
+  LogTransport *transport;
+  gchar buf[64];
+  gint fds[2];
+
+  testcase_begin("test_log_transport_dgram_batched_read");
+  assert_gint(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds), 0, "socketpair() failed");
+  fcntl(fds[0], F_SETFL, O_NONBLOCK);
+  transport = log_transport_dgram_socket_batched_new(fds[0], 4, 16);
+
+  send(fds[1], "first", 5, 0);
+  send(fds[1], "second", 6, 0);
+  send(fds[1], "this one gets truncated", 23, 0);
+
+  assert_transport_read(transport, "first");
+  /* the rest of the batch was received by the first read */
+  assert_true(log_transport_has_pending_input(transport), "the rest of the batch should be pending");
+  assert_transport_read(transport, "second");
+  assert_transport_read(transport, "this one gets tr");
+  assert_false(log_transport_has_pending_input(transport), "no more datagrams should be pending");
+  assert_gint(log_transport_read(transport, buf, sizeof(buf), NULL), -1, "read should fail when no datagrams are available");
+
+  log_transport_free(transport);
+  close(fds[1]);
+  testcase_end();
+}
+
 static void
 test_log_proto(void)
 {
@@ -877,7 +981,6 @@ test_log_proto(void)
    *
    * log_proto_text_client_new
    * log_proto_file_writer_new
-   * log_proto_framed_client_new
    */
   test_log_proto_server_options();
   test_log_proto_base();
@@ -885,6 +988,13 @@ test_log_proto(void)
   test_log_proto_text_server();
   test_log_proto_dgram_server();
   test_log_proto_framed_server();
+  test_log_proto_framed_client();
+}
+
+static void
+test_log_transport(void)
+{
+  test_log_transport_dgram_batched_read();
 }
 
 
@@ -896,6 +1006,7 @@ main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
   init_proto_tests();
 
   test_log_proto();
+  test_log_transport();
 
   deinit_proto_tests();
   app_shutdown();
@@ -1,5 +1,7 @@
 #include "logqueue.h"
 #include "logqueue-fifo.h"
+#include "logqueue-disk.h"
+#include "persist-state.h"
 #include "logpipe.h"
 #include "apphook.h"
 #include "plugin.h"
@@ -8,6 +10,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <iv.h>
 #include <iv_list.h>
 #include <iv_thread.h>
@@ -63,6 +66,31 @@ send_some_messages(LogQueue *q, gint n, gboolean use_app_acks)
     }
 }
 
+void
+send_some_messages_in_batches(LogQueue *q, gint n, gint batch_size, gboolean use_app_acks)
+{
+  LogMessage *msgs[16];
+  LogPathOptions path_options[16];
+  gint i, popped;
+
+  g_assert(batch_size <= 16);
+  while (n > 0)
+    {
+      popped = log_queue_pop_batch(q, msgs, path_options, MIN(n, batch_size), use_app_acks, FALSE);
+      if (popped == 0)
+        {
+          fprintf(stderr, "queue depleted while popping batches, %d messages missing\n", n);
+          exit(1);
+        }
+      for (i = 0; i < popped; i++)
+        {
+          log_msg_ack(msgs[i], &path_options[i]);
+          log_msg_unref(msgs[i]);
+        }
+      n -= popped;
+    }
+}
+
 void
 app_ack_some_messages(LogQueue *q, gint n)
 {
@@ -122,6 +150,209 @@ testcase_zero_diskbuf_alternating_send_acks()
   log_queue_unref(q);
 }
 
+void
+testcase_disk_buffer_send_acks_and_rewind()
+{
+  LogQueue *q;
+  LogQueueDiskOptions options;
+  PersistState *state;
+
+  unlink("test_logqueue.persist");
+  unlink("./syslog-ng-00000.qf");
+  state = persist_state_new("test_logqueue.persist");
+  persist_state_start(state);
+
+  log_queue_disk_options_defaults(&options);
+  options.disk_buf_size = 1024 * 1024;
+  log_queue_disk_options_set_dir(&options, ".");
+
+  q = log_queue_disk_new(&options, "test_disk_queue", state);
+  if (!q)
+    {
+      fprintf(stderr, "unable to create disk queue\n");
+      exit(1);
+    }
+  fed_messages = 0;
+  acked_messages = 0;
+  feed_some_messages(&q, 100, TRUE);
+
+  send_some_messages(q, 50, TRUE);
+  rewind_messages(q);
+  send_some_messages(q, fed_messages, TRUE);
+  app_ack_some_messages(q, fed_messages);
+  if (fed_messages != acked_messages || log_queue_get_length(q) != 0)
+    {
+      fprintf(stderr, "disk queue did not deliver every message: fed_messages=%d, acked_messages=%d, length=%d\n",
+              fed_messages, acked_messages, (gint) log_queue_get_length(q));
+      exit(1);
+    }
+
+  log_queue_unref(q);
+  log_queue_disk_options_destroy(&options);
+  persist_state_cancel(state);
+  unlink("test_logqueue.persist");
+  unlink("./syslog-ng-00000.qf");
+}
+
+void
+testcase_disk_buffer_restart()
+{
+  LogQueue *q;
+  LogQueueDiskOptions options;
+  PersistState *state;
+  LogPathOptions path_options = LOG_PATH_OPTIONS_INIT;
+  LogMessage *msg;
+  gchar msg_str[128], expected[32];
+  const gchar *value;
+  gint i;
+
+  unlink("test_logqueue.persist");
+  unlink("./syslog-ng-00000.qf");
+  state = persist_state_new("test_logqueue.persist");
+  persist_state_start(state);
+
+  log_queue_disk_options_defaults(&options);
+  options.disk_buf_size = 1024 * 1024;
+  log_queue_disk_options_set_dir(&options, ".");
+
+  q = log_queue_disk_new(&options, "test_disk_queue", state);
+  if (!q)
+    {
+      fprintf(stderr, "unable to create disk queue\n");
+      exit(1);
+    }
+  for (i = 0; i < 10; i++)
+    {
+      g_snprintf(msg_str, sizeof(msg_str), "<155>2006-02-11T10:34:56+01:00 bzorp syslog-ng[23323]: message %d", i);
+      msg = log_msg_new(msg_str, strlen(msg_str), NULL, &parse_options);
+      log_queue_push_tail(q, msg, &path_options);
+    }
+
+  /* the first few messages were sent, but never acknowledged */
+  for (i = 0; i < 4; i++)
+    {
+      log_queue_pop_head(q, &msg, &path_options, TRUE, FALSE);
+      log_msg_unref(msg);
+    }
+
+  log_queue_unref(q);
+  persist_state_commit(state);
+  persist_state_free(state);
+
+  /* after the restart every message is delivered again, in order */
+  state = persist_state_new("test_logqueue.persist");
+  persist_state_start(state);
+  q = log_queue_disk_new(&options, "test_disk_queue", state);
+  if (!q || log_queue_get_length(q) != 10)
+    {
+      fprintf(stderr, "disk queue lost messages over a restart: length=%d\n", q ? (gint) log_queue_get_length(q) : -1);
+      exit(1);
+    }
+  for (i = 0; i < 10; i++)
+    {
+      if (!log_queue_pop_head(q, &msg, &path_options, FALSE, FALSE))
+        {
+          fprintf(stderr, "disk queue depleted after a restart, %d messages missing\n", 10 - i);
+          exit(1);
+        }
+      g_snprintf(expected, sizeof(expected), "message %d", i);
+      value = log_msg_get_value(msg, LM_V_MESSAGE, NULL);
+      if (strcmp(value, expected) != 0)
+        {
+          fprintf(stderr, "disk queue returned a different message after a restart: expected='%s', value='%s'\n", expected, value);
+          exit(1);
+        }
+      log_msg_unref(msg);
+    }
+  if (log_queue_get_length(q) != 0)
+    {
+      fprintf(stderr, "disk queue has extra messages after a restart: length=%d\n", (gint) log_queue_get_length(q));
+      exit(1);
+    }
+
+  log_queue_unref(q);
+  log_queue_disk_options_destroy(&options);
+  persist_state_cancel(state);
+  unlink("test_logqueue.persist");
+  unlink("./syslog-ng-00000.qf");
+}
+
+void
+testcase_pop_batch_with_and_without_backlog()
+{
+  LogQueue *q;
+
+  q = log_queue_fifo_new(OVERFLOW_SIZE, NULL);
+  fed_messages = 0;
+  acked_messages = 0;
+  feed_some_messages(&q, 100, TRUE);
+
+  /* half of the messages go through the backlog, acked partially and then as a whole */
+  send_some_messages_in_batches(q, 50, 7, TRUE);
+  app_ack_some_messages(q, 20);
+  rewind_messages(q);
+  send_some_messages_in_batches(q, 30, 16, TRUE);
+  app_ack_some_messages(q, 30);
+  send_some_messages_in_batches(q, 50, 9, FALSE);
+
+  if (fed_messages != acked_messages || log_queue_get_length(q) != 0)
+    {
+      fprintf(stderr, "pop_batch did not deliver every message: fed_messages=%d, acked_messages=%d, length=%d\n",
+              fed_messages, acked_messages, (gint) log_queue_get_length(q));
+      exit(1);
+    }
+
+  log_queue_unref(q);
+}
+
+void
+testcase_pop_batch_push_back_refunds_throttle()
+{
+  LogQueue *q;
+  LogMessage *msgs[16];
+  LogPathOptions path_options[16];
+  gint popped, i;
+
+  q = log_queue_fifo_new(OVERFLOW_SIZE, NULL);
+  log_queue_set_throttle(q, 10);
+  fed_messages = 0;
+  acked_messages = 0;
+  feed_some_messages(&q, 20, TRUE);
+
+  /* pretend that only the first 3 messages could be written */
+  popped = log_queue_pop_batch(q, msgs, path_options, 16, FALSE, FALSE);
+  if (popped != 10 || q->throttle_buckets != 0)
+    {
+      fprintf(stderr, "pop_batch did not honour throttle: popped=%d, buckets=%d\n", popped, q->throttle_buckets);
+      exit(1);
+    }
+  for (i = 0; i < 3; i++)
+    {
+      log_msg_ack(msgs[i], &path_options[i]);
+      log_msg_unref(msgs[i]);
+    }
+  for (i = popped - 1; i >= 3; i--)
+    log_queue_push_head(q, msgs[i], &path_options[i]);
+  log_queue_refund_throttle(q, popped - 3);
+
+  if (q->throttle_buckets != 7)
+    {
+      fprintf(stderr, "throttle buckets not refunded for pushed back messages: buckets=%d\n", q->throttle_buckets);
+      exit(1);
+    }
+
+  log_queue_set_throttle(q, 0);
+  send_some_messages(q, 17, FALSE);
+  if (fed_messages != acked_messages || log_queue_get_length(q) != 0)
+    {
+      fprintf(stderr, "messages lost after push back: fed_messages=%d, acked_messages=%d, length=%d\n",
+              fed_messages, acked_messages, (gint) log_queue_get_length(q));
+      exit(1);
+    }
+
+  log_queue_unref(q);
+}
+
 #define FEEDERS 1
 #define MESSAGES_PER_FEEDER 50000
 #define MESSAGES_SUM (FEEDERS * MESSAGES_PER_FEEDER)
@@ -332,5 +563,13 @@ main()
   fprintf(stderr,"Start testcase_zero_diskbuf_and_normal_acks\n");
   testcase_zero_diskbuf_and_normal_acks();
 #endif
+  fprintf(stderr,"Start testcase_pop_batch_with_and_without_backlog\n");
+  testcase_pop_batch_with_and_without_backlog();
+  fprintf(stderr,"Start testcase_pop_batch_push_back_refunds_throttle\n");
+  testcase_pop_batch_push_back_refunds_throttle();
+  fprintf(stderr,"Start testcase_disk_buffer_send_acks_and_rewind\n");
+  testcase_disk_buffer_send_acks_and_rewind();
+  fprintf(stderr,"Start testcase_disk_buffer_restart\n");
+  testcase_disk_buffer_restart();
   return 0;
 }
@@ -1,4 +1,5 @@
 #include "logmatcher.h"
+#include "logmatcher-set.h"
 #include "apphook.h"
 #include "plugin.h"
 #include "cfg.h"
@@ -46,6 +47,38 @@ testcase_match(const gchar *log, const gchar *pattern, gint matcher_flags, gbool
   return 0;
 }
 
+/* matching a write protected (e.g. shared between destinations) message
+ * must not try to store the matches, even if the pattern needs captures */
+void
+testcase_match_write_protected(const gchar *log, const gchar *pattern, gboolean expected_result, LogMatcher *m)
+{
+  LogMessage *msg;
+  gboolean result;
+  gssize msglen;
+  const gchar *value;
+  GSockAddr *sa;
+
+  sa = g_sockaddr_inet_new("10.10.10.10", 1010);
+  msg = log_msg_new(log, strlen(log), sa, &parse_options);
+  g_sockaddr_unref(sa);
+  log_msg_write_protect(msg);
+
+  log_matcher_set_flags(m, 0);
+  log_matcher_compile(m, pattern);
+
+  value = log_msg_get_value(msg, LM_V_MESSAGE, &msglen);
+  result = log_matcher_match(m, msg, LM_V_MESSAGE, value, msglen);
+
+  if (result != expected_result)
+    {
+      fprintf(stderr, "Testcase write protected match failure. pattern=%s, result=%d, expected=%d\n", pattern, result, expected_result);
+      exit(1);
+    }
+
+  log_matcher_unref(m);
+  log_msg_unref(msg);
+}
+
 int
 testcase_replace(const gchar *log, const gchar *re, gchar *replacement, const gchar *expected_result, const gint matcher_flags, LogMatcher *m)
 {
@@ -98,6 +131,70 @@ testcase_replace(const gchar *log, const gchar *re, gchar *replacement, const gc
   return 0;
 }
 
+void
+testcase_required_literal(const gchar *pattern, const gchar *expected_literal, LogMatcher *m)
+{
+  gchar *literal;
+
+  log_matcher_compile(m, pattern);
+  literal = log_matcher_get_required_literal(m);
+  if ((literal == NULL) != (expected_literal == NULL) ||
+      (literal && strcmp(literal, expected_literal) != 0))
+    {
+      fprintf(stderr, "Testcase required literal failure. pattern=%s, literal=%s, expected=%s\n",
+              pattern, literal ? literal : "(null)", expected_literal ? expected_literal : "(null)");
+      exit(1);
+    }
+  g_free(literal);
+  log_matcher_unref(m);
+}
+
+void
+testcase_matcher_set(void)
+{
+  LogMatcherSet *set = log_matcher_set_new();
+  const guint32 *matches;
+  gint error, fail, he, she;
+  const gchar *value;
+
+  error = log_matcher_set_add_pattern(set, "error", FALSE);
+  fail = log_matcher_set_add_pattern(set, "Fail", TRUE);
+  he = log_matcher_set_add_pattern(set, "he", FALSE);
+  she = log_matcher_set_add_pattern(set, "she", FALSE);
+  if (log_matcher_set_add_pattern(set, "", FALSE) >= 0)
+    {
+      fprintf(stderr, "Testcase matcher set failure, empty pattern accepted\n");
+      exit(1);
+    }
+  log_matcher_set_compile(set);
+  if (log_matcher_set_add_pattern(set, "late", FALSE) >= 0)
+    {
+      fprintf(stderr, "Testcase matcher set failure, pattern accepted after compile\n");
+      exit(1);
+    }
+
+  value = "ushers FAILED with an ERROR";
+  /* the second scan is served from the per-thread memo */
+  matches = log_matcher_set_scan(set, value, strlen(value));
+  matches = log_matcher_set_scan(set, value, strlen(value));
+  if (log_matcher_set_has_match(matches, error) || !log_matcher_set_has_match(matches, fail) ||
+      !log_matcher_set_has_match(matches, he) || !log_matcher_set_has_match(matches, she))
+    {
+      fprintf(stderr, "Testcase matcher set failure, value=%s\n", value);
+      exit(1);
+    }
+
+  value = "an error here";
+  matches = log_matcher_set_scan(set, value, strlen(value));
+  if (!log_matcher_set_has_match(matches, error) || log_matcher_set_has_match(matches, fail) ||
+      !log_matcher_set_has_match(matches, he) || log_matcher_set_has_match(matches, she))
+    {
+      fprintf(stderr, "Testcase matcher set failure, value=%s\n", value);
+      exit(1);
+    }
+  log_matcher_set_unref(set);
+}
+
 int
 main()
 {
@@ -173,10 +270,29 @@ main()
   testcase_replace("<155>2006-02-11T10:34:56+01:00 bzorp syslog-ng[23323]: wikiwiki", "wi", "", "kiki", LMF_GLOBAL, log_matcher_pcre_re_new());
   testcase_replace("<155>2006-02-11T10:34:56+01:00 bzorp syslog-ng[23323]: wikiwiki", "wi", "kuku", "kukukikukuki", LMF_GLOBAL, log_matcher_pcre_re_new());
 
+  /* matching without storing matches skips capturing, unless there are back references */
+  testcase_match("<155>2006-02-11T10:34:56+01:00 bzorp syslog-ng[23323]: wikiwiki", "(wi)(ki)", 0, TRUE, log_matcher_pcre_re_new());
+  testcase_match("<155>2006-02-11T10:34:56+01:00 bzorp syslog-ng[23323]: wikiwiki", "(wiki)\\1", 0, TRUE, log_matcher_pcre_re_new());
+  testcase_match("<155>2006-02-11T10:34:56+01:00 bzorp syslog-ng[23323]: wikiwiki", "(wiki)\\1", LMF_STORE_MATCHES, TRUE, log_matcher_pcre_re_new());
+  testcase_match("<155>2006-02-11T10:34:56+01:00 bzorp syslog-ng[23323]: wikiwiki", "(wiki)\\1\\1", 0, FALSE, log_matcher_pcre_re_new());
+  testcase_match_write_protected("<155>2006-02-11T10:34:56+01:00 bzorp syslog-ng[23323]: wikiwiki", "(wiki)\\1", TRUE, log_matcher_pcre_re_new());
+  testcase_match_write_protected("<155>2006-02-11T10:34:56+01:00 bzorp syslog-ng[23323]: wikiwiki", "(?P<w>wiki)(?P=w)", TRUE, log_matcher_pcre_re_new());
+
   /* this tests a pcre 8.12 incompatibility */
 
   testcase_replace("<155>2006-02-11T10:34:56+01:00 bzorp syslog-ng[23323]: wikiwiki", "([[:digit:]]{1,3}\\.){3}[[:digit:]]{1,3}", "foo", "wikiwiki", LMF_GLOBAL, log_matcher_pcre_re_new());
 #endif
 
+  testcase_required_literal("sshd", "sshd", log_matcher_string_new());
+  testcase_required_literal("*fúró*", "fúró", log_matcher_glob_new());
+  testcase_required_literal("a*b?c", NULL, log_matcher_glob_new());
+  testcase_required_literal("Accepted (password|publickey) for", NULL, log_matcher_posix_re_new());
+  testcase_required_literal("^session opened[[:space:]]+for user", "session opened", log_matcher_posix_re_new());
+  testcase_required_literal("errors?: disk", ": disk", log_matcher_posix_re_new());
+  testcase_required_literal("foo|barbaz", NULL, log_matcher_posix_re_new());
+  testcase_required_literal("abc\\d+xyz1", "xyz1", log_matcher_posix_re_new());
+  testcase_required_literal("\\.conf{2}ig", ".con", log_matcher_posix_re_new());
+  testcase_matcher_set();
+
   return 0;
 }
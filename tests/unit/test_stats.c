@@ -0,0 +1,85 @@
+#include "stats.h"
+#include "mainloop.h"
+#include "apphook.h"
+#include "testutils.h"
+
+#define STATS_TEST_THREADS 4
+
+static void
+test_sharded_counter_is_aggregated_on_read(void)
+{
+  StatsCounterItem *counter;
+  gint i;
+
+  testcase_begin("%s", __FUNCTION__);
+
+  stats_lock();
+  stats_register_counter(0, SCS_FILE | SCS_DESTINATION, "test_stats", "sharded", SC_TYPE_PROCESSED, &counter);
+  stats_unlock();
+  assert_not_null(counter->shards, "static counters should be sharded");
+
+  for (i = 0; i < STATS_TEST_THREADS; i++)
+    {
+      main_loop_io_worker_set_thread_id(i);
+      stats_counter_add(counter, i + 1);
+    }
+
+  /* threads other than the I/O workers use the shared value */
+  main_loop_io_worker_set_thread_id(-1);
+  stats_counter_inc(counter);
+  assert_guint64(stats_counter_get(counter), 11, "sharded counter value mismatch");
+
+  main_loop_io_worker_set_thread_id(0);
+  stats_counter_dec(counter);
+  assert_guint64(stats_counter_get(counter), 10, "sharded counter value mismatch after dec");
+
+  stats_counter_set(counter, 5);
+  assert_guint64(stats_counter_get(counter), 5, "set should reset the shards");
+  main_loop_io_worker_set_thread_id(-1);
+
+  stats_lock();
+  stats_unregister_counter(SCS_FILE | SCS_DESTINATION, "test_stats", "sharded", SC_TYPE_PROCESSED, &counter);
+  stats_unlock();
+
+  testcase_end();
+}
+
+static void
+test_counter_does_not_wrap_at_32_bits(void)
+{
+  StatsCounterItem *counter;
+  gint i;
+
+  testcase_begin("%s", __FUNCTION__);
+
+  stats_lock();
+  stats_register_counter(0, SCS_FILE | SCS_DESTINATION, "test_stats", "wide", SC_TYPE_PROCESSED, &counter);
+  stats_unlock();
+
+  for (i = 0; i < 3; i++)
+    {
+      main_loop_io_worker_set_thread_id(i % 2 ? -1 : 1);
+      stats_counter_add(counter, G_MAXINT);
+    }
+  main_loop_io_worker_set_thread_id(-1);
+  assert_guint64(stats_counter_get(counter), 3 * (guint64) G_MAXINT, "counter wrapped around");
+
+  stats_lock();
+  stats_unregister_counter(SCS_FILE | SCS_DESTINATION, "test_stats", "wide", SC_TYPE_PROCESSED, &counter);
+  stats_unlock();
+
+  testcase_end();
+}
+
+int
+main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
+{
+  app_startup();
+  stats_set_max_threads(STATS_TEST_THREADS);
+
+  test_sharded_counter_is_aggregated_on_read();
+  test_counter_does_not_wrap_at_32_bits();
+
+  app_shutdown();
+  return 0;
+}
@@ -239,6 +239,39 @@ test_compat(void)
   configuration->user_version = old_version;
 }
 
+static void
+assert_stamp_format(LogMessage *msg, gint tz, const gchar *template, const gchar *expected)
+{
+  LogTemplate *templ = compile_template(template, FALSE);
+  GString *res = g_string_sized_new(128);
+
+  log_template_format(templ, msg, NULL, tz, 0, NULL, res);
+  assert_string(res->str, expected, "template test failed, template=%s", template);
+  log_template_unref(templ);
+  g_string_free(res, TRUE);
+}
+
+static void
+test_cached_timestamps(void)
+{
+  LogMessage *msg = create_sample_message();
+
+  /* same second, the cached timestamp has to have its fraction updated */
+  msg->timestamps[LM_TS_STAMP].tv_usec = 123000;
+  assert_stamp_format(msg, LTZ_LOCAL, "$ISODATE", "2006-02-11T10:34:56.123+01:00");
+  assert_stamp_format(msg, LTZ_LOCAL, "$DATE", "Feb 11 10:34:56.123");
+  msg->timestamps[LM_TS_STAMP].tv_usec = 456000;
+  assert_stamp_format(msg, LTZ_LOCAL, "$ISODATE", "2006-02-11T10:34:56.456+01:00");
+  assert_stamp_format(msg, LTZ_LOCAL, "$DATE", "Feb 11 10:34:56.456");
+  assert_stamp_format(msg, LTZ_LOCAL, "$UNIXTIME", "1139650496.456");
+
+  /* different zone offset for the same second */
+  assert_stamp_format(msg, LTZ_SEND, "$ISODATE", "2006-02-11T10:34:56.456+01:00");
+  msg->timestamps[LM_TS_STAMP].zone_offset = 0;
+  assert_stamp_format(msg, LTZ_SEND, "$ISODATE", "2006-02-11T09:34:56.456+00:00");
+  log_msg_unref(msg);
+}
+
 static void
 test_multi_thread(void)
 {
@@ -259,6 +292,26 @@ test_escaping(void)
                                        TRUE, "\\\"value\\\"");
 }
 
+static void
+test_size_hint(void)
+{
+  gsize size_hint = 0;
+  gint i;
+
+  log_template_update_size_hint(&size_hint, 100);
+  assert_guint32(size_hint, 100, "size hint should grow to the output size");
+
+  /* a single large output is forgotten over time */
+  log_template_update_size_hint(&size_hint, 10000);
+  assert_guint32(size_hint, 10000, "size hint should grow to the output size");
+  for (i = 0; i < 100; i++)
+    log_template_update_size_hint(&size_hint, 100);
+  assert_true(size_hint < 200, "size hint should decay towards the recent output size, size_hint=%d", (gint) size_hint);
+
+  log_template_update_size_hint(&size_hint, 10 * LOG_TEMPLATE_SIZE_HINT_MAX);
+  assert_guint32(size_hint, LOG_TEMPLATE_SIZE_HINT_MAX, "size hint should be capped");
+}
+
 int
 main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
 {
@@ -274,6 +327,7 @@ main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
   tzset();
 
   test_macros();
+  test_cached_timestamps();
   test_nvpairs();
   test_template_functions();
   test_message_refs();
@@ -281,6 +335,7 @@ main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
   test_compat();
   test_multi_thread();
   test_escaping();
+  test_size_hint();
 
   /* multi-threaded expansion */
 
@@ -6,6 +6,7 @@
 #include "cfg.h"
 #include "timeutils.h"
 #include "plugin.h"
+#include "scratch-buffers.h"
 
 #include <time.h>
 #include <stdlib.h>
@@ -21,18 +22,12 @@ MsgFormatOptions parse_options;
 
 #define BENCHMARK_COUNT 10000
 
-void
-testcase(const gchar *msg_str, gboolean syslog_proto, gchar *template)
+#define BENCHMARK_THREADS 4
+
+static LogMessage *
+create_message(const gchar *msg_str, gboolean syslog_proto)
 {
-  LogTemplate *templ;
   LogMessage *msg;
-  GString *res = g_string_sized_new(1024);
-  static TimeZoneInfo *tzinfo = NULL;
-  gint i;
-  GTimeVal start, end;
-
-  if (!tzinfo)
-    tzinfo = time_zone_info_new(NULL);
 
   if (syslog_proto)
     parse_options.flags |= LP_SYSLOG_PROTOCOL;
@@ -58,6 +53,23 @@ testcase(const gchar *msg_str, gboolean syslog_proto, gchar *template)
   msg->timestamps[LM_TS_RECVD].tv_sec = 1139684315;
   msg->timestamps[LM_TS_RECVD].tv_usec = 639000;
   msg->timestamps[LM_TS_RECVD].zone_offset = get_local_timezone_ofs(1139684315);
+  return msg;
+}
+
+void
+testcase(const gchar *msg_str, gboolean syslog_proto, gchar *template)
+{
+  LogTemplate *templ;
+  LogMessage *msg;
+  GString *res = g_string_sized_new(1024);
+  static TimeZoneInfo *tzinfo = NULL;
+  gint i;
+  GTimeVal start, end;
+
+  if (!tzinfo)
+    tzinfo = time_zone_info_new(NULL);
+
+  msg = create_message(msg_str, syslog_proto);
 
   templ = log_template_new(configuration, "dummy");
   log_template_compile(templ, template, NULL);
@@ -75,6 +87,74 @@ testcase(const gchar *msg_str, gboolean syslog_proto, gchar *template)
   log_msg_unref(msg);
 }
 
+typedef struct _ThreadedTestcase
+{
+  LogTemplate *templ;
+  LogMessage *msg;
+  GMutex *lock;
+  GCond *start;
+  gboolean started;
+} ThreadedTestcase;
+
+static gpointer
+threaded_testcase_format(gpointer user_data)
+{
+  ThreadedTestcase *tc = (ThreadedTestcase *) user_data;
+  GString *res = g_string_sized_new(1024);
+  gint i;
+
+  g_mutex_lock(tc->lock);
+  while (!tc->started)
+    g_cond_wait(tc->start, tc->lock);
+  g_mutex_unlock(tc->lock);
+
+  for (i = 0; i < BENCHMARK_COUNT; i++)
+    {
+      log_template_format(tc->templ, tc->msg, NULL, LTZ_LOCAL, 0, NULL, res);
+    }
+  g_string_free(res, TRUE);
+  scratch_buffers_free();
+  return NULL;
+}
+
+/* formats the same template from several threads at once, the aggregated
+ * speed should scale with the number of threads */
+void
+testcase_threaded(const gchar *msg_str, gboolean syslog_proto, gchar *template)
+{
+  ThreadedTestcase tc;
+  GThread *threads[BENCHMARK_THREADS];
+  gint i;
+  GTimeVal start, end;
+
+  tc.msg = create_message(msg_str, syslog_proto);
+  tc.templ = log_template_new(configuration, "dummy");
+  log_template_compile(tc.templ, template, NULL);
+  tc.lock = g_mutex_new();
+  tc.start = g_cond_new();
+  tc.started = FALSE;
+
+  for (i = 0; i < BENCHMARK_THREADS; i++)
+    threads[i] = g_thread_create(threaded_testcase_format, &tc, TRUE, NULL);
+
+  g_get_current_time(&start);
+  g_mutex_lock(tc.lock);
+  tc.started = TRUE;
+  g_cond_broadcast(tc.start);
+  g_mutex_unlock(tc.lock);
+
+  for (i = 0; i < BENCHMARK_THREADS; i++)
+    g_thread_join(threads[i]);
+  g_get_current_time(&end);
+  printf("  %2d threads %-79.*s speed: %12.3f msg/sec\n", BENCHMARK_THREADS, (int) strlen(template) - 1, template,
+         BENCHMARK_THREADS * BENCHMARK_COUNT * 1e6 / g_time_val_diff(&end, &start));
+
+  g_cond_free(tc.start);
+  g_mutex_free(tc.lock);
+  log_template_unref(tc.templ);
+  log_msg_unref(tc.msg);
+}
+
 int
 main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
 {
@@ -149,6 +229,18 @@ main(int argc G_GNUC_UNUSED, char *argv[] G_GNUC_UNUSED)
   testcase("<155>1 2006-02-11T10:34:56.156+01:00 bzorp syslog-ng 23323 ID47 [exampleSDID@0 iut=\"3\" eventSource=\"Application\" eventID=\"1011\"][examplePriority@0 class=\"high\"] " BOM "árvíztűrőtükörfúrógép", TRUE,
            "$DATE ${HOST:--} ${PROGRAM:--} ${PID:--} ${MSGID:--} ${SDATA:--} $MSG\n");
 
+  testcase("<155>2006-02-11T10:34:56.156+01:00 bzorp syslog-ng[23323]:árvíztűrőtükörfúrógép", FALSE,
+           "$(if ($FACILITY == \"local2\") $(echo $MSG) $(echo $HOST))\n");
+
+  testcase_threaded("<155>2006-02-11T10:34:56.156+01:00 bzorp syslog-ng[23323]:árvíztűrőtükörfúrógép", FALSE,
+                    "$DATE $HOST $MSGHDR$MSG\n");
+
+  testcase_threaded("<155>2006-02-11T10:34:56.156+01:00 bzorp syslog-ng[23323]:árvíztűrőtükörfúrógép", FALSE,
+                    "$(echo $MSG)\n");
+
+  testcase_threaded("<155>2006-02-11T10:34:56.156+01:00 bzorp syslog-ng[23323]:árvíztűrőtükörfúrógép", FALSE,
+                    "$(if ($FACILITY == \"local2\") $(echo $MSG) $(echo $HOST))\n");
+
   app_shutdown();
 
   if (success)